@@ -0,0 +1,302 @@
+#include "Benchmark.h"
+
+#include "Core/Exception.h"
+#include "Core/Utilities.h"
+
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	//heap allocations made through the replaced operator new below
+	std::atomic<unsigned long long> AllocationCount( 0 );
+	std::atomic<unsigned long long> AllocatedBytes( 0 );
+
+	long long Now()
+	{
+		return (long long)std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+	}
+
+	void* CountedAllocate( std::size_t size )
+	{
+		AllocationCount.fetch_add( 1, std::memory_order_relaxed );
+		AllocatedBytes.fetch_add( size, std::memory_order_relaxed );
+
+		void* memory = std::malloc( (size > 0) ? size : 1 );
+		if( memory == 0 )
+		{
+			throw std::bad_alloc();
+		}
+
+		return memory;
+	}
+}
+
+/*every heap allocation in the benchmark executable, the engine's included, goes through these*/
+void* operator new( std::size_t size ) { return CountedAllocate( size ); }
+void* operator new[]( std::size_t size ) { return CountedAllocate( size ); }
+void* operator new( std::size_t size, const std::nothrow_t& ) noexcept
+{
+	try { return CountedAllocate( size ); } catch( ... ) { return 0; }
+}
+void* operator new[]( std::size_t size, const std::nothrow_t& ) noexcept
+{
+	try { return CountedAllocate( size ); } catch( ... ) { return 0; }
+}
+void operator delete( void* memory ) noexcept { std::free( memory ); }
+void operator delete[]( void* memory ) noexcept { std::free( memory ); }
+void operator delete( void* memory, std::size_t ) noexcept { std::free( memory ); }
+void operator delete[]( void* memory, std::size_t ) noexcept { std::free( memory ); }
+void operator delete( void* memory, const std::nothrow_t& ) noexcept { std::free( memory ); }
+void operator delete[]( void* memory, const std::nothrow_t& ) noexcept { std::free( memory ); }
+
+namespace Kiwi
+{
+
+	BenchmarkState::BenchmarkState( unsigned int repetitions, double minTime )
+	{
+
+		m_repetitions = repetitions;
+		m_minTime = minTime;
+		m_itemsPerIteration = 1;
+		m_itemName = "call";
+		m_current = Sample{ 0, 0.0, 0, 0 };
+		m_startTime = 0;
+		m_startAllocations = 0;
+		m_startBytes = 0;
+		m_running = false;
+		m_paused = false;
+
+	}
+
+	void BenchmarkState::_Start()
+	{
+
+		m_startAllocations = AllocationCount.load( std::memory_order_relaxed );
+		m_startBytes = AllocatedBytes.load( std::memory_order_relaxed );
+		m_startTime = Now();
+
+	}
+
+	void BenchmarkState::_Stop()
+	{
+
+		long long stopTime = Now();
+
+		m_current.nanoseconds += (double)(stopTime - m_startTime);
+		m_current.allocations += AllocationCount.load( std::memory_order_relaxed ) - m_startAllocations;
+		m_current.allocatedBytes += AllocatedBytes.load( std::memory_order_relaxed ) - m_startBytes;
+
+	}
+
+	bool BenchmarkState::Run()
+	{
+
+		if( m_running )
+		{
+			//the previous iteration has finished
+			m_current.iterations++;
+
+			if( m_paused )
+			{
+				this->ResumeTiming();
+			}
+
+			//the clock is read once per iteration, benchmarks of very short operations batch them per iteration
+			if( m_current.nanoseconds + (double)(Now() - m_startTime) < m_minTime * 1000000000.0 )
+			{
+				return true;
+			}
+
+			this->_Stop();
+			m_samples.push_back( m_current );
+			m_running = false;
+		}
+
+		if( m_samples.size() >= m_repetitions )
+		{
+			return false;
+		}
+
+		//start the next repetition
+		m_current = Sample{ 0, 0.0, 0, 0 };
+		m_running = true;
+		this->_Start();
+
+		return true;
+
+	}
+
+	void BenchmarkState::PauseTiming()
+	{
+
+		if( m_running && !m_paused )
+		{
+			this->_Stop();
+			m_paused = true;
+		}
+
+	}
+
+	void BenchmarkState::ResumeTiming()
+	{
+
+		if( m_paused )
+		{
+			m_paused = false;
+			this->_Start();
+		}
+
+	}
+
+	BenchmarkRunner::BenchmarkRunner()
+	{
+
+		m_repetitions = 5;
+		m_minTime = 0.2;
+
+	}
+
+	void BenchmarkRunner::Register( std::string name, Kiwi::BenchmarkFunction function )
+	{
+
+		Benchmark benchmark;
+		benchmark.name = name;
+		benchmark.function = function;
+		m_benchmarks.push_back( benchmark );
+
+	}
+
+	std::vector<Kiwi::BenchmarkResult> BenchmarkRunner::Run( const std::string& filter )
+	{
+
+		std::vector<Kiwi::BenchmarkResult> results;
+
+		std::printf( "%-48s %12s %14s %24s %12s %12s  %s\n", "benchmark", "iterations", "ns/op", "min..max", "allocs/op", "bytes/op", "op" );
+
+		for( auto itr = m_benchmarks.begin(); itr != m_benchmarks.end(); itr++ )
+		{
+			if( itr->name.find( filter ) == std::string::npos ) continue;
+
+			Kiwi::BenchmarkResult result;
+			result.name = itr->name;
+			result.repetitions = 0;
+			result.iterations = 0;
+			result.nsPerOp = result.nsPerOpMin = result.nsPerOpMax = 0.0;
+			result.allocationsPerOp = result.bytesPerOp = 0.0;
+
+			try
+			{
+				Kiwi::BenchmarkState state( m_repetitions, m_minTime );
+				itr->function( state );
+
+				const std::vector<Kiwi::BenchmarkState::Sample>& samples = state.GetSamples();
+				if( samples.size() < m_repetitions )
+				{
+					throw Kiwi::Exception( L"BenchmarkRunner::Run", L"The benchmark returned before its loop finished" );
+				}
+
+				std::vector<double> nsPerOp;
+				double operations = 0.0;
+				double allocations = 0.0;
+				double bytes = 0.0;
+				for( auto sample = samples.begin(); sample != samples.end(); sample++ )
+				{
+					double sampleOperations = (double)sample->iterations * (double)state.GetItemsPerIteration();
+					nsPerOp.push_back( sample->nanoseconds / sampleOperations );
+
+					result.iterations += sample->iterations;
+					operations += sampleOperations;
+					allocations += (double)sample->allocations;
+					bytes += (double)sample->allocatedBytes;
+				}
+
+				std::sort( nsPerOp.begin(), nsPerOp.end() );
+
+				result.operation = state.GetItemName();
+				result.repetitions = (unsigned int)samples.size();
+				result.nsPerOp = nsPerOp[nsPerOp.size() / 2];
+				result.nsPerOpMin = nsPerOp.front();
+				result.nsPerOpMax = nsPerOp.back();
+				result.allocationsPerOp = allocations / operations;
+				result.bytesPerOp = bytes / operations;
+
+				char range[64];
+				std::snprintf( range, sizeof( range ), "%.2f..%.2f", result.nsPerOpMin, result.nsPerOpMax );
+				std::printf( "%-48s %12llu %14.2f %24s %12.3f %12.1f  %s\n", result.name.c_str(), result.iterations, result.nsPerOp, range, result.allocationsPerOp, result.bytesPerOp, result.operation.c_str() );
+
+			} catch( const Kiwi::Exception& e )
+			{
+				result.error = Kiwi::ws2s( e.GetSource() + L": " + e.GetError() );
+
+			} catch( const std::exception& e )
+			{
+				result.error = e.what();
+			}
+
+			if( result.error.size() > 0 )
+			{
+				std::printf( "%-48s failed: %s\n", result.name.c_str(), result.error.c_str() );
+			}
+
+			std::fflush( stdout );
+			results.push_back( result );
+		}
+
+		return results;
+
+	}
+
+	std::vector<std::string> BenchmarkRunner::GetNames()const
+	{
+
+		std::vector<std::string> names;
+		for( auto itr = m_benchmarks.begin(); itr != m_benchmarks.end(); itr++ )
+		{
+			names.push_back( itr->name );
+		}
+
+		return names;
+
+	}
+
+	bool BenchmarkRunner::WriteCSV( const std::string& file, const std::vector<Kiwi::BenchmarkResult>& results )
+	{
+
+		std::ofstream csv( file.c_str(), std::ios_base::out | std::ios_base::trunc );
+		if( !csv.good() )
+		{
+			return false;
+		}
+
+		csv << "benchmark,operation,repetitions,iterations,ns_per_op,ns_per_op_min,ns_per_op_max,allocs_per_op,bytes_per_op,error\n";
+		for( auto itr = results.begin(); itr != results.end(); itr++ )
+		{
+			csv << "\"" << itr->name << "\",\"" << itr->operation << "\"," << itr->repetitions << "," << itr->iterations << "," << itr->nsPerOp << "," << itr->nsPerOpMin << "," << itr->nsPerOpMax << ",";
+			csv << itr->allocationsPerOp << "," << itr->bytesPerOp << ",\"" << itr->error << "\"\n";
+		}
+
+		return csv.good();
+
+	}
+
+	unsigned long long BenchmarkRunner::GetAllocationCount()
+	{
+
+		return AllocationCount.load( std::memory_order_relaxed );
+
+	}
+
+	unsigned long long BenchmarkRunner::GetAllocatedBytes()
+	{
+
+		return AllocatedBytes.load( std::memory_order_relaxed );
+
+	}
+
+};
\ No newline at end of file
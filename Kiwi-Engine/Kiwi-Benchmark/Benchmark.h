@@ -0,0 +1,161 @@
+#ifndef _KIWI_BENCHMARK_H_
+#define _KIWI_BENCHMARK_H_
+
+#include <string>
+#include <vector>
+#include <functional>
+
+namespace Kiwi
+{
+
+	/*passed to every benchmark, runs its measured loop:
+
+		...setup...
+		while( state.Run() )
+		{
+			...one iteration...
+		}
+
+	the loop keeps running until every repetition has taken at least the minimum time. each repetition records the time
+	and the number of heap allocations made (on any thread) between its first and last iteration
+	setup before the loop is not measured, work inside an iteration can be excluded with PauseTiming/ResumeTiming*/
+	class BenchmarkState
+	{
+	friend class BenchmarkRunner;
+	public:
+
+		struct Sample
+		{
+			unsigned long long iterations;
+			double nanoseconds;
+			unsigned long long allocations;
+			unsigned long long allocatedBytes;
+		};
+
+	protected:
+
+		unsigned int m_repetitions;
+		double m_minTime;
+
+		unsigned long long m_itemsPerIteration;
+		std::string m_itemName;
+
+		std::vector<Sample> m_samples;
+		Sample m_current;
+
+		//steady clock time and allocation counters when the current measurement was started or resumed
+		long long m_startTime;
+		unsigned long long m_startAllocations;
+		unsigned long long m_startBytes;
+
+		bool m_running;
+		bool m_paused;
+
+	protected:
+
+		BenchmarkState( unsigned int repetitions, double minTime );
+
+		void _Start();
+
+		//adds the time and allocations since _Start to the current sample
+		void _Stop();
+
+	public:
+
+		/*starts or continues the measured loop, returns false once every repetition has finished*/
+		bool Run();
+
+		/*excludes the work between PauseTiming and ResumeTiming from the measurement*/
+		void PauseTiming();
+		void ResumeTiming();
+
+		/*sets the number of operations one iteration performs and what an operation is (e.g. "entity"),
+		the results are reported per operation. by default an operation is one iteration, named "call"*/
+		void SetItemsPerIteration( unsigned long long items, std::string itemName )
+		{
+			m_itemsPerIteration = (items > 0) ? items : 1;
+			m_itemName = itemName;
+		}
+
+		unsigned long long GetItemsPerIteration()const { return m_itemsPerIteration; }
+		const std::string& GetItemName()const { return m_itemName; }
+		const std::vector<Sample>& GetSamples()const { return m_samples; }
+
+	};
+
+	typedef std::function<void( Kiwi::BenchmarkState& )> BenchmarkFunction;
+
+	struct BenchmarkResult
+	{
+		std::string name;
+		std::string error; //empty if the benchmark ran
+		std::string operation; //what one op is
+		unsigned int repetitions;
+		unsigned long long iterations; //per repetition, summed over all repetitions
+		double nsPerOp; //median of the repetitions
+		double nsPerOpMin;
+		double nsPerOpMax;
+		double allocationsPerOp;
+		double bytesPerOp;
+	};
+
+	/*holds the registered benchmarks and runs them*/
+	class BenchmarkRunner
+	{
+	protected:
+
+		struct Benchmark
+		{
+			std::string name;
+			Kiwi::BenchmarkFunction function;
+		};
+
+		std::vector<Benchmark> m_benchmarks;
+
+		unsigned int m_repetitions;
+		double m_minTime;
+
+	public:
+
+		BenchmarkRunner();
+
+		void Register( std::string name, Kiwi::BenchmarkFunction function );
+
+		/*number of times each benchmark is measured, the median is reported*/
+		void SetRepetitions( unsigned int repetitions ) { m_repetitions = (repetitions > 0) ? repetitions : 1; }
+
+		/*shortest time, in seconds, each repetition runs for*/
+		void SetMinTime( double seconds ) { m_minTime = seconds; }
+
+		/*runs every benchmark whose name contains 'filter' and prints its result as soon as it finishes
+		benchmarks that throw are reported with the error and the rest still run*/
+		std::vector<Kiwi::BenchmarkResult> Run( const std::string& filter );
+
+		std::vector<std::string> GetNames()const;
+
+		/*writes the results as CSV, returns false if the file could not be written*/
+		static bool WriteCSV( const std::string& file, const std::vector<Kiwi::BenchmarkResult>& results );
+
+		/*returns the number of heap allocations made through operator new since the program started, on all threads*/
+		static unsigned long long GetAllocationCount();
+		static unsigned long long GetAllocatedBytes();
+
+	};
+
+	/*each benchmark file registers its benchmarks with one of these*/
+	void RegisterCoreBenchmarks( Kiwi::BenchmarkRunner& runner );
+	void RegisterPhysicsBenchmarks( Kiwi::BenchmarkRunner& runner );
+	void RegisterGraphicsBenchmarks( Kiwi::BenchmarkRunner& runner );
+	void RegisterUtilitiesBenchmarks( Kiwi::BenchmarkRunner& runner );
+
+	/*keeps the compiler from optimizing away a value (a number or a pointer) that a benchmark computes but never uses*/
+	template<typename T>
+	inline void DoNotOptimize( T value )
+	{
+		static volatile T sink;
+		sink = value;
+	}
+
+};
+
+#endif
\ No newline at end of file
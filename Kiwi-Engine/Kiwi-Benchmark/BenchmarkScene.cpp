@@ -0,0 +1,62 @@
+#include "BenchmarkScene.h"
+
+namespace Kiwi
+{
+
+	void BenchmarkScene::Populate( unsigned int count, unsigned int spinEvery, unsigned int meshEvery )
+	{
+
+		unsigned int seed = 1;
+		for( unsigned int i = 0; i < count; i++ )
+		{
+			Kiwi::Entity* entity = this->CreateEntity( L"Entity" + std::to_wstring( i ) );
+
+			Kiwi::Transform* transform = entity->FindComponent<Kiwi::Transform>();
+			transform->SetPosition( Kiwi::Vector3d( Kiwi::BenchmarkRandom( seed ) * 1000.0 - 500.0, Kiwi::BenchmarkRandom( seed ) * 1000.0 - 500.0, Kiwi::BenchmarkRandom( seed ) * 1000.0 ) );
+
+			if( spinEvery > 0 && i % spinEvery == 0 )
+			{
+				entity->AttachComponent( new Kiwi::SpinComponent( 0.5 + Kiwi::BenchmarkRandom( seed ) ) );
+			}
+
+			if( meshEvery > 0 && i % meshEvery == 0 )
+			{
+				Kiwi::Mesh* mesh = Kiwi::Mesh::Cube();
+				entity->AttachComponent( mesh );
+				mesh->BuildMesh();
+			}
+		}
+
+		//start from a resolved hierarchy and an empty change stream
+		m_transformStore.UpdateHierarchy();
+		m_transformStore.DispatchChanges();
+
+	}
+
+	void SpinComponent::_OnUpdate()
+	{
+
+		m_entity->FindComponent<Kiwi::Transform>()->Rotate( Kiwi::Vector3d::up(), m_speed * 0.016 );
+
+	}
+
+	void SpinComponent::_OnFixedUpdate()
+	{
+
+		m_entity->FindComponent<Kiwi::Transform>()->Rotate( Kiwi::Vector3d::forward(), m_speed * 0.016 );
+
+	}
+
+	double BenchmarkRandom( unsigned int& seed )
+	{
+
+		//xorshift32
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+
+		return (double)(seed & 0xFFFFFF) / (double)0x1000000;
+
+	}
+
+};
\ No newline at end of file
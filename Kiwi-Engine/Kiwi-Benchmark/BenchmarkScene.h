@@ -0,0 +1,61 @@
+#ifndef _KIWI_BENCHMARKSCENE_H_
+#define _KIWI_BENCHMARKSCENE_H_
+
+#include "Benchmark.h"
+
+#include "KiwiCore.h"
+#include "Core/Component.h"
+#include "Graphics/Mesh.h"
+
+#include <string>
+#include <functional>
+
+namespace Kiwi
+{
+
+	/*headless scene driven directly by a benchmark. 'onUpdate' is called at the end of every Scene::Update,
+	benchmarks that run whole engine frames use it to time each frame*/
+	class BenchmarkScene :
+		public Kiwi::Scene
+	{
+	protected:
+
+		void _OnUpdate() { if( onUpdate ) onUpdate(); }
+
+	public:
+
+		std::function<void()> onUpdate;
+
+		BenchmarkScene( Kiwi::EngineRoot& engine ) :
+			Kiwi::Scene( &engine, L"Benchmark", 0 ) {}
+
+		/*creates 'count' root entities spread over a cube, every 'spinEvery'th entity (0 for none) gets a
+		SpinComponent and every 'meshEvery'th entity a cube mesh*/
+		void Populate( unsigned int count, unsigned int spinEvery, unsigned int meshEvery );
+
+	};
+
+	/*rotates its entity a little every update and fixed update, stands in for per-entity gameplay work*/
+	class SpinComponent :
+		public Kiwi::Component
+	{
+	protected:
+
+		double m_speed;
+
+		void _OnUpdate();
+		void _OnFixedUpdate();
+
+	public:
+
+		SpinComponent( double speed ) :
+			m_speed( speed ) {}
+
+	};
+
+	/*returns a deterministic pseudo random number in [0, 1), benchmarks must not depend on rand() state*/
+	double BenchmarkRandom( unsigned int& seed );
+
+};
+
+#endif
\ No newline at end of file
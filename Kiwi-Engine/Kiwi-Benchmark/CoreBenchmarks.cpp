@@ -0,0 +1,562 @@
+#include "Benchmark.h"
+#include "BenchmarkScene.h"
+
+#include "Core/EntityManager.h"
+#include "Core/TransformStore.h"
+#include "Core/FrameGraph.h"
+#include "Core/Logger.h"
+#include "Core/Console.h"
+#include "Graphics/RenderThread.h"
+#include "Graphics/NullRenderBackend.h"
+#include "Core/EventBroadcaster.h"
+#include "Core/Events/IGlobalEventBroadcaster.h"
+#include "Core/Events/IGlobalEventListener.h"
+
+#include <vector>
+#include <string>
+
+namespace Kiwi
+{
+
+	namespace
+	{
+
+		/*one of several distinct component types for the component lookup benchmarks*/
+		template<int N>
+		class LookupComponent :
+			public Kiwi::Component
+		{
+		};
+
+		/*exposes the linear dynamic_cast scan FindComponent used before components got type slots*/
+		class ScanEntity :
+			public Kiwi::Entity
+		{
+		public:
+
+			ScanEntity( Kiwi::Scene& scene ) :
+				Kiwi::Entity( L"ScanEntity", scene ) {}
+
+			template<class ComponentClass>
+			ComponentClass* ScanComponent() { return this->_FindComponent<ComponentClass>(); }
+
+		};
+
+		/*creates and destroys batches of 1000 entities. if 'liveCount' is above zero, that many entities stay alive
+		in a query and a tag list the batch is also added to, so destroying the batch has to remove it from those lists*/
+		void EntityCreateDestroy( Kiwi::BenchmarkState& state, unsigned int liveCount )
+		{
+
+			Kiwi::EngineRoot engine;
+			Kiwi::BenchmarkScene scene( engine );
+			Kiwi::EntityManager* entityManager = scene.GetEntityManager();
+
+			const unsigned int batchSize = 1000;
+
+			if( liveCount > 0 )
+			{
+				//create the query first so its list is kept up to date from here on
+				entityManager->Query<LookupComponent<0>>();
+				for( unsigned int i = 0; i < liveCount; i++ )
+				{
+					Kiwi::Entity* entity = scene.CreateEntity( L"Live" + std::to_wstring( i ) );
+					entity->AttachComponent( new LookupComponent<0>() );
+					entity->AddTag( std::wstring( L"Indexed" ) );
+				}
+			}
+
+			std::vector<std::wstring> names;
+			for( unsigned int i = 0; i < batchSize; i++ )
+			{
+				names.push_back( L"Entity" + std::to_wstring( i ) );
+			}
+
+			std::vector<Kiwi::Entity*> entities( batchSize );
+
+			state.SetItemsPerIteration( batchSize, "entity" );
+			while( state.Run() )
+			{
+				for( unsigned int i = 0; i < batchSize; i++ )
+				{
+					entities[i] = scene.CreateEntity( names[i] );
+					if( liveCount > 0 )
+					{
+						entities[i]->AttachComponent( new LookupComponent<0>() );
+						entities[i]->AddTag( std::wstring( L"Indexed" ) );
+					}
+				}
+
+				for( unsigned int i = 0; i < batchSize; i++ )
+				{
+					entities[i]->Shutdown();
+				}
+
+				entityManager->DestroyPending();
+			}
+
+		}
+
+		/*times EntityManager::Update over 'count' spinning root entities, updating on 'threads' threads (0 for serial)
+		the hierarchy update and change dispatch that follow it in Scene::Update are not timed*/
+		void EntityManagerUpdate( Kiwi::BenchmarkState& state, unsigned int count, unsigned int threads )
+		{
+
+			Kiwi::EngineRoot engine;
+			Kiwi::BenchmarkScene scene( engine );
+			scene.Populate( count, 1, 0 );
+
+			Kiwi::EntityManager* entityManager = scene.GetEntityManager();
+			entityManager->SetParallelUpdate( threads );
+
+			Kiwi::TransformStore& store = scene.GetTransformStore();
+
+			state.SetItemsPerIteration( count, "entity" );
+			while( state.Run() )
+			{
+				entityManager->Update();
+
+				state.PauseTiming();
+				store.UpdateHierarchy();
+				store.DispatchChanges();
+				state.ResumeTiming();
+			}
+
+		}
+
+		/*translates every transform through its Transform handle, then propagates the changes*/
+		void TransformTranslate( Kiwi::BenchmarkState& state, unsigned int count )
+		{
+
+			Kiwi::EngineRoot engine;
+			Kiwi::BenchmarkScene scene( engine );
+			scene.Populate( count, 0, 0 );
+
+			Kiwi::TransformStore& store = scene.GetTransformStore();
+
+			std::vector<Kiwi::Transform*> transforms;
+			const Kiwi::EntityList* entities = scene.GetEntityManager()->GetEntities();
+			for( auto itr = entities->begin(); itr != entities->end(); itr++ )
+			{
+				transforms.push_back( (*itr)->FindComponent<Kiwi::Transform>() );
+			}
+
+			Kiwi::Vector3d step( 0.01, 0.0, -0.01 );
+
+			state.SetItemsPerIteration( count, "transform" );
+			while( state.Run() )
+			{
+				for( auto itr = transforms.begin(); itr != transforms.end(); itr++ )
+				{
+					(*itr)->Translate( step );
+				}
+
+				store.UpdateHierarchy();
+				store.DispatchChanges();
+			}
+
+		}
+
+		/*streams over the store's dense position array, the access pattern systems get from the SoA layout*/
+		void TransformStorePositions( Kiwi::BenchmarkState& state, unsigned int count )
+		{
+
+			Kiwi::EngineRoot engine;
+			Kiwi::BenchmarkScene scene( engine );
+			scene.Populate( count, 0, 0 );
+
+			Kiwi::TransformStore& store = scene.GetTransformStore();
+			Kiwi::Vector3d step( 0.01, 0.0, -0.01 );
+
+			state.SetItemsPerIteration( store.GetCount(), "transform" );
+			while( state.Run() )
+			{
+				Kiwi::Vector3d* positions = store.GetPositions();
+				for( unsigned int i = 0; i < store.GetCount(); i++ )
+				{
+					positions[i] += step;
+				}
+
+				Kiwi::DoNotOptimize( positions[0].x );
+			}
+
+		}
+
+		/*'roots' trees of 1 + 9 + 90 transforms, every root is moved and rotated each iteration so the whole hierarchy
+		is recomputed*/
+		void TransformHierarchy( Kiwi::BenchmarkState& state, unsigned int roots )
+		{
+
+			Kiwi::EngineRoot engine;
+			Kiwi::BenchmarkScene scene( engine );
+			Kiwi::TransformStore& store = scene.GetTransformStore();
+
+			std::vector<Kiwi::Transform*> rootTransforms;
+			std::vector<std::pair<Kiwi::Entity*, Kiwi::Entity*>> links;
+			unsigned int entityIndex = 0;
+			for( unsigned int r = 0; r < roots; r++ )
+			{
+				Kiwi::Entity* root = scene.CreateEntity( L"Root" + std::to_wstring( r ) );
+				root->FindComponent<Kiwi::Transform>()->SetPosition( Kiwi::Vector3d( (double)r, 0.0, 0.0 ) );
+				rootTransforms.push_back( root->FindComponent<Kiwi::Transform>() );
+
+				for( unsigned int c = 0; c < 9; c++ )
+				{
+					Kiwi::Entity* child = scene.CreateEntity( L"Child" + std::to_wstring( entityIndex++ ) );
+					child->FindComponent<Kiwi::Transform>()->SetPosition( Kiwi::Vector3d( 0.0, (double)c, 0.0 ) );
+					root->AttachChild( child );
+					links.push_back( std::make_pair( root, child ) );
+
+					for( unsigned int g = 0; g < 10; g++ )
+					{
+						Kiwi::Entity* grandchild = scene.CreateEntity( L"Child" + std::to_wstring( entityIndex++ ) );
+						grandchild->FindComponent<Kiwi::Transform>()->SetPosition( Kiwi::Vector3d( 0.0, 0.0, (double)g ) );
+						child->AttachChild( grandchild );
+						links.push_back( std::make_pair( child, grandchild ) );
+					}
+				}
+			}
+
+			store.UpdateHierarchy();
+			store.DispatchChanges();
+
+			Kiwi::Vector3d step( 0.01, 0.0, 0.0 );
+
+			state.SetItemsPerIteration( store.GetCount(), "transform" );
+			while( state.Run() )
+			{
+				for( auto itr = rootTransforms.begin(); itr != rootTransforms.end(); itr++ )
+				{
+					(*itr)->Translate( step );
+					(*itr)->Rotate( Kiwi::Vector3d::up(), 0.01 );
+				}
+
+				store.UpdateHierarchy();
+				store.DispatchChanges();
+			}
+
+			//parents hold a reference to their children, release them before the scene deletes its entities
+			for( auto itr = links.rbegin(); itr != links.rend(); itr++ )
+			{
+				itr->first->DetachChild( itr->second );
+			}
+
+		}
+
+		/*looks up each of 8 component types on an entity that has all of them, 'scan' uses the old dynamic_cast scan*/
+		void ComponentLookup( Kiwi::BenchmarkState& state, bool scan )
+		{
+
+			Kiwi::EngineRoot engine;
+			Kiwi::BenchmarkScene scene( engine );
+
+			ScanEntity* entity = new ScanEntity( scene );
+			scene.AddEntity( entity );
+			entity->AttachComponent( new LookupComponent<0>() );
+			entity->AttachComponent( new LookupComponent<1>() );
+			entity->AttachComponent( new LookupComponent<2>() );
+			entity->AttachComponent( new LookupComponent<3>() );
+			entity->AttachComponent( new LookupComponent<4>() );
+			entity->AttachComponent( new LookupComponent<5>() );
+			entity->AttachComponent( new LookupComponent<6>() );
+			entity->AttachComponent( new LookupComponent<7>() );
+
+			const unsigned int batchSize = 1000;
+
+			state.SetItemsPerIteration( batchSize * 8, "lookup" );
+			while( state.Run() )
+			{
+				for( unsigned int i = 0; i < batchSize; i++ )
+				{
+					if( scan )
+					{
+						Kiwi::DoNotOptimize( entity->ScanComponent<LookupComponent<0>>() );
+						Kiwi::DoNotOptimize( entity->ScanComponent<LookupComponent<1>>() );
+						Kiwi::DoNotOptimize( entity->ScanComponent<LookupComponent<2>>() );
+						Kiwi::DoNotOptimize( entity->ScanComponent<LookupComponent<3>>() );
+						Kiwi::DoNotOptimize( entity->ScanComponent<LookupComponent<4>>() );
+						Kiwi::DoNotOptimize( entity->ScanComponent<LookupComponent<5>>() );
+						Kiwi::DoNotOptimize( entity->ScanComponent<LookupComponent<6>>() );
+						Kiwi::DoNotOptimize( entity->ScanComponent<LookupComponent<7>>() );
+
+					} else
+					{
+						Kiwi::DoNotOptimize( entity->FindComponent<LookupComponent<0>>() );
+						Kiwi::DoNotOptimize( entity->FindComponent<LookupComponent<1>>() );
+						Kiwi::DoNotOptimize( entity->FindComponent<LookupComponent<2>>() );
+						Kiwi::DoNotOptimize( entity->FindComponent<LookupComponent<3>>() );
+						Kiwi::DoNotOptimize( entity->FindComponent<LookupComponent<4>>() );
+						Kiwi::DoNotOptimize( entity->FindComponent<LookupComponent<5>>() );
+						Kiwi::DoNotOptimize( entity->FindComponent<LookupComponent<6>>() );
+						Kiwi::DoNotOptimize( entity->FindComponent<LookupComponent<7>>() );
+					}
+				}
+			}
+
+		}
+
+		struct CounterEvent
+		{
+			unsigned int value;
+		};
+
+		class CounterListener
+		{
+		public:
+
+			unsigned int total = 0;
+
+			void OnEvent( const CounterEvent& evt ) { total += evt.value; }
+
+		};
+
+		/*broadcasts batches of events to 16 listeners, 'deferred' queues them and dispatches the queue after each batch*/
+		void EventBroadcast( Kiwi::BenchmarkState& state, bool deferred )
+		{
+
+			Kiwi::EventBroadcaster<CounterListener, CounterEvent> broadcaster( &CounterListener::OnEvent );
+			broadcaster.SetDeferred( deferred, Kiwi::EVENT_PHASE_UPDATE );
+
+			std::vector<CounterListener> listeners( 16 );
+			for( auto itr = listeners.begin(); itr != listeners.end(); itr++ )
+			{
+				broadcaster.AddListener( &(*itr) );
+			}
+
+			const unsigned int batchSize = 1000;
+
+			state.SetItemsPerIteration( batchSize, "event" );
+			while( state.Run() )
+			{
+				for( unsigned int i = 0; i < batchSize; i++ )
+				{
+					broadcaster.BroadcastEvent( CounterEvent{ i } );
+				}
+
+				if( deferred )
+				{
+					Kiwi::EventQueues::Dispatch( Kiwi::EVENT_PHASE_UPDATE );
+				}
+			}
+
+			Kiwi::DoNotOptimize( listeners[0].total );
+
+		}
+
+		class CounterGlobalEvent :
+			public Kiwi::IGlobalEvent
+		{
+		public:
+
+			unsigned int value;
+
+			CounterGlobalEvent( unsigned int v ) :
+				Kiwi::IGlobalEvent( 1 ), value( v ) {}
+
+		};
+
+		class CounterGlobalListener :
+			public Kiwi::IGlobalEventListener
+		{
+		public:
+
+			unsigned int total = 0;
+
+			void _ProcessGlobalEvent( const Kiwi::IGlobalEvent& e ) { total += static_cast<const CounterGlobalEvent&>( e ).value; }
+
+		};
+
+		/*posts batches of global events and dispatches them to 16 listeners*/
+		void GlobalEventDispatch( Kiwi::BenchmarkState& state )
+		{
+
+			Kiwi::IGlobalEventBroadcaster broadcaster;
+
+			std::vector<CounterGlobalListener> listeners( 16 );
+			for( auto itr = listeners.begin(); itr != listeners.end(); itr++ )
+			{
+				itr->SetRegisteredEventIDs( { 1 } );
+				broadcaster.AddGlobalEventListener( &(*itr) );
+			}
+
+			const unsigned int batchSize = 1000;
+
+			state.SetItemsPerIteration( batchSize, "event" );
+			while( state.Run() )
+			{
+				for( unsigned int i = 0; i < batchSize; i++ )
+				{
+					broadcaster.PostGlobalEvent<CounterGlobalEvent>( i );
+				}
+
+				broadcaster.DispatchGlobalEvents();
+			}
+
+			Kiwi::DoNotOptimize( listeners[0].total );
+
+		}
+
+		/*logs batches of short formatted messages, the output thread writes them to Kiwi-Benchmark-Logger.log
+		'deferred' logs with KIWI_LOG, which leaves formatting to the output thread or, in binary mode, to the decoder*/
+		void LoggerLog( Kiwi::BenchmarkState& state, bool deferred, bool binary )
+		{
+
+			Kiwi::Logger logger;
+			logger.SetBinary( binary );
+			logger.Initialize( binary ? L"Kiwi-Benchmark-Logger.kwlog" : L"Kiwi-Benchmark-Logger.log" );
+
+			std::wstring group = L"opaque";
+
+			const unsigned int batchSize = 1000;
+
+			state.SetItemsPerIteration( batchSize, "message" );
+			while( state.Run() )
+			{
+				for( unsigned int i = 0; i < batchSize; i++ )
+				{
+					if( deferred )
+					{
+						KIWI_LOG( logger, L"Attempted to render null mesh {} in render group {}", i, group );
+
+					} else
+					{
+						logger.Log( L"Attempted to render null mesh " + std::to_wstring( i ) + L" in render group " + group );
+					}
+				}
+			}
+
+			logger.Shutdown();
+
+		}
+
+		/*prints batches of messages to the console, the history is full before the measurement starts
+		so every message replaces the oldest one*/
+		void ConsolePrint( Kiwi::BenchmarkState& state )
+		{
+
+			Kiwi::EngineRoot engine;
+			engine.Initialize( L"Kiwi-Benchmark-Console.log" );
+
+			Kiwi::Console* console = engine.GetConsole();
+			for( unsigned int i = 0; i < console->GetHistorySize(); i++ )
+			{
+				console->Print( L"Loaded asset " + std::to_wstring( i ) );
+			}
+
+			const unsigned int batchSize = 1000;
+
+			state.SetItemsPerIteration( batchSize, "message" );
+			while( state.Run() )
+			{
+				for( unsigned int i = 0; i < batchSize; i++ )
+				{
+					console->Print( L"Attempted to render null mesh " + std::to_wstring( i ) );
+				}
+			}
+
+			Kiwi::DoNotOptimize( console->m_messages.Back().message.size() );
+
+		}
+
+		/*runs whole engine frames (fixed updates, entity update, render queue generation and a headless submit) over
+		10k spinning entities, 1k of them with meshes. 'serial' runs the frame graph's tasks one after another
+		on the main thread instead of on the job system. 'renderThread' captures each frame into a render snapshot
+		that a NullRenderBackend walks on the render thread while the next frame is simulated*/
+		void EngineFrame( Kiwi::BenchmarkState& state, bool serial, bool renderThread )
+		{
+
+			//outlives the engine, the scene stops its render thread when it is shut down
+			Kiwi::NullRenderBackend backend;
+
+			Kiwi::EngineRoot engine;
+			engine.Initialize( L"Kiwi-Benchmark.log" );
+			engine.GetFrameGraph()->SetSerial( serial );
+
+			Kiwi::BenchmarkScene* scene = new Kiwi::BenchmarkScene( engine );
+			engine.GetSceneManager()->AddScene( scene );
+			scene->CreateCamera( L"Camera" );
+			scene->Populate( 10000, 1, 10 );
+			scene->SetActive( true );
+
+			if( renderThread )
+			{
+				scene->SetRenderThreadEnabled( true, &backend );
+			}
+
+			unsigned long long submitted = 0;
+
+			//each scene update ends one frame's iteration, the engine stops once the measurement is done
+			scene->onUpdate = [&state, &engine, &submitted, scene]()
+			{
+				if( !state.Run() )
+				{
+					if( scene->IsRenderThreadEnabled() )
+					{
+						//the scene stops its render thread on shutdown, count the frames while it is still there
+						scene->WaitForRender();
+						submitted = scene->GetRenderThread()->GetFramesSubmitted();
+						scene->SetRenderThreadEnabled( false );
+					}
+					engine.Stop();
+				}
+			};
+
+			state.SetItemsPerIteration( 1, "frame" );
+			engine.Start();
+
+			if( renderThread )
+			{
+				//every submitted frame must have reached the backend, with every mesh in it
+				if( submitted == 0 || backend.GetFramesRendered() != submitted )
+				{
+					throw Kiwi::Exception( L"EngineFrame", L"The render thread drew " + std::to_wstring( backend.GetFramesRendered() ) + L" of " + std::to_wstring( submitted ) + L" frames" );
+				}
+				if( backend.GetLastDrawCount() != 1000 )
+				{
+					throw Kiwi::Exception( L"EngineFrame", L"The last frame drew " + std::to_wstring( backend.GetLastDrawCount() ) + L" of 1000 meshes" );
+				}
+			}
+
+		}
+
+	}
+
+	void RegisterCoreBenchmarks( Kiwi::BenchmarkRunner& runner )
+	{
+
+		runner.Register( "Entity/CreateDestroy", []( Kiwi::BenchmarkState& state ) { EntityCreateDestroy( state, 0 ); } );
+		runner.Register( "Entity/CreateDestroy/indexed 10k", []( Kiwi::BenchmarkState& state ) { EntityCreateDestroy( state, 10000 ); } );
+
+		runner.Register( "EntityManager::Update/10k", []( Kiwi::BenchmarkState& state ) { EntityManagerUpdate( state, 10000, 0 ); } );
+		runner.Register( "EntityManager::Update/100k", []( Kiwi::BenchmarkState& state ) { EntityManagerUpdate( state, 100000, 0 ); } );
+
+		//parallel update scaling, at most the job system's worker count + 1 threads actually run at once
+		runner.Register( "EntityManager::Update/100k/threads:1", []( Kiwi::BenchmarkState& state ) { EntityManagerUpdate( state, 100000, 1 ); } );
+		runner.Register( "EntityManager::Update/100k/threads:2", []( Kiwi::BenchmarkState& state ) { EntityManagerUpdate( state, 100000, 2 ); } );
+		runner.Register( "EntityManager::Update/100k/threads:4", []( Kiwi::BenchmarkState& state ) { EntityManagerUpdate( state, 100000, 4 ); } );
+		runner.Register( "EntityManager::Update/100k/threads:8", []( Kiwi::BenchmarkState& state ) { EntityManagerUpdate( state, 100000, 8 ); } );
+
+		runner.Register( "Transform::Translate/100k", []( Kiwi::BenchmarkState& state ) { TransformTranslate( state, 100000 ); } );
+		runner.Register( "TransformStore/StreamPositions/100k", []( Kiwi::BenchmarkState& state ) { TransformStorePositions( state, 100000 ); } );
+		runner.Register( "TransformStore::UpdateHierarchy/100k", []( Kiwi::BenchmarkState& state ) { TransformHierarchy( state, 1000 ); } );
+
+		runner.Register( "Entity::FindComponent/typed", []( Kiwi::BenchmarkState& state ) { ComponentLookup( state, false ); } );
+		runner.Register( "Entity::FindComponent/dynamic_cast scan", []( Kiwi::BenchmarkState& state ) { ComponentLookup( state, true ); } );
+
+		runner.Register( "EventBroadcaster::BroadcastEvent/16 listeners", []( Kiwi::BenchmarkState& state ) { EventBroadcast( state, false ); } );
+		runner.Register( "EventBroadcaster::BroadcastEvent/16 listeners/deferred", []( Kiwi::BenchmarkState& state ) { EventBroadcast( state, true ); } );
+
+		runner.Register( "IGlobalEventBroadcaster/PostGlobalEvent+Dispatch/16 listeners", GlobalEventDispatch );
+
+		runner.Register( "Logger::Log", []( Kiwi::BenchmarkState& state ) { LoggerLog( state, false, false ); } );
+		runner.Register( "Logger::Log/KIWI_LOG", []( Kiwi::BenchmarkState& state ) { LoggerLog( state, true, false ); } );
+		runner.Register( "Logger::Log/KIWI_LOG/binary", []( Kiwi::BenchmarkState& state ) { LoggerLog( state, true, true ); } );
+
+		runner.Register( "Console::Print/full history", ConsolePrint );
+
+		runner.Register( "EngineRoot/Frame/serial", []( Kiwi::BenchmarkState& state ) { EngineFrame( state, true, false ); } );
+		runner.Register( "EngineRoot/Frame/graph", []( Kiwi::BenchmarkState& state ) { EngineFrame( state, false, false ); } );
+		runner.Register( "EngineRoot/Frame/render thread", []( Kiwi::BenchmarkState& state ) { EngineFrame( state, false, true ); } );
+
+	}
+
+};
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include "Benchmark.h"
+#include "BenchmarkScene.h"
+
+#include "Graphics/Mesh.h"
+#include "Graphics/Material.h"
+#include "Graphics/Camera.h"
+#include "Graphics/Viewport.h"
+#include "Graphics/RenderQueue.h"
+#include "Graphics/RenderQueueGroup.h"
+#include "Graphics/OBJImporter.h"
+
+#include <fstream>
+#include <cstdio>
+
+namespace Kiwi
+{
+
+	namespace
+	{
+
+		/*casts rays at a flat grid of size x size quads (2 triangles each) facing the rays*/
+		void MeshIntersectRay( Kiwi::BenchmarkState& state, unsigned int size )
+		{
+
+			Kiwi::EngineRoot engine;
+			Kiwi::BenchmarkScene scene( engine );
+
+			std::vector<Kiwi::Vector3d> vertices;
+			std::vector<Kiwi::Vector2d> uvs;
+			std::vector<Kiwi::Vector3d> normals;
+			for( unsigned int y = 0; y < size; y++ )
+			{
+				for( unsigned int x = 0; x < size; x++ )
+				{
+					//wound to face rays travelling along +z
+					Kiwi::Vector3d quad[6] = {
+						Kiwi::Vector3d( x, y, 0.0 ), Kiwi::Vector3d( x, y + 1, 0.0 ), Kiwi::Vector3d( x + 1, y, 0.0 ),
+						Kiwi::Vector3d( x + 1, y, 0.0 ), Kiwi::Vector3d( x, y + 1, 0.0 ), Kiwi::Vector3d( x + 1, y + 1, 0.0 )
+					};
+
+					for( unsigned int i = 0; i < 6; i++ )
+					{
+						vertices.push_back( quad[i] );
+						uvs.push_back( Kiwi::Vector2d( quad[i].x / size, quad[i].y / size ) );
+						normals.push_back( Kiwi::Vector3d( 0.0, 0.0, -1.0 ) );
+					}
+				}
+			}
+
+			Kiwi::Entity* entity = scene.CreateEntity( L"Grid" );
+			entity->FindComponent<Kiwi::Transform>()->SetPosition( Kiwi::Vector3d( 0.0, 0.0, 10.0 ) );
+
+			Kiwi::Mesh* mesh = new Kiwi::Mesh( vertices, uvs, normals );
+			entity->AttachComponent( mesh );
+			mesh->BuildMesh();
+
+			std::vector<Kiwi::Mesh::Triangle> hits;
+			unsigned int seed = 3;
+
+			state.SetItemsPerIteration( 1, "ray" );
+			while( state.Run() )
+			{
+				Kiwi::Vector3d origin( Kiwi::BenchmarkRandom( seed ) * size, Kiwi::BenchmarkRandom( seed ) * size, 0.0 );
+
+				hits.clear();
+				Kiwi::DoNotOptimize( mesh->IntersectRay( origin, Kiwi::Vector3d::forward(), 100.0, hits ) );
+			}
+
+		}
+
+		/*imports an OBJ grid of size x size quads with positions, texture coordinates and normals*/
+		void OBJImport( Kiwi::BenchmarkState& state, unsigned int size )
+		{
+
+			std::string file = "Kiwi-Benchmark-grid.obj";
+			{
+				std::ofstream obj( file.c_str(), std::ios_base::out | std::ios_base::trunc );
+				if( !obj.good() )
+				{
+					throw Kiwi::Exception( L"OBJImport", L"Failed to write the OBJ file" );
+				}
+
+				obj << "# " << size << "x" << size << " grid\n";
+				obj << "g Grid\n";
+				for( unsigned int y = 0; y <= size; y++ )
+				{
+					for( unsigned int x = 0; x <= size; x++ )
+					{
+						obj << "v " << x << " 0 " << y << "\n";
+						obj << "vt " << (double)x / size << " " << (double)y / size << "\n";
+						obj << "vn 0 1 0\n";
+					}
+				}
+
+				for( unsigned int y = 0; y < size; y++ )
+				{
+					for( unsigned int x = 0; x < size; x++ )
+					{
+						unsigned int v0 = y * (size + 1) + x + 1;
+						unsigned int v1 = v0 + 1;
+						unsigned int v2 = v0 + size + 1;
+						unsigned int v3 = v2 + 1;
+						obj << "f " << v0 << "/" << v0 << "/" << v0 << " " << v2 << "/" << v2 << "/" << v2 << " " << v3 << "/" << v3 << "/" << v3 << " " << v1 << "/" << v1 << "/" << v1 << "\n";
+					}
+				}
+			}
+
+			Kiwi::OBJImporter importer;
+
+			state.SetItemsPerIteration( 1, "file" );
+			while( state.Run() )
+			{
+				Kiwi::OBJMeshData* mesh = importer.Import( Kiwi::s2ws( file ) );
+				if( mesh == 0 )
+				{
+					std::remove( file.c_str() );
+					throw Kiwi::Exception( L"OBJImport", L"The OBJ file could not be imported" );
+				}
+
+				delete mesh;
+			}
+
+			std::remove( file.c_str() );
+
+		}
+
+		/*scene of 'count' cube meshes, one in four transparent, seen by one camera*/
+		struct RenderQueueScene
+		{
+			Kiwi::EngineRoot engine;
+			Kiwi::BenchmarkScene scene;
+			Kiwi::Camera* camera;
+			Kiwi::Viewport viewport;
+			Kiwi::RenderQueue queue;
+
+			RenderQueueScene( unsigned int count ) :
+				scene( engine ),
+				camera( scene.CreateCamera( L"Camera" ) ),
+				viewport( L"Viewport", camera, Kiwi::Vector2( 0.0f, 0.0f ), Kiwi::Vector2( 1920.0f, 1080.0f ), 0.0f, 1.0f ),
+				queue( scene )
+			{
+				scene.Populate( count, 0, 1 );
+
+				unsigned int index = 0;
+				const Kiwi::EntityList* entities = scene.GetEntityManager()->GetEntities();
+				for( auto itr = entities->begin(); itr != entities->end(); itr++ )
+				{
+					Kiwi::Mesh* mesh = (*itr)->FindComponent<Kiwi::Mesh>();
+					if( mesh != 0 && index++ % 4 == 0 )
+					{
+						mesh->CreateSubmesh( Kiwi::Material( Kiwi::Color( 1.0, 1.0, 1.0, 0.5 ) ), 0, 35 );
+					}
+				}
+			}
+
+			void Generate()
+			{
+				queue.Clear();
+				queue.Generate( scene.GetEntityManager()->GetEntities() );
+			}
+
+			void Sort()
+			{
+				for( auto itr = queue.GetRenderGroups().begin(); itr != queue.GetRenderGroups().end(); itr++ )
+				{
+					itr->second->Sort( viewport );
+				}
+			}
+		};
+
+		void RenderQueueGenerate( Kiwi::BenchmarkState& state, unsigned int count )
+		{
+
+			RenderQueueScene fixture( count );
+
+			state.SetItemsPerIteration( count, "mesh" );
+			while( state.Run() )
+			{
+				fixture.Generate();
+			}
+
+		}
+
+		/*sorts a freshly generated queue every iteration so the sort never starts from sorted input*/
+		void RenderQueueSort( Kiwi::BenchmarkState& state, unsigned int count )
+		{
+
+			RenderQueueScene fixture( count );
+
+			state.SetItemsPerIteration( count, "mesh" );
+			while( state.Run() )
+			{
+				state.PauseTiming();
+				fixture.Generate();
+				state.ResumeTiming();
+
+				fixture.Sort();
+			}
+
+		}
+
+	}
+
+	void RegisterGraphicsBenchmarks( Kiwi::BenchmarkRunner& runner )
+	{
+
+		runner.Register( "Mesh::IntersectRay/32k triangles", []( Kiwi::BenchmarkState& state ) { MeshIntersectRay( state, 128 ); } );
+		runner.Register( "OBJImporter::Import/128k triangles", []( Kiwi::BenchmarkState& state ) { OBJImport( state, 256 ); } );
+		runner.Register( "RenderQueue::Generate/10k meshes", []( Kiwi::BenchmarkState& state ) { RenderQueueGenerate( state, 10000 ); } );
+		runner.Register( "RenderQueueGroup::Sort/10k meshes", []( Kiwi::BenchmarkState& state ) { RenderQueueSort( state, 10000 ); } );
+
+	}
+
+};
\ No newline at end of file
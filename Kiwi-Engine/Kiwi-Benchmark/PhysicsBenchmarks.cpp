@@ -0,0 +1,57 @@
+#include "Benchmark.h"
+#include "BenchmarkScene.h"
+
+#include "Physics/PhysicsSystem.h"
+#include "Physics/Rigidbody.h"
+#include "Physics/SphereCollider.h"
+
+#include <cmath>
+
+namespace Kiwi
+{
+
+	namespace
+	{
+
+		/*one physics step over 'count' unit spheres at rest, spread so that each one overlaps a few others*/
+		void PhysicsFixedUpdate( Kiwi::BenchmarkState& state, unsigned int count )
+		{
+
+			Kiwi::EngineRoot engine;
+			Kiwi::PhysicsSystem* physics = engine.GetPhysicsSystem();
+			physics->SetGravity( Kiwi::Vector3d( 0.0, 0.0, 0.0 ) );
+
+			Kiwi::BenchmarkScene scene( engine );
+
+			//keeps the density, and so the number of overlaps per sphere, the same for every count
+			double extent = 4.0 * std::cbrt( (double)count );
+
+			unsigned int seed = 7;
+			for( unsigned int i = 0; i < count; i++ )
+			{
+				Kiwi::Entity* entity = scene.CreateEntity( L"Sphere" + std::to_wstring( i ) );
+				entity->FindComponent<Kiwi::Transform>()->SetPosition( Kiwi::Vector3d( Kiwi::BenchmarkRandom( seed ) * extent, Kiwi::BenchmarkRandom( seed ) * extent, Kiwi::BenchmarkRandom( seed ) * extent ) );
+
+				Kiwi::Rigidbody* rigidbody = entity->AttachComponent( new Kiwi::Rigidbody() );
+				rigidbody->AttachComponent( new Kiwi::SphereCollider( 1.0 ) );
+			}
+
+			state.SetItemsPerIteration( 1, "step" );
+			while( state.Run() )
+			{
+				physics->FixedUpdate();
+			}
+
+		}
+
+	}
+
+	void RegisterPhysicsBenchmarks( Kiwi::BenchmarkRunner& runner )
+	{
+
+		runner.Register( "PhysicsSystem::FixedUpdate/100 spheres", []( Kiwi::BenchmarkState& state ) { PhysicsFixedUpdate( state, 100 ); } );
+		runner.Register( "PhysicsSystem::FixedUpdate/1000 spheres", []( Kiwi::BenchmarkState& state ) { PhysicsFixedUpdate( state, 1000 ); } );
+
+	}
+
+};
\ No newline at end of file
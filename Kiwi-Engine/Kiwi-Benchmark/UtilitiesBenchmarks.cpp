@@ -0,0 +1,47 @@
+#include "Benchmark.h"
+
+#include "Utilities/PerlinNoiseGenerator.h"
+#include "Core/Vector3d.h"
+
+#include <vector>
+
+namespace Kiwi
+{
+
+	namespace
+	{
+
+		/*fills a size x size height map with 'octaves' octaves of noise, the way terrain generation samples it*/
+		void PerlinGridFill( Kiwi::BenchmarkState& state, unsigned int size, int octaves )
+		{
+
+			Kiwi::PerlinNoiseGenerator generator( 12345 );
+			std::vector<double> heights( size * size );
+
+			state.SetItemsPerIteration( size * size, "sample" );
+			while( state.Run() )
+			{
+				for( unsigned int y = 0; y < size; y++ )
+				{
+					for( unsigned int x = 0; x < size; x++ )
+					{
+						heights[y * size + x] = generator.Perlin( Kiwi::Vector3d( (double)x, (double)y, 0.5 ), octaves, 0.5, 1.0 / 64.0 );
+					}
+				}
+
+				Kiwi::DoNotOptimize( heights[size * size / 2] );
+			}
+
+		}
+
+	}
+
+	void RegisterUtilitiesBenchmarks( Kiwi::BenchmarkRunner& runner )
+	{
+
+		runner.Register( "PerlinNoiseGenerator/256x256 grid/1 octave", []( Kiwi::BenchmarkState& state ) { PerlinGridFill( state, 256, 1 ); } );
+		runner.Register( "PerlinNoiseGenerator/256x256 grid/4 octaves", []( Kiwi::BenchmarkState& state ) { PerlinGridFill( state, 256, 4 ); } );
+
+	}
+
+};
\ No newline at end of file
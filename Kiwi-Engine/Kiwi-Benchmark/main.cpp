@@ -0,0 +1,72 @@
+#include "Benchmark.h"
+
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+
+/*Kiwi-Benchmark [--filter text] [--repetitions n] [--min-time seconds] [--csv file] [--list]*/
+int main( int argc, char** argv )
+{
+
+	Kiwi::BenchmarkRunner runner;
+	Kiwi::RegisterCoreBenchmarks( runner );
+	Kiwi::RegisterPhysicsBenchmarks( runner );
+	Kiwi::RegisterGraphicsBenchmarks( runner );
+	Kiwi::RegisterUtilitiesBenchmarks( runner );
+
+	std::string filter;
+	std::string csvFile;
+
+	for( int i = 1; i < argc; i++ )
+	{
+		std::string arg = argv[i];
+		bool hasValue = (i + 1 < argc);
+
+		if( arg == "--list" )
+		{
+			std::vector<std::string> names = runner.GetNames();
+			for( auto itr = names.begin(); itr != names.end(); itr++ )
+			{
+				std::printf( "%s\n", itr->c_str() );
+			}
+			return 0;
+
+		} else if( arg == "--filter" && hasValue )
+		{
+			filter = argv[++i];
+
+		} else if( arg == "--repetitions" && hasValue )
+		{
+			runner.SetRepetitions( (unsigned int)std::atoi( argv[++i] ) );
+
+		} else if( arg == "--min-time" && hasValue )
+		{
+			runner.SetMinTime( std::atof( argv[++i] ) );
+
+		} else if( arg == "--csv" && hasValue )
+		{
+			csvFile = argv[++i];
+
+		} else
+		{
+			std::printf( "usage: %s [--filter text] [--repetitions n] [--min-time seconds] [--csv file] [--list]\n", argv[0] );
+			return 1;
+		}
+	}
+
+	std::vector<Kiwi::BenchmarkResult> results = runner.Run( filter );
+
+	if( csvFile.size() > 0 && !Kiwi::BenchmarkRunner::WriteCSV( csvFile, results ) )
+	{
+		std::printf( "failed to write %s\n", csvFile.c_str() );
+		return 1;
+	}
+
+	for( auto itr = results.begin(); itr != results.end(); itr++ )
+	{
+		if( itr->error.size() > 0 ) return 1;
+	}
+
+	return 0;
+
+}
\ No newline at end of file
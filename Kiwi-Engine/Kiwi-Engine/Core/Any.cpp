@@ -41,7 +41,8 @@ namespace Kiwi
 
 	Kiwi::Any& Any::operator=( const Kiwi::Any& other )
 	{
-		return this->Swap( Kiwi::Any( other ) );
+		Kiwi::Any temp( other );
+		return this->Swap( temp );
 	}
 
 	Any::operator const void*() const
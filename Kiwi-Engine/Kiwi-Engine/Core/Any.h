@@ -68,7 +68,8 @@ namespace Kiwi
 		Kiwi::Any& operator=( const ValueType& val )
 		{ 
 
-			return this->Swap( Kiwi::Any( val ) ); 
+			Kiwi::Any temp( val );
+			return this->Swap( temp ); 
 
 		}
 		
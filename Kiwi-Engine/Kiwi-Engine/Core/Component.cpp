@@ -10,7 +10,7 @@ namespace Kiwi
 
 		if( !m_isShutdown )
 		{
-			MessageBox( NULL, m_objectName.c_str(), L"Component destroyed without being shutdown", MB_OK );
+			Kiwi::ShowError( L"Component destroyed without being shutdown", m_objectName );
 		}
 
 		for( auto itr = m_childComponents.begin(); itr != m_childComponents.end(); itr++ )
@@ -122,6 +122,12 @@ namespace Kiwi
 				m_entity->DetachComponent( this );
 				m_entity = 0;
 			}*/
+
+			//the entity removes the component at the end of the frame
+			if( m_entity )
+			{
+				m_entity->_OnComponentShutdown( this );
+			}
 		}
 
 	}
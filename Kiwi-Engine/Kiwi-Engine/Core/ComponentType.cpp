@@ -0,0 +1,29 @@
+#include "ComponentType.h"
+
+namespace Kiwi
+{
+
+	ComponentTypeRegistry::ComponentTypeTest ComponentTypeRegistry::TypeTests[KIWI_MAX_COMPONENT_TYPES] = { 0 };
+	std::atomic<unsigned int> ComponentTypeRegistry::TypeCount( 0 );
+	std::mutex ComponentTypeRegistry::RegistryMutex;
+
+	unsigned int ComponentTypeRegistry::Register( ComponentTypeTest typeTest )
+	{
+
+		std::lock_guard<std::mutex> guard( RegistryMutex );
+
+		static unsigned int nextID = 0;
+		unsigned int typeID = nextID++;
+
+		if( typeID < KIWI_MAX_COMPONENT_TYPES )
+		{
+			//store the test before publishing the new count so readers never see an empty slot
+			TypeTests[typeID] = typeTest;
+			TypeCount.store( typeID + 1, std::memory_order_release );
+		}
+
+		return typeID;
+
+	}
+
+}
\ No newline at end of file
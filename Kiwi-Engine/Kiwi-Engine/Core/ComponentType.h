@@ -0,0 +1,72 @@
+#ifndef _KIWI_COMPONENTTYPE_H_
+#define _KIWI_COMPONENTTYPE_H_
+
+#include <atomic>
+#include <mutex>
+
+//maximum number of distinct component types that get a constant-time lookup slot
+//types registered beyond this fall back to a linear search
+#define KIWI_MAX_COMPONENT_TYPES 64
+
+namespace Kiwi
+{
+
+	class Component;
+
+	/*bitmask with one bit per registered component type*/
+	typedef unsigned long long ComponentMask;
+
+	/*hands out a small, dense integer ID to each component class the first time it is looked up
+	and stores a function that tests whether a component is (or derives from) that class*/
+	class ComponentTypeRegistry
+	{
+	public:
+
+		typedef bool (*ComponentTypeTest)(Kiwi::Component*);
+
+	private:
+
+		static ComponentTypeTest TypeTests[KIWI_MAX_COMPONENT_TYPES];
+		static std::atomic<unsigned int> TypeCount;
+		static std::mutex RegistryMutex;
+
+	public:
+
+		/*registers a new component type and returns its ID*/
+		static unsigned int Register( ComponentTypeTest typeTest );
+
+		/*returns the number of component types that have a lookup slot*/
+		static unsigned int GetCount() { return TypeCount.load( std::memory_order_acquire ); }
+
+		/*returns true if the component is of the type with the given ID*/
+		static bool IsType( unsigned int typeID, Kiwi::Component* component ) { return TypeTests[typeID]( component ); }
+
+	};
+
+	template<class ComponentClass>
+	class ComponentType
+	{
+	private:
+
+		static bool _IsType( Kiwi::Component* component ) { return dynamic_cast<ComponentClass*>(component) != 0; }
+
+	public:
+
+		/*returns the ID of the component class. the ID is assigned on the first call and never changes*/
+		static unsigned int ID()
+		{
+			static const unsigned int typeID = Kiwi::ComponentTypeRegistry::Register( &ComponentType<ComponentClass>::_IsType );
+			return typeID;
+		}
+
+		/*returns the bit belonging to this component class, or 0 if the class did not get a lookup slot*/
+		static Kiwi::ComponentMask Mask()
+		{
+			return (ID() < KIWI_MAX_COMPONENT_TYPES) ? ((Kiwi::ComponentMask)1 << ID()) : 0;
+		}
+
+	};
+
+}
+
+#endif
\ No newline at end of file
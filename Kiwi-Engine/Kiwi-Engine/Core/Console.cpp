@@ -2,16 +2,20 @@
 
 #include "EngineRoot.h"
 #include "Scene.h"
+#include "Platform.h"
 
+#ifndef KIWI_HEADLESS
 #include "../Graphics/UI/UITextBox.h"
 #include "../Graphics/UI/UIScrollBar.h"
 #include "../Graphics/Texture.h"
 #include "../Graphics/RenderWindow.h"
+#endif
 
 namespace Kiwi
 {
 
-	Console::Console( Kiwi::EngineRoot& engine, std::wstring logFile )
+	Console::Console( Kiwi::EngineRoot& engine, std::wstring logFile ):
+		m_messages( 1000 )
 	{
 
 		m_engine = &engine;
@@ -43,33 +47,42 @@ namespace Kiwi
 	void Console::_Show()
 	{
 
+#ifndef KIWI_HEADLESS
 		if( m_textBox )
 		{
 			m_textBox->SetActive( true );
 		}
+#endif
 
 	}
 
 	void Console::_Hide()
 	{
 
+#ifndef KIWI_HEADLESS
 		if( m_textBox )
 		{
 			m_textBox->SetActive( false );
 		}
+#endif
 
 	}
 
 	void Console::_Print( std::wstring message, const Kiwi::Color& color )
 	{
 
+		//the history only keeps the newest messages, the log file keeps them all
+		this->Log( message );
+
 		ConsoleMessage msg = { color, message };
-		m_messages.push_back( msg );
+		m_messages.Push( msg );
 
+#ifndef KIWI_HEADLESS
 		if( m_textBox )
 		{
 			m_textBox->AddLine( message, color );
 		}
+#endif
 
 	}
 
@@ -89,6 +102,7 @@ namespace Kiwi
 
 		std::lock_guard<std::mutex> guard( m_consoleMutex );
 
+#ifndef KIWI_HEADLESS
 		if( m_scene && m_scene->GetRenderWindow() )
 		{
 			if( m_scene->GetRenderWindow()->GetInput().QueryKeyState( Kiwi::KEY::OEM3, Kiwi::KEY_RELEASED ) )
@@ -105,6 +119,7 @@ namespace Kiwi
 				}
 			}
 		}
+#endif
 
 	}
 
@@ -164,7 +179,8 @@ namespace Kiwi
 
 			this->_Print( L"Console Initialized", Kiwi::Color(1.0, 1.0, 1.0, 1.0) );
 
-			for( unsigned int i = 0; i < m_messages.size(); i++ )
+			m_textBox->SetHistorySize( m_messages.GetCapacity() );
+			for( unsigned int i = 0; i < m_messages.GetSize(); i++ )
 			{
 				m_textBox->AddLine( m_messages[i].message, m_messages[i].textColor );
 			}
@@ -174,6 +190,22 @@ namespace Kiwi
 
 	}
 
+	void Console::SetHistorySize( unsigned int messages )
+	{
+
+		std::lock_guard<std::mutex> guard( m_consoleMutex );
+
+		m_messages.SetCapacity( messages );
+
+#ifndef KIWI_HEADLESS
+		if( m_textBox )
+		{
+			m_textBox->SetHistorySize( messages );
+		}
+#endif
+
+	}
+
 	void Console::PrintDebug( std::wstring message )
 	{
 
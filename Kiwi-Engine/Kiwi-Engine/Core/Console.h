@@ -2,6 +2,7 @@
 #define _KIWI_CONSOLE_H_
 
 #include "Logger.h"
+#include "RingBuffer.h"
 
 #include "Vector3d.h"
 #include "Vector2d.h"
@@ -33,7 +34,8 @@ namespace Kiwi
 		Kiwi::EngineRoot* m_engine;
 		Kiwi::Scene* m_scene;
 
-		std::vector<ConsoleMessage> m_messages;
+		//the most recent messages, the oldest are dropped once the history is full
+		Kiwi::RingBuffer<ConsoleMessage> m_messages;
 
 		Kiwi::UITextBox* m_textBox;
 
@@ -79,6 +81,12 @@ namespace Kiwi
 
 		void EnableDebug( bool debugEnabled ) { m_debugEnabled = debugEnabled; }
 
+		/*sets how many messages the console and its text box keep, older messages are discarded
+		every printed message is also written to the console's log file, if it has one*/
+		void SetHistorySize( unsigned int messages );
+
+		unsigned int GetHistorySize()const { return (unsigned int)m_messages.GetCapacity(); }
+
 	};
 
 }
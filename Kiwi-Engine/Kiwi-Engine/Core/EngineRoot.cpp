@@ -3,8 +3,14 @@
 #include "Console.h"
 #include "RawInputWrapper.h"
 #include "Exception.h"
+#include "Profiler.h"
+#include "EventQueue.h"
+
+#ifndef KIWI_HEADLESS
+#include "../Graphics/RenderWindow.h"
 
 #include <Windows.h>
+#endif
 
 namespace Kiwi
 {
@@ -12,12 +18,14 @@ namespace Kiwi
 	Kiwi::Logger _Logger;
 
 	EngineRoot::EngineRoot():
-		m_sceneManager( this ), m_physicsSystem( *this )
+		m_sceneManager( this ), m_physicsSystem( *this ), m_frameGraph( m_jobSystem )
 	{
 
 		m_gameTimer.SetTargetUpdatesPerSecond( 60 );
+		m_gameWindow = 0;
+		m_console = 0;
 		m_initialized = false;
-		m_threadManager = new Kiwi::ThreadManager<Kiwi::IThreadParam*>();
+		m_threadManager = new Kiwi::ThreadManager<Kiwi::IThreadParam*>( m_jobSystem );
 		assert( m_threadManager != 0 );
 
 	}
@@ -37,59 +45,113 @@ namespace Kiwi
 	void EngineRoot::_MainLoop()
 	{
 
+		KIWI_PROFILE_THREAD( "Main" );
+
 		m_gameTimer.StartTimer();
 		m_gameTimer.Update();
 
 		m_engineRunning = true;
 		while( m_engineRunning )
 		{
+			//the timer marks the start of the frame for the frame statistics, so the frame zone has to start after it
 			m_gameTimer.Update();
 
-			this->_PumpMessages();
+			KIWI_PROFILE_ZONE( "Frame" );
 
-			if( m_gameWindow ) m_gameWindow->Update( m_gameTimer.GetDeltaTime() );
+			this->_PumpMessages();
 
-			//if enough time has passed, send a fixed update
-			if( m_gameTimer.QueryFixedUpdate() )
 			{
-				m_physicsSystem.FixedUpdate();
+				KIWI_PROFILE_ZONE( "EngineRoot::_BuildFrameGraph" );
+				m_frameGraph.Clear();
+				this->_BuildFrameGraph();
+			}
 
-				this->BroadcastEvent( Kiwi::FrameEvent( this, Kiwi::FrameEvent::EventType::TIMED_EVENT ) );
+			m_frameGraph.Execute();
 
-				if( m_console ) m_console->FixedUpdate();
-			}
+		}
 
-			m_physicsSystem.Update();
+		this->Shutdown();
 
-			//broadcast a new untimed frame event
-			this->BroadcastEvent( Kiwi::FrameEvent( this, Kiwi::FrameEvent::EventType::UNTIMED_EVENT ) );
+	}
 
-			if( m_console ) m_console->Update();
+	void EngineRoot::_BuildFrameGraph()
+	{
 
-			m_sceneManager.Render();
+		//frame events call into game code, which can touch anything. tasks that write 'world' act as a barrier
+		Kiwi::FrameResourceList world;
+		world.push_back( &m_sceneManager );
+		world.push_back( &m_physicsSystem );
+		world.push_back( m_console );
+		world.push_back( m_gameWindow );
+		for( auto itr = m_sceneManager.m_scenes.begin(); itr != m_sceneManager.m_scenes.end(); itr++ )
+		{
+			world.push_back( itr->second );
+		}
 
+#ifndef KIWI_HEADLESS
+		if( m_gameWindow )
+		{
+			m_frameGraph.AddTask( "RenderWindow::Update", [this]() { m_gameWindow->Update( m_gameTimer.GetDeltaTime() ); }, {}, { m_gameWindow }, true );
 		}
+#endif
 
-		this->Shutdown();
+		//run one fixed update for every fixed time step that has accumulated since the last frame
+		for( int step = 0; step < m_gameTimer.GetFixedStepCount(); step++ )
+		{
+			//the state before the last step is what rendering interpolates from
+			m_frameGraph.AddTask( "SceneManager::SaveFixedState", [this]() { m_sceneManager.SaveFixedState(); }, {}, world, true );
+
+			//rigidbodies move entities of any scene and collision events reach game code
+			m_frameGraph.AddTask( "PhysicsSystem::FixedUpdate", [this]() { m_physicsSystem.FixedUpdate(); }, {}, world, true );
+
+			m_frameGraph.AddTask( "FrameEvent::Timed", [this]() { this->BroadcastEvent( Kiwi::FrameEvent( this, Kiwi::FrameEvent::EventType::TIMED_EVENT ) ); }, {}, world, true );
+
+			if( m_console )
+			{
+				m_frameGraph.AddTask( "Console::FixedUpdate", [this]() { m_console->FixedUpdate(); }, {}, world, true );
+			}
+
+			//events deferred during the step (e.g. collisions) reach their listeners before the next step
+			m_frameGraph.AddTask( "EventQueues::FixedUpdate", []() { Kiwi::EventQueues::Dispatch( Kiwi::EVENT_PHASE_FIXED_UPDATE ); }, {}, world, true );
+		}
+
+		m_frameGraph.AddTask( "PhysicsSystem::Update", [this]() { m_physicsSystem.Update(); }, {}, world, true );
+
+		//broadcast a new untimed frame event
+		m_frameGraph.AddTask( "FrameEvent::Untimed", [this]() { this->BroadcastEvent( Kiwi::FrameEvent( this, Kiwi::FrameEvent::EventType::UNTIMED_EVENT ) ); }, {}, world, true );
+
+		if( m_console )
+		{
+			m_frameGraph.AddTask( "Console::Update", [this]() { m_console->Update(); }, {}, world, true );
+		}
+
+		//deferred events are handled before the render tasks snapshot the scenes
+		m_frameGraph.AddTask( "EventQueues::Update", []() { Kiwi::EventQueues::Dispatch( Kiwi::EVENT_PHASE_UPDATE ); }, {}, world, true );
+
+		m_sceneManager.AddRenderTasks( m_frameGraph );
 
 	}
 
 	void EngineRoot::_PumpMessages()
 	{
 
+#ifndef KIWI_HEADLESS
 		MSG msg;
 		while( PeekMessage( &msg, NULL, 0, 0, PM_REMOVE ) )
 		{
 			TranslateMessage( &msg );
 			DispatchMessage( &msg );
 		}
+#endif
 
 	}
 
 	void EngineRoot::Initialize( std::wstring logFile, Kiwi::RenderWindow* gameWindow )
 	{
 
+#ifndef KIWI_HEADLESS
 		assert( gameWindow != 0 );
+#endif
 
 		m_gameWindow = gameWindow;
 
@@ -107,11 +169,21 @@ namespace Kiwi
 
 		m_sceneManager.Shutdown();
 
+#ifndef KIWI_HEADLESS
 		m_graphicsManager.Shutdown();
+#endif
 
 		m_physicsSystem.Shutdown();
 
+#ifndef KIWI_HEADLESS
 		if( m_gameWindow ) m_gameWindow->Shutdown();
+#endif
+
+		const std::wstring& statisticsFile = m_gameTimer.GetStatisticsFile();
+		if( !statisticsFile.empty() && !m_gameTimer.WriteStatistics( statisticsFile ) )
+		{
+			KIWI_LOG( _Logger, L"EngineRoot::Shutdown: failed to write the frame statistics to {}", statisticsFile );
+		}
 
 	}
 
@@ -134,11 +206,13 @@ namespace Kiwi
 	void EngineRoot::SetMouseSensitivity( const Kiwi::Vector2& sens )
 	{
 
+#ifndef KIWI_HEADLESS
 		auto rwItr = m_graphicsManager.m_renderWindows.Front();
 		for( ; rwItr != m_graphicsManager.m_renderWindows.Back(); rwItr++ )
 		{
 			rwItr->second->GetInput().SetMouseSpeed( sens );
 		}
+#endif
 
 	}
 
@@ -4,9 +4,15 @@
 #include "FrameEventBroadcaster.h"
 #include "SceneManager.h"
 #include "GameTimer.h"
+#include "JobSystem.h"
+#include "FrameGraph.h"
 #include "ThreadManager.h"
+#include "Vector2.h"
+#include "Platform.h"
 
+#ifndef KIWI_HEADLESS
 #include "../Graphics/GraphicsManager.h"
+#endif
 
 #include "../Physics/PhysicsSystem.h"
 
@@ -16,6 +22,7 @@ namespace Kiwi
 {
 
 	class Console;
+	class RenderWindow;
 
 	class EngineRoot:
 		public Kiwi::FrameEventBroadcaster
@@ -25,18 +32,26 @@ namespace Kiwi
 		//class that contains and controls all created scenes
 		Kiwi::SceneManager m_sceneManager;
 
+#ifndef KIWI_HEADLESS
 		//class used to create and manage graphical components (e.g. renderer, renderWindow...)
 		Kiwi::GraphicsManager m_graphicsManager;
+#endif
 
 		Kiwi::PhysicsSystem m_physicsSystem;
 
-		//stores a pointer to the main game window
+		//stores a pointer to the main game window, always 0 in headless builds
 		Kiwi::RenderWindow* m_gameWindow;
 
 		Kiwi::GameTimer m_gameTimer;
 
 		Kiwi::Console* m_console;
 
+		//worker threads shared by the engine's parallel work and the threads spawned with SpawnThread
+		Kiwi::JobSystem m_jobSystem;
+
+		//the tasks of the current frame, rebuilt every frame
+		Kiwi::FrameGraph m_frameGraph;
+
 		Kiwi::ThreadManager<Kiwi::IThreadParam*>* m_threadManager;
 		std::unordered_set<unsigned int> m_activeThreadIDs;
 
@@ -48,12 +63,17 @@ namespace Kiwi
 		virtual void _MainLoop();
 		virtual void _PumpMessages();
 
+		/*adds the stages of one frame to the frame graph*/
+		virtual void _BuildFrameGraph();
+
 	public:
 
 		EngineRoot();
 		~EngineRoot();
 
-		void Initialize( std::wstring logFile, Kiwi::RenderWindow* gameWindow );
+		/*in headless builds there is no game window: the engine runs the timer, scenes and physics as usual,
+		scenes are created without a renderer and generate their render queues without submitting them*/
+		void Initialize( std::wstring logFile, Kiwi::RenderWindow* gameWindow = 0 );
 
 		void Shutdown();
 
@@ -63,9 +83,11 @@ namespace Kiwi
 
 		void SetMouseSensitivity( const Kiwi::Vector2& sens );
 
+		/*runs the function as a background job of the job system
+		returns an ID that can be passed to JoinThread and GetThreadStatus*/
 		unsigned int SpawnThread( Kiwi::IThreadParam* ( *threadFunction )(Kiwi::IThreadParam*), Kiwi::IThreadParam* threadParam = 0 );
 
-		/*spawns a class member function as a thread*/
+		/*spawns a class member function as a background job*/
 		template<typename FunctionClass>
 		unsigned int SpawnThread( FunctionClass* fClass, Kiwi::IThreadParam* (FunctionClass::*threadFunction)(Kiwi::IThreadParam*), Kiwi::IThreadParam* parameter )
 		{
@@ -84,7 +106,7 @@ namespace Kiwi
 
 		}
 
-		/*joins the specified thread*/
+		/*joins the specified thread, running queued jobs on the calling thread until it has finished*/
 		Kiwi::IThreadParam* JoinThread( unsigned int threadID );
 
 		Kiwi::ThreadStatus GetThreadStatus( unsigned int threadID );
@@ -93,8 +115,12 @@ namespace Kiwi
 		Kiwi::Console* GetConsole() { return m_console; }
 		Kiwi::RenderWindow* GetGameWindow()const { return m_gameWindow; }
 		Kiwi::SceneManager* GetSceneManager() { return &m_sceneManager; }
+#ifndef KIWI_HEADLESS
 		Kiwi::GraphicsManager* GetGraphicsManager() { return &m_graphicsManager; }
+#endif
 		Kiwi::PhysicsSystem* GetPhysicsSystem() { return &m_physicsSystem; }
+		Kiwi::JobSystem* GetJobSystem() { return &m_jobSystem; }
+		Kiwi::FrameGraph* GetFrameGraph() { return &m_frameGraph; }
 
 	};
 
@@ -1,6 +1,7 @@
 #include "Entity.h"
 #include "Transform.h"
 #include "Utilities.h"
+#include "EntityUpdateContext.h"
 #include "Scene.h"
 #include "IEntitySpawner.h"
 #include "EngineRoot.h"
@@ -25,8 +26,13 @@ namespace Kiwi
 		m_mesh = 0;
 		m_transform = 0;
 		m_rigidbody = 0;
+		m_componentMask = 0;
+		m_resolvedMask = 0;
+		m_queryMembership = 0;
+		m_componentCleanupQueued = false;
+		m_destroying = false;
 
-		this->AttachComponent( new Kiwi::Transform() );
+		this->AttachComponent( new Kiwi::Transform( scene.GetTransformStore() ) );
 
 	}
 
@@ -56,6 +62,12 @@ namespace Kiwi
 			}
 		}
 
+		if( m_rigidbody && m_scene && m_scene->GetPhysicsSystem() )
+		{
+			//make sure the physics system doesn't keep a pointer to the rigidbody
+			m_scene->GetPhysicsSystem()->RemoveRigidbody( m_rigidbody );
+		}
+
 		Kiwi::FreeMemory( m_components );
 		Kiwi::FreeMemory( m_childEntities );
 
@@ -99,6 +111,12 @@ namespace Kiwi
 					compItr->second->Shutdown();
 				}
 			}
+
+			//the entity is destroyed by the entity manager once nothing references it
+			if( m_scene )
+			{
+				m_scene->GetEntityManager()->_QueueDestroy( this );
+			}
 		}
 
 	}
@@ -113,8 +131,22 @@ namespace Kiwi
 		} else
 		{
 			m_components.insert( std::make_pair( key, std::unique_ptr<Kiwi::Component>( component ) ) );
+
+			//fill any looked-up type slots that were empty and that the new component matches
+			Kiwi::ComponentMask emptyTypes = m_resolvedMask & ~m_componentMask;
+			for( unsigned int typeID = 0; emptyTypes != 0; typeID++, emptyTypes >>= 1 )
+			{
+				if( (emptyTypes & 1) != 0 && Kiwi::ComponentTypeRegistry::IsType( typeID, component ) )
+				{
+					m_componentsByType[typeID] = component;
+					m_componentMask |= (Kiwi::ComponentMask)1 << typeID;
+				}
+			}
+
 			component->_SetEntity( this );
 			component->_OnAttached();
+
+			this->_OnComponentsChanged();
 		}
 	}
 
@@ -146,7 +178,10 @@ namespace Kiwi
 					comp->_SetEntity( 0 );
 					comp->Shutdown();
 				}
+				this->_InvalidateComponentType( comp );
 				m_components.erase( compItr );
+
+				this->_OnComponentsChanged();
 			}
 		}
 
@@ -164,52 +199,142 @@ namespace Kiwi
 		return 0;
 	}
 
-	void Entity::_RemoveAllShutdown()
+	void Entity::_ResolveComponentType( unsigned int typeID )
+	{
+
+		if( m_componentsByType.size() <= typeID )
+		{
+			m_componentsByType.resize( typeID + 1, 0 );
+		}
+
+		Kiwi::ComponentMask typeBit = (Kiwi::ComponentMask)1 << typeID;
+
+		m_componentsByType[typeID] = 0;
+		m_componentMask &= ~typeBit;
+
+		for( auto compItr = m_components.begin(); compItr != m_components.end(); compItr++ )
+		{
+			if( Kiwi::ComponentTypeRegistry::IsType( typeID, compItr->second.get() ) )
+			{
+				m_componentsByType[typeID] = compItr->second.get();
+				m_componentMask |= typeBit;
+				break;
+			}
+		}
+
+		m_resolvedMask |= typeBit;
+
+	}
+
+	void Entity::_InvalidateComponentType( Kiwi::Component* component )
+	{
+
+		Kiwi::ComponentMask presentTypes = m_componentMask;
+		for( unsigned int typeID = 0; presentTypes != 0; typeID++, presentTypes >>= 1 )
+		{
+			if( (presentTypes & 1) != 0 && m_componentsByType[typeID] == component )
+			{
+				//another component of the same type may still be attached, so look it up again next time
+				Kiwi::ComponentMask typeBit = (Kiwi::ComponentMask)1 << typeID;
+				m_componentsByType[typeID] = 0;
+				m_componentMask &= ~typeBit;
+				m_resolvedMask &= ~typeBit;
+			}
+		}
+
+	}
+
+	void Entity::_RemoveShutdownComponents()
 	{
 
+		bool removedComponent = false;
 		for( auto compItr = m_components.begin(); compItr != m_components.end(); )
 		{
-			if( compItr->second->IsShutdown() == true )
+			Kiwi::Component* component = compItr->second.get();
+
+			//the transform is never removed, the entity can't update without one
+			if( component->IsShutdown() == true && component != m_transform )
 			{
+				if( component == m_mesh )
+				{
+					m_mesh = 0;
+
+				} else if( component == m_rigidbody )
+				{
+					if( m_scene && m_scene->GetPhysicsSystem() )
+					{
+						m_scene->GetPhysicsSystem()->RemoveRigidbody( m_rigidbody );
+					}
+					m_rigidbody = 0;
+				}
+
+				this->_InvalidateComponentType( component );
 				compItr = m_components.erase( compItr );
+				removedComponent = true;
 				continue;
 			}
 
 			compItr++;
 		}
 
-		//update children
-		std::vector<Kiwi::Entity*> shutdownChildren;
-		for( auto childItr = m_childEntities.begin(); childItr != m_childEntities.end(); childItr++ )
+		if( removedComponent )
 		{
-			if( childItr->second != 0 )
-			{
-				if( childItr->second->IsShutdown() == false && childItr->second->IsActive() == true )
-				{
-					childItr->second->FixedUpdate();
+			this->_OnComponentsChanged();
+		}
+
+	}
+
+	void Entity::_OnComponentShutdown( Kiwi::Component* component )
+	{
+
+		//if the entity itself is shutting down, the component is destroyed along with it
+		if( m_isShutdown || m_componentCleanupQueued || m_scene == 0 ) return;
+
+		Kiwi::EntityManager* entityManager = m_scene->GetEntityManager();
+		if( entityManager->GetEntity( m_handle ) == this )
+		{
+			entityManager->_QueueComponentCleanup( this );
+			m_componentCleanupQueued = true;
+		}
 
-				} else if( childItr->second->IsShutdown() == true )
+	}
+
+	void Entity::_ReleaseHierarchy()
+	{
+
+		if( m_parent != 0 )
+		{
+			for( auto childItr = m_parent->m_childEntities.begin(); childItr != m_parent->m_childEntities.end(); childItr++ )
+			{
+				if( childItr->second == this )
 				{
-					shutdownChildren.push_back( childItr->second );
+					m_parent->m_childEntities.erase( childItr );
+					break;
 				}
 			}
+			m_parent = 0;
 		}
 
-		//detach and free all shutdown children
-		for( auto itr = shutdownChildren.begin(); itr != shutdownChildren.end(); itr++ )
+		for( auto childItr = m_childEntities.begin(); childItr != m_childEntities.end(); childItr++ )
 		{
-			this->DetachChild( *itr );
+			if( childItr->second != 0 && childItr->second->m_parent == this )
+			{
+				childItr->second->m_parent = 0;
+			}
 		}
+		m_childEntities.clear();
 
 	}
 
 	void Entity::Update()
 	{
 
-		static double elapsed = 0.0;
-
 		if( !m_isShutdown && m_isActive )
 		{
+			//set if this entity is being updated on a worker thread
+			Kiwi::EntityUpdateContext* context = Kiwi::EntityUpdateContext::Current;
+			bool deferComponents = false;
+
 			this->_OnUpdate();
 
 			m_transform->Update();
@@ -219,16 +344,35 @@ namespace Kiwi
 			{
 				if( compItr->second->IsShutdown() == false && compItr->second->IsActive() == true )
 				{
-					compItr->second->Update();
+					if( context != 0 && compItr->second->IsMainThreadOnly() )
+					{
+						deferComponents = true;
+
+					} else
+					{
+						compItr->second->Update();
+					}
 				}
 			}
 
+			if( deferComponents )
+			{
+				context->Defer( this, true );
+			}
+
 			//update children
 			for( auto childItr = m_childEntities.begin(); childItr != m_childEntities.end(); )
 			{
 				if( childItr->second != 0 )
 				{
-					childItr->second->Update();
+					if( context != 0 && childItr->second->IsMainThreadOnly() )
+					{
+						context->Defer( childItr->second, false );
+
+					} else
+					{
+						childItr->second->Update();
+					}
 
 				} else
 				{
@@ -238,14 +382,29 @@ namespace Kiwi
 				childItr++;
 			}
 
-			elapsed += m_scene->GetEngine()->GetGameTimer()->GetDeltaTime();
-			//once per second check for and remove shutdown children and components
-			if( elapsed >= 1.0 )
+		}
+
+	}
+
+	void Entity::_UpdateMainThreadComponents( bool fixedUpdate )
+	{
+
+		if( m_isShutdown || !m_isActive ) return;
+
+		for( auto compItr = m_components.begin(); compItr != m_components.end(); compItr++ )
+		{
+			Kiwi::Component* component = compItr->second.get();
+			if( component->IsMainThreadOnly() && component->IsShutdown() == false && component->IsActive() == true )
 			{
-				elapsed -= 1.0;
-				//this->_RemoveAllShutdown();
-			}
+				if( fixedUpdate )
+				{
+					component->FixedUpdate();
 
+				} else
+				{
+					component->Update();
+				}
+			}
 		}
 
 	}
@@ -255,17 +414,33 @@ namespace Kiwi
 
 		if( !m_isShutdown && m_isActive )
 		{
+			//set if this entity is being updated on a worker thread
+			Kiwi::EntityUpdateContext* context = Kiwi::EntityUpdateContext::Current;
+			bool deferComponents = false;
+
 			this->_OnFixedUpdate();
 
 			for( auto compItr = m_components.begin(); compItr != m_components.end(); compItr++ )
 			{
 				if( compItr->second->IsShutdown() == false && compItr->second->IsActive() == true )
 				{
-					compItr->second->FixedUpdate();
+					if( context != 0 && compItr->second->IsMainThreadOnly() )
+					{
+						deferComponents = true;
+
+					} else
+					{
+						compItr->second->FixedUpdate();
+					}
 
 				}
 			}
 
+			if( deferComponents )
+			{
+				context->Defer( this, true );
+			}
+
 			//update children
 			for( auto childItr = m_childEntities.begin(); childItr != m_childEntities.end(); childItr++ )
 			{
@@ -273,7 +448,14 @@ namespace Kiwi
 				{
 					if( childItr->second->IsShutdown() == false && childItr->second->IsActive() == true )
 					{
-						childItr->second->FixedUpdate();
+						if( context != 0 && childItr->second->IsMainThreadOnly() )
+						{
+							context->Defer( childItr->second, false );
+
+						} else
+						{
+							childItr->second->FixedUpdate();
+						}
 
 					}
 				}
@@ -326,13 +508,27 @@ namespace Kiwi
 	}
 
 	std::vector<Kiwi::Entity*> Entity::FindChildrenWithTag( std::wstring tag )
+	{
+
+		return this->FindChildrenWithTag( Kiwi::StringTable::Find( tag ) );
+
+	}
+
+	std::vector<Kiwi::Entity*> Entity::FindChildrenWithTag( Kiwi::StringId tag )
 	{
 
 		std::vector<Kiwi::Entity*> matches;
 
+		unsigned int tagIndex = Kiwi::TagTable::Find( tag );
+		if( tagIndex == Kiwi::TagTable::INVALID_TAG )
+		{
+			return matches;
+		}
+
+		Kiwi::TagMask tagMask = (Kiwi::TagMask)1 << tagIndex;
 		for( const auto& it : m_childEntities )
 		{
-			if( it.second->HasTag( tag ) )
+			if( it.second->HasTags( tagMask ) )
 			{
 				matches.push_back( it.second );
 			}
@@ -342,6 +538,79 @@ namespace Kiwi
 
 	}
 
+	void Entity::AddTag( Kiwi::StringId tag )
+	{
+
+		Kiwi::TagMask previousTags = m_tags;
+		Kiwi::GameObject::AddTag( tag );
+		this->_OnTagsChanged( previousTags );
+
+	}
+
+	void Entity::RemoveTag( Kiwi::StringId tag )
+	{
+
+		Kiwi::TagMask previousTags = m_tags;
+		Kiwi::GameObject::RemoveTag( tag );
+		this->_OnTagsChanged( previousTags );
+
+	}
+
+	void Entity::RemoveAllTags()
+	{
+
+		Kiwi::TagMask previousTags = m_tags;
+		Kiwi::GameObject::RemoveAllTags();
+		this->_OnTagsChanged( previousTags );
+
+	}
+
+	bool Entity::_MatchesComponents( Kiwi::ComponentMask mask )
+	{
+
+		//look up any of the types that haven't been resolved yet
+		Kiwi::ComponentMask unresolved = mask & ~m_resolvedMask;
+		for( unsigned int typeID = 0; unresolved != 0; typeID++, unresolved >>= 1 )
+		{
+			if( (unresolved & 1) != 0 )
+			{
+				this->_ResolveComponentType( typeID );
+			}
+		}
+
+		return (m_componentMask & mask) == mask;
+
+	}
+
+	void Entity::_OnComponentsChanged()
+	{
+
+		if( m_scene == 0 ) return;
+
+		//only entities managed by the scene are in its queries
+		Kiwi::EntityManager* entityManager = m_scene->GetEntityManager();
+		if( entityManager->GetEntity( m_handle ) == this )
+		{
+			entityManager->_UpdateQueryMembership( this );
+		}
+
+	}
+
+	void Entity::_OnTagsChanged( Kiwi::TagMask previousTags )
+	{
+
+		if( m_scene == 0 || previousTags == m_tags ) return;
+
+		//only entities managed by the scene are in its tag index
+		Kiwi::EntityManager* entityManager = m_scene->GetEntityManager();
+		if( entityManager->GetEntity( m_handle ) == this )
+		{
+			entityManager->_AddToTagIndex( this, m_tags & ~previousTags );
+			entityManager->_RemoveFromTagIndex( this, previousTags & ~m_tags );
+		}
+
+	}
+
 	void Entity::AttachChild( Kiwi::Entity* entity )
 	{
 
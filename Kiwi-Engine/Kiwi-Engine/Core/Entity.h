@@ -3,13 +3,17 @@
 
 #include "GameObject.h"
 #include "Transform.h"
-#include "Events\ITransformEventListener.h"
+#include "ComponentType.h"
+#include "EntityHandle.h"
+#include "MemoryPool.h"
+#include "Events/ITransformEventListener.h"
 #include "../Physics/ICollisionEventListener.h"
 
 #include <string>
 #include <vector>
 #include <unordered_set>
 #include <unordered_map>
+#include <memory>
 
 namespace Kiwi
 {
@@ -24,6 +28,7 @@ namespace Kiwi
 	struct ComponentKeyHash;
 
 	typedef std::unordered_multimap<std::wstring, Kiwi::Entity*> EntityMap;
+	typedef std::vector<Kiwi::Entity*> EntityList;
 
 	class Entity:
 		public Kiwi::GameObject,
@@ -31,6 +36,7 @@ namespace Kiwi
 	{
 	friend class Scene;
 	friend class EntityManager;
+	friend class Component;
 	public:
 
 		enum EntityType { ENTITY_3D, ENTITY_2D, ENTITY_LIGHT, ENTITY_SOUND };
@@ -39,6 +45,8 @@ namespace Kiwi
 
 		EntityType m_entityType;
 
+		Kiwi::EntityHandle m_handle; //handle assigned by the entity manager that owns this entity
+
 		Kiwi::Scene* m_scene;
 
 		Kiwi::Entity* m_parent;
@@ -53,6 +61,18 @@ namespace Kiwi
 		std::unordered_multimap<std::wstring, Kiwi::Entity*> m_childEntities;
 		std::unordered_map<ComponentKey, std::unique_ptr<Component>, ComponentKeyHash, ComponentKeyEquals> m_components;
 
+		/*first attached component of each registered component type, indexed by type ID
+		a slot is only valid if its bit is set in both m_resolvedMask and m_componentMask*/
+		std::vector<Kiwi::Component*> m_componentsByType;
+		Kiwi::ComponentMask m_componentMask; //types that have an attached component
+		Kiwi::ComponentMask m_resolvedMask; //types whose slot has been looked up and is up to date
+
+		unsigned long long m_queryMembership; //one bit per entity manager query this entity currently matches
+
+		bool m_componentCleanupQueued; //true if the entity is waiting for the entity manager to remove its shutdown components
+
+		bool m_destroying; //true once the entity manager has started destroying the entity and removing it from its lists
+
 	protected:
 
 		virtual void _OnActivate();
@@ -63,17 +83,42 @@ namespace Kiwi
 
 		Kiwi::Component* _FindComponent( ComponentKey key );
 
-		//removes all shutdown entities and children
-		//entities are detached and freed, components are deleted
-		void _RemoveAllShutdown();
+		//deletes all shutdown components except the transform
+		void _RemoveShutdownComponents();
+
+		//called by a component when it is shut down, queues the entity for component cleanup
+		void _OnComponentShutdown( Kiwi::Component* component );
+
+		//detaches the entity from its parent and its children without freeing any references
+		//called right before the entity is destroyed so no other entity is left pointing to it
+		void _ReleaseHierarchy();
+
+		/*scans the attached components for the first component of the given type and caches it*/
+		void _ResolveComponentType( unsigned int typeID );
+
+		/*returns true if the entity has a component of every type in the mask*/
+		bool _MatchesComponents( Kiwi::ComponentMask mask );
+
+		/*updates the scene's query match lists after a component has been attached or detached*/
+		void _OnComponentsChanged();
+
+		/*updates the scene's tag index after this entity's tags have changed*/
+		void _OnTagsChanged( Kiwi::TagMask previousTags );
 
+		/*clears any cached type slots that point to the component, so they are looked up again*/
+		void _InvalidateComponentType( Kiwi::Component* component );
+
+		/*runs Update or FixedUpdate of the main-thread-only components that were skipped by a parallel update*/
+		void _UpdateMainThreadComponents( bool fixedUpdate );
+
+		/*linear search used for component types that did not get a lookup slot*/
 		template<class ComponentClass>
 		ComponentClass* _FindComponent()
 		{
 			//return first component matching the given type
-			for( auto compItr = m_components.begin(); compItr != m_components.end(); compItr )
+			for( auto compItr = m_components.begin(); compItr != m_components.end(); compItr++ )
 			{
-				ComponentClass* comp = dynamic_cast<ComponentClass*>(compItr->second);
+				ComponentClass* comp = dynamic_cast<ComponentClass*>(compItr->second.get());
 				if( comp != NULL )
 				{
 					return comp;
@@ -85,6 +130,8 @@ namespace Kiwi
 
 	public:
 
+		KIWI_DECLARE_POOLED( Entity )
+
 		Entity(std::wstring name, Kiwi::Scene& scene);
 		virtual ~Entity();
 
@@ -92,11 +139,19 @@ namespace Kiwi
 		virtual void Update();
 		virtual void Shutdown();
 
+		using Kiwi::GameObject::AddTag;
+		using Kiwi::GameObject::RemoveTag;
+
+		virtual void AddTag( Kiwi::StringId tag );
+		virtual void RemoveTag( Kiwi::StringId tag );
+		virtual void RemoveAllTags();
+
 		virtual void OnTranslate( const Kiwi::TransformEvent& evt ) {}
 		virtual void OnRotate( const Kiwi::TransformEvent& evt ) {}
 
 		virtual Kiwi::Entity* FindChildWithName(std::wstring name);
 		virtual std::vector<Kiwi::Entity*> FindChildrenWithTag(std::wstring tag);
+		virtual std::vector<Kiwi::Entity*> FindChildrenWithTag( Kiwi::StringId tag );
 
 		virtual void AttachChild( Kiwi::Entity* entity );
 
@@ -119,6 +174,10 @@ namespace Kiwi
 		virtual Entity::EntityType GetType()const { return m_entityType; }
 		virtual Kiwi::Scene* GetScene()const { return m_scene; }
 
+		/*returns the handle of this entity in its scene's entity manager
+		the handle is null until the entity has been added to a scene*/
+		Kiwi::EntityHandle GetHandle()const { return m_handle; }
+
 		Kiwi::Component* AttachComponent( Kiwi::Component* component );
 
 		/*replaces the current transform with the new one*/
@@ -140,40 +199,32 @@ namespace Kiwi
 		upon being detached the component will be destroyed and the memory freed*/
 		void DetachComponent( int componentID );
 
-		/*returns the first component that matches the given type*/
+		/*returns the first component that matches the given type
+		the first lookup of a type scans the components once, after that the result is cached
+		and kept up to date as components are attached and detached*/
 		template<class ComponentClass>
 		ComponentClass* FindComponent()
 		{
-			//return first component matching the given type
-			for( auto compItr = m_components.begin(); compItr != m_components.end(); compItr++ )
+			unsigned int typeID = Kiwi::ComponentType<ComponentClass>::ID();
+			if( typeID >= KIWI_MAX_COMPONENT_TYPES )
 			{
-				ComponentClass* comp = dynamic_cast<ComponentClass*>(compItr->second.get());
-				if( comp != NULL )
-				{
-					return comp;
-				}
+				return this->_FindComponent<ComponentClass>();
 			}
 
-			return 0;
-		}
-
-		template<>
-		Kiwi::Transform* FindComponent<Kiwi::Transform>()
-		{
-			return m_transform;
-		}
+			Kiwi::ComponentMask typeBit = (Kiwi::ComponentMask)1 << typeID;
+			if( (m_resolvedMask & typeBit) == 0 )
+			{
+				this->_ResolveComponentType( typeID );
+			}
 
-		template<>
-		Kiwi::Mesh* FindComponent<Kiwi::Mesh>()
-		{
-			return m_mesh;
+			return ((m_componentMask & typeBit) != 0) ? static_cast<ComponentClass*>(m_componentsByType[typeID]) : 0;
 		}
 
-		/*returns the first component that matches the given type*/
-		template<>
-		Kiwi::Rigidbody* FindComponent<Kiwi::Rigidbody>()
+		/*returns true if a component of the given type is attached*/
+		template<class ComponentClass>
+		bool HasComponent()
 		{
-			return m_rigidbody;
+			return this->FindComponent<ComponentClass>() != 0;
 		}
 
 		/*returns the component with the given name*/
@@ -191,6 +242,27 @@ namespace Kiwi
 		}
 
 	};
+
+	//the transform, mesh and rigidbody are cached on the entity
+	//(specialized at namespace scope so that compilers other than msvc accept them)
+	template<>
+	inline Kiwi::Transform* Entity::FindComponent<Kiwi::Transform>()
+	{
+		return m_transform;
+	}
+
+	template<>
+	inline Kiwi::Mesh* Entity::FindComponent<Kiwi::Mesh>()
+	{
+		return m_mesh;
+	}
+
+	template<>
+	inline Kiwi::Rigidbody* Entity::FindComponent<Kiwi::Rigidbody>()
+	{
+		return m_rigidbody;
+	}
+
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef _KIWI_ENTITYHANDLE_H_
+#define _KIWI_ENTITYHANDLE_H_
+
+//number of bits of an entity handle used for the slot index, the rest hold the generation
+#define KIWI_ENTITYHANDLE_INDEX_BITS 20
+#define KIWI_ENTITYHANDLE_INDEX_MASK ((1u << KIWI_ENTITYHANDLE_INDEX_BITS) - 1)
+#define KIWI_ENTITYHANDLE_GENERATION_MASK (0xFFFFFFFFu >> KIWI_ENTITYHANDLE_INDEX_BITS)
+
+namespace Kiwi
+{
+
+	/*32 bit reference to an entity owned by an EntityManager
+	the low bits store the index of the entity's slot, the high bits store the generation of the slot
+	when the handle was created. each time a slot is freed its generation is incremented, so handles to
+	destroyed entities can be detected instead of pointing to freed memory
+	generation 0 is never used, so a value of 0 is always an invalid handle*/
+	struct EntityHandle
+	{
+
+		unsigned int value;
+
+		EntityHandle() { value = 0; }
+		explicit EntityHandle( unsigned int handleValue ) { value = handleValue; }
+		EntityHandle( unsigned int index, unsigned int generation ) { value = (index & KIWI_ENTITYHANDLE_INDEX_MASK) | ((generation & KIWI_ENTITYHANDLE_GENERATION_MASK) << KIWI_ENTITYHANDLE_INDEX_BITS); }
+
+		unsigned int GetIndex()const { return value & KIWI_ENTITYHANDLE_INDEX_MASK; }
+		unsigned int GetGeneration()const { return value >> KIWI_ENTITYHANDLE_INDEX_BITS; }
+
+		/*returns true if the handle has never been assigned to an entity*/
+		bool IsNull()const { return value == 0; }
+
+		bool operator==( const EntityHandle& other )const { return value == other.value; }
+		bool operator!=( const EntityHandle& other )const { return value != other.value; }
+
+	};
+
+}
+
+#endif
\ No newline at end of file
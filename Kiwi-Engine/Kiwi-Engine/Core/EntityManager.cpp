@@ -2,13 +2,22 @@
 #include "Entity.h"
 #include "Exception.h"
 #include "Utilities.h"
+#include "Scene.h"
+#include "EngineRoot.h"
+#include "Profiler.h"
 
 #include "../Graphics/RenderQueue.h"
-#include "..\Graphics\Mesh.h"
+#include "../Graphics/Mesh.h"
+
+#include <algorithm>
 
 namespace Kiwi
 {
 
+	thread_local Kiwi::EntityUpdateContext* EntityUpdateContext::Current = 0;
+
+	const unsigned int EntityManager::INVALID_INDEX;
+
 	EntityManager::EntityManager( Kiwi::Scene& scene )
 	{
 
@@ -16,30 +25,182 @@ namespace Kiwi
 		m_renderQueue = new Kiwi::RenderQueue( *m_scene );
 		assert( m_renderQueue );
 
+		m_updateThreadCount = 1;
+		m_deterministicUpdate = false;
+		m_nextUpdateRoot = 0;
+		m_deferIndexRemoval = false;
+		m_staleQueries = 0;
+		m_staleTags = 0;
+
 	}
 
 	EntityManager::~EntityManager()
 	{
 
-		for( auto it = m_entities.begin(); it != m_entities.end();)
+		//break up the hierarchy first so no entity touches an already deleted parent or child
+		for( auto it = m_entities.begin(); it != m_entities.end(); it++ )
+		{
+			(*it)->_ReleaseHierarchy();
+		}
+
+		for( auto it = m_entities.begin(); it != m_entities.end(); it++ )
+		{
+			SAFE_DELETE( *it );
+		}
+
+		Kiwi::FreeMemory( m_pendingDestroy );
+		Kiwi::FreeMemory( m_pendingComponentCleanup );
+
+		Kiwi::FreeMemory( m_entities );
+		Kiwi::FreeMemory( m_slots );
+		Kiwi::FreeMemory( m_freeSlots );
+		Kiwi::FreeMemory( m_nameIndex );
+		Kiwi::FreeMemory( m_tagIndex );
+
+		for( auto queryItr = m_queries.begin(); queryItr != m_queries.end(); queryItr++ )
 		{
-			SAFE_DELETE(it->second);
-			it = m_entities.erase(it);
+			SAFE_DELETE( *queryItr );
 		}
+		Kiwi::FreeMemory( m_queries );
+		Kiwi::FreeMemory( m_queryIndex );
 
 		SAFE_DELETE( m_renderQueue );
 
 	}
 
+	void EntityManager::_InsertEntity( Kiwi::Entity* entity )
+	{
+
+		unsigned int slotIndex = 0;
+		if( m_freeSlots.size() > 0 )
+		{
+			slotIndex = m_freeSlots.back();
+			m_freeSlots.pop_back();
+
+		} else
+		{
+			if( m_slots.size() > KIWI_ENTITYHANDLE_INDEX_MASK )
+			{
+				throw Kiwi::Exception( L"EntityManager::_InsertEntity", L"Maximum number of entities reached" );
+			}
+
+			EntitySlot newSlot;
+			newSlot.denseIndex = INVALID_INDEX;
+			newSlot.generation = 1;
+			m_slots.push_back( newSlot );
+			slotIndex = (unsigned int)m_slots.size() - 1;
+		}
+
+		EntitySlot& slot = m_slots[slotIndex];
+		slot.denseIndex = (unsigned int)m_entities.size();
+
+		entity->m_handle = Kiwi::EntityHandle( slotIndex, slot.generation );
+
+		m_entities.push_back( entity );
+		m_nameIndex.insert( std::make_pair( entity->m_objectName, entity->m_handle ) );
+		this->_AddToTagIndex( entity, entity->GetTagMask() );
+
+		entity->m_queryMembership = 0;
+		this->_UpdateQueryMembership( entity );
+
+		if( entity->IsShutdown() )
+		{
+			m_pendingDestroy.push_back( entity );
+		}
+
+	}
+
+	void EntityManager::_DestroyEntity( unsigned int denseIndex )
+	{
+
+		Kiwi::Entity* entity = m_entities[denseIndex];
+		Kiwi::EntityHandle handle = (entity != 0) ? entity->m_handle : Kiwi::EntityHandle();
+
+		//move the last entity into the freed position to keep the list packed
+		unsigned int last = (unsigned int)m_entities.size() - 1;
+		if( denseIndex != last )
+		{
+			m_entities[denseIndex] = m_entities[last];
+			if( m_entities[denseIndex] != 0 )
+			{
+				m_slots[m_entities[denseIndex]->m_handle.GetIndex()].denseIndex = denseIndex;
+			}
+		}
+		m_entities.pop_back();
+
+		if( entity == 0 ) return;
+
+		//a batch is unlinked and compacted before its entities are destroyed, the lists may not point to deleted entities
+		assert( !m_deferIndexRemoval );
+		this->_UnlinkEntity( entity );
+
+		if( entity->m_componentCleanupQueued )
+		{
+			auto cleanupItr = std::find( m_pendingComponentCleanup.begin(), m_pendingComponentCleanup.end(), entity );
+			if( cleanupItr != m_pendingComponentCleanup.end() )
+			{
+				m_pendingComponentCleanup.erase( cleanupItr );
+			}
+		}
+
+		entity->_ReleaseHierarchy();
+
+		//remove the entity from the name index. if the entity was renamed after it was added, fall back to a full search
+		bool removedName = false;
+		auto nameRange = m_nameIndex.equal_range( entity->m_objectName );
+		for( auto nameItr = nameRange.first; nameItr != nameRange.second; nameItr++ )
+		{
+			if( nameItr->second == handle )
+			{
+				m_nameIndex.erase( nameItr );
+				removedName = true;
+				break;
+			}
+		}
+		if( !removedName )
+		{
+			for( auto nameItr = m_nameIndex.begin(); nameItr != m_nameIndex.end(); nameItr++ )
+			{
+				if( nameItr->second == handle )
+				{
+					m_nameIndex.erase( nameItr );
+					break;
+				}
+			}
+		}
+
+		//free the slot, incrementing its generation so existing handles to it become stale
+		EntitySlot& slot = m_slots[handle.GetIndex()];
+		slot.denseIndex = INVALID_INDEX;
+		slot.generation = (slot.generation + 1) & KIWI_ENTITYHANDLE_GENERATION_MASK;
+		if( slot.generation == 0 ) slot.generation = 1;
+		m_freeSlots.push_back( handle.GetIndex() );
+
+		SAFE_DELETE( entity );
+
+	}
+
 	void EntityManager::Update()
 	{
 
-		for( auto itr = m_entities.begin(); itr != m_entities.end(); itr++ )
+		KIWI_PROFILE_ZONE( "EntityManager::Update" );
+
+		this->DestroyPending();
+
+		if( m_updateThreadCount > 1 )
 		{
+			this->_UpdateParallel( false );
+			return;
+		}
+
+		//iterate by index, entities created during the update are appended to the list
+		for( unsigned int i = 0; i < m_entities.size(); i++ )
+		{
+			Kiwi::Entity* entity = m_entities[i];
 			//only want to update active non-children (parents are responsible for updating children)
-			if( itr->second != 0 && itr->second->IsActive() && itr->second->GetParent() == 0 )
+			if( entity != 0 && entity->IsActive() && entity->GetParent() == 0 )
 			{
-				itr->second->Update();
+				entity->Update();
 			}
 		}
 
@@ -48,29 +209,206 @@ namespace Kiwi
 	void EntityManager::FixedUpdate()
 	{
 
-		for( auto itr = m_entities.begin(); itr != m_entities.end(); )
+		KIWI_PROFILE_ZONE( "EntityManager::FixedUpdate" );
+
+		if( m_updateThreadCount > 1 )
+		{
+			this->_UpdateParallel( true );
+			return;
+		}
+
+		//shutdown entities are destroyed by DestroyPending
+		for( unsigned int i = 0; i < m_entities.size(); i++ )
 		{
-			if( itr->second == 0 || (itr->second->IsShutdown() && itr->second->GetReferenceCount() == 0) )
+			Kiwi::Entity* entity = m_entities[i];
+			if( entity != 0 && entity->IsActive() && entity->GetParent() == 0 )
 			{
-				SAFE_DELETE( itr->second );
-				itr = m_entities.erase( itr );
-				continue;
+				entity->FixedUpdate();
+			}
+		}
+
+	}
+
+	void EntityManager::SetParallelUpdate( unsigned int threadCount, bool deterministic )
+	{
+
+		m_deterministicUpdate = deterministic;
+
+		if( threadCount == 0 ) threadCount = 1;
+		if( threadCount == m_updateThreadCount ) return;
+
+		m_updateThreadCount = threadCount;
+		Kiwi::FreeMemory( m_updateContexts );
+
+		if( threadCount > 1 )
+		{
+			m_updateContexts.resize( threadCount );
+		}
+
+	}
 
-			} else if( itr->second != 0 && itr->second->IsActive() && itr->second->GetParent() == 0 )
+	void EntityManager::_UpdateParallel( bool fixedUpdate )
+	{
+
+		//snapshot the roots, entities created during the update are not updated until the next frame
+		m_updateRoots.clear();
+		for( unsigned int i = 0; i < m_entities.size(); i++ )
+		{
+			Kiwi::Entity* entity = m_entities[i];
+			if( entity != 0 && entity->IsActive() && entity->GetParent() == 0 )
 			{
-				itr->second->FixedUpdate();
+				m_updateRoots.push_back( entity );
+			}
+		}
+
+		if( m_updateRoots.size() < KIWI_PARALLEL_UPDATE_MIN_ROOTS )
+		{
+			//not worth waking the workers
+			for( unsigned int i = 0; i < m_updateRoots.size(); i++ )
+			{
+				if( fixedUpdate )
+				{
+					m_updateRoots[i]->FixedUpdate();
+
+				} else
+				{
+					m_updateRoots[i]->Update();
+				}
+			}
+			return;
+		}
+
+		Kiwi::TransformStore& transformStore = m_scene->GetTransformStore();
+		transformStore.SetConcurrentWrites( true );
+		m_nextUpdateRoot = 0;
+
+		try
+		{
+			//one job per update context, the calling thread helps running them
+			m_scene->GetEngine()->GetJobSystem()->ParallelFor( m_updateThreadCount, 1,
+															   [this, fixedUpdate]( unsigned int begin, unsigned int end )
+			{
+				for( unsigned int i = begin; i < end; i++ )
+				{
+					this->_UpdateWorker( i, fixedUpdate );
+				}
+			} );
+
+		} catch( ... )
+		{
+			transformStore.SetConcurrentWrites( false );
+			throw;
+		}
+
+		transformStore.SetConcurrentWrites( false );
+
+		if( m_deterministicUpdate )
+		{
+			auto handleOrder = []( const Kiwi::Entity* e1, const Kiwi::Entity* e2 ) { return e1->m_handle.value < e2->m_handle.value; };
+			std::sort( m_pendingDestroy.begin(), m_pendingDestroy.end(), handleOrder );
+			std::sort( m_pendingComponentCleanup.begin(), m_pendingComponentCleanup.end(), handleOrder );
+			transformStore.SortChanges();
+		}
+
+		//run the main-thread-only updates in the order the root entities would have been updated in
+		m_deferredUpdates.clear();
+		for( unsigned int i = 0; i < m_updateContexts.size(); i++ )
+		{
+			m_deferredUpdates.insert( m_deferredUpdates.end(), m_updateContexts[i].deferred.begin(), m_updateContexts[i].deferred.end() );
+			m_updateContexts[i].deferred.clear();
+		}
+		std::stable_sort( m_deferredUpdates.begin(), m_deferredUpdates.end(),
+						  []( const Kiwi::EntityUpdateContext::DeferredUpdate& d1, const Kiwi::EntityUpdateContext::DeferredUpdate& d2 ) { return d1.rootIndex < d2.rootIndex; } );
+
+		for( unsigned int i = 0; i < m_deferredUpdates.size(); i++ )
+		{
+			Kiwi::Entity* entity = m_deferredUpdates[i].entity;
+			if( m_deferredUpdates[i].componentsOnly )
+			{
+				entity->_UpdateMainThreadComponents( fixedUpdate );
+
+			} else if( fixedUpdate )
+			{
+				entity->FixedUpdate();
+
+			} else
+			{
+				entity->Update();
 			}
-			itr++;
 		}
 
 	}
 
+	void EntityManager::_UpdateWorker( unsigned int workerIndex, bool fixedUpdate )
+	{
+
+		KIWI_PROFILE_ZONE( "EntityManager::_UpdateWorker" );
+
+		Kiwi::EntityUpdateContext& context = m_updateContexts[workerIndex];
+		context.deferred.clear();
+
+		unsigned int rootCount = (unsigned int)m_updateRoots.size();
+		unsigned int threadCount = (unsigned int)m_updateContexts.size();
+
+		Kiwi::EntityUpdateContext::Current = &context;
+
+		try
+		{
+			while( true )
+			{
+				unsigned int begin, end;
+				if( m_deterministicUpdate )
+				{
+					//fixed, contiguous range per thread
+					begin = (unsigned int)(((unsigned long long)rootCount * workerIndex) / threadCount);
+					end = (unsigned int)(((unsigned long long)rootCount * (workerIndex + 1)) / threadCount);
+
+				} else
+				{
+					begin = m_nextUpdateRoot.fetch_add( KIWI_PARALLEL_UPDATE_BATCH_SIZE );
+					if( begin >= rootCount ) break;
+					end = (begin + KIWI_PARALLEL_UPDATE_BATCH_SIZE < rootCount) ? begin + KIWI_PARALLEL_UPDATE_BATCH_SIZE : rootCount;
+				}
+
+				for( unsigned int i = begin; i < end; i++ )
+				{
+					Kiwi::Entity* entity = m_updateRoots[i];
+					context.rootIndex = i;
+
+					if( entity->IsMainThreadOnly() )
+					{
+						context.Defer( entity, false );
+
+					} else if( fixedUpdate )
+					{
+						entity->FixedUpdate();
+
+					} else
+					{
+						entity->Update();
+					}
+				}
+
+				if( m_deterministicUpdate ) break;
+			}
+
+		} catch( ... )
+		{
+			Kiwi::EntityUpdateContext::Current = 0;
+			throw;
+		}
+
+		Kiwi::EntityUpdateContext::Current = 0;
+
+	}
+
 	Kiwi::RenderQueue* EntityManager::GenerateRenderQueue()
 	{
 
 		if( m_renderQueue )
 		{
-			m_renderQueue->Generate( &m_entities );
+			//only entities with a mesh can be rendered
+			m_renderQueue->Generate( this->Query<Kiwi::Mesh>().GetEntities() );
 			return m_renderQueue;
 		}
 
@@ -91,8 +429,16 @@ namespace Kiwi
 	void EntityManager::AddEntity(Kiwi::Entity* entity, bool destroyExisting)
 	{
 
+		//structural changes are not allowed from worker threads, the object making them must be main-thread-only
+		assert( Kiwi::EntityUpdateContext::Current == 0 );
+
 		if(entity == 0) return;
 
+		if( this->GetEntity( entity->m_handle ) == entity )
+		{//entity is already managed by this entity manager
+			return;
+		}
+
 		/*if( this->FindWithName( entity->GetName() ) )
 		{
 			if( destroyExisting )
@@ -104,7 +450,7 @@ namespace Kiwi
 
 		}else
 		{*/
-			m_entities.insert( std::make_pair( entity->GetName(), entity ) );
+			this->_InsertEntity( entity );
 		//}
 
 		////add any children belonging to the entity
@@ -134,7 +480,7 @@ namespace Kiwi
 
 		Kiwi::Entity* newEntity = new Kiwi::Entity( name, *m_scene );
 
-		m_entities.insert( std::make_pair( name, newEntity ) );
+		this->_InsertEntity( newEntity );
 
 		return newEntity;
 
@@ -143,22 +489,27 @@ namespace Kiwi
 	void EntityManager::Raytrace( const Kiwi::Vector3d& origin, const Kiwi::Vector3d& direction, double maxDepthFromOrigin, std::vector<Kiwi::Entity*>& hits )
 	{
 
-		auto itr = m_entities.begin();
-		for( ; itr != m_entities.end(); itr++ )
+		static const Kiwi::TagMask terrainTag = Kiwi::TagTable::GetMask( L"terrain" );
+
+		//only entities with a mesh can be hit
+		const Kiwi::EntityList* meshEntities = this->Query<Kiwi::Mesh>().GetEntities();
+
+		auto itr = meshEntities->begin();
+		for( ; itr != meshEntities->end(); itr++ )
 		{
-			if( itr->second != 0 && itr->second->IsShutdown() == false && itr->second->IsActive() && itr->second->HasTag(L"terrain") == false )
+			if( *itr != 0 && (*itr)->IsShutdown() == false && (*itr)->IsActive() && ((*itr)->GetTagMask() & terrainTag) == 0 )
 			{
-				Kiwi::Mesh* mesh = itr->second->FindComponent<Kiwi::Mesh>();
+				Kiwi::Mesh* mesh = (*itr)->FindComponent<Kiwi::Mesh>();
 				if( mesh != 0 && mesh->IsShutdown() == false && mesh->IsActive() == true )
 				{
-					Kiwi::Transform* transform = itr->second->FindComponent<Kiwi::Transform>();
+					Kiwi::Transform* transform = (*itr)->FindComponent<Kiwi::Transform>();
 					if( transform != 0 && transform->GetSquareDistance(origin) <= maxDepthFromOrigin * maxDepthFromOrigin )
 					{
 						std::vector<Kiwi::Mesh::Triangle> tIntersect;
 						mesh->IntersectRay( origin, direction, maxDepthFromOrigin, tIntersect );
 						if( tIntersect.size() > 0 )
 						{
-							hits.push_back( itr->second );
+							hits.push_back( *itr );
 						}
 					}
 				}
@@ -186,13 +537,10 @@ namespace Kiwi
 	void EntityManager::ShutdownWithName(std::wstring name)
 	{
 
-		auto it = m_entities.find(name);
-		if(it != m_entities.end())
+		Kiwi::Entity* entity = this->FindWithName( name );
+		if( entity != 0 )
 		{
-			if( it->second != 0 )
-			{
-				it->second->Shutdown();
-			}
+			entity->Shutdown();
 		}
 
 	}
@@ -200,12 +548,12 @@ namespace Kiwi
 	void EntityManager::ShutdownAll()
 	{
 
-		auto it = m_entities.begin();
-		for(; it != m_entities.end(); it++)
+		//index based, shutting down an entity may add entities to the list
+		for( unsigned int i = 0; i < m_entities.size(); i++ )
 		{
-			if( it->second != 0 )
+			if( m_entities[i] != 0 )
 			{
-				it->second->Shutdown();
+				m_entities[i]->Shutdown();
 			}
 		}
 
@@ -214,12 +562,11 @@ namespace Kiwi
 	void EntityManager::ShutdownInactive()
 	{
 
-		auto inactiveIt = m_entities.begin();
-		for(; inactiveIt != m_entities.end();)
+		for( unsigned int i = 0; i < m_entities.size(); i++ )
 		{
-			if( inactiveIt->second != 0 && !inactiveIt->second->IsActive() )
+			if( m_entities[i] != 0 && !m_entities[i]->IsActive() )
 			{
-				inactiveIt->second->Shutdown();
+				m_entities[i]->Shutdown();
 			}
 		}
 
@@ -228,28 +575,136 @@ namespace Kiwi
 	void EntityManager::DestroyAllShutdown()
 	{
 
-		auto itr = m_entities.begin();
-		for( ; itr != m_entities.end(); )
+		//every shutdown entity is in the pending list
+		m_destroyBatch.clear();
+		m_destroyBatch.swap( m_pendingDestroy );
+
+		this->_DestroyBatch();
+
+	}
+
+	void EntityManager::DestroyPending()
+	{
+
+		KIWI_PROFILE_ZONE( "EntityManager::DestroyPending" );
+
+		//entities that stop matching a query are removed from its list in one pass below
+		m_deferIndexRemoval = true;
+
+		//remove shutdown components from entities that are still alive
+		for( unsigned int i = 0; i < m_pendingComponentCleanup.size(); i++ )
 		{
-			if( itr->second != 0 && itr->second->IsShutdown() )
+			Kiwi::Entity* entity = m_pendingComponentCleanup[i];
+			entity->m_componentCleanupQueued = false;
+			if( entity->IsShutdown() == false )
 			{
-				SAFE_DELETE( itr->second );
-				itr = m_entities.erase( itr );
+				entity->_RemoveShutdownComponents();
+			}
+		}
+		m_pendingComponentCleanup.clear();
+
+		m_deferIndexRemoval = false;
+		this->_CompactIndexes();
+
+		m_destroyBatch.clear();
+		for( unsigned int i = 0; i < m_pendingDestroy.size(); )
+		{
+			Kiwi::Entity* entity = m_pendingDestroy[i];
+
+			//a shutdown child is referenced by its parent until it is detached
+			if( entity->GetReferenceCount() > 0 && entity->m_parent != 0 && entity->m_parent->IsShutdown() == false )
+			{
+				entity->m_parent->DetachChild( entity );
+			}
+
+			if( entity->GetReferenceCount() == 0 )
+			{
+				//order doesn't matter, move the last entry into this position and don't advance
+				m_pendingDestroy[i] = m_pendingDestroy.back();
+				m_pendingDestroy.pop_back();
+
+				m_destroyBatch.push_back( entity );
 				continue;
 			}
-			itr++;
+
+			i++;
 		}
 
+		this->_DestroyBatch();
+
+	}
+
+	void EntityManager::_DestroyBatch()
+	{
+
+		//unlink all entities first, then compact each affected list once, then delete the entities
+		m_deferIndexRemoval = true;
+		for( unsigned int i = 0; i < m_destroyBatch.size(); )
+		{
+			Kiwi::Entity* entity = m_destroyBatch[i];
+			if( this->GetEntity( entity->m_handle ) != entity || entity->m_destroying )
+			{
+				//already destroyed, or queued twice
+				m_destroyBatch[i] = m_destroyBatch.back();
+				m_destroyBatch.pop_back();
+				continue;
+			}
+
+			this->_UnlinkEntity( entity );
+			i++;
+		}
+		m_deferIndexRemoval = false;
+		this->_CompactIndexes();
+
+		for( unsigned int i = 0; i < m_destroyBatch.size(); i++ )
+		{
+			Kiwi::Entity* entity = m_destroyBatch[i];
+			this->_DestroyEntity( m_slots[entity->m_handle.GetIndex()].denseIndex );
+		}
+		m_destroyBatch.clear();
+
+	}
+
+	void EntityManager::_QueueDestroy( Kiwi::Entity* entity )
+	{
+
+		if( entity != 0 && this->GetEntity( entity->m_handle ) == entity )
+		{
+			std::lock_guard<std::mutex> lock( m_pendingMutex );
+			m_pendingDestroy.push_back( entity );
+		}
+
+	}
+
+	void EntityManager::_QueueComponentCleanup( Kiwi::Entity* entity )
+	{
+
+		if( entity != 0 )
+		{
+			std::lock_guard<std::mutex> lock( m_pendingMutex );
+			m_pendingComponentCleanup.push_back( entity );
+		}
+
+	}
+
+	Kiwi::Entity* EntityManager::FindWithName( Kiwi::StringId name )
+	{
+
+		//INVALID is not a string, don't let it match an unnamed entity
+		if( name == Kiwi::StringTable::INVALID ) return 0;
+
+		return this->FindWithName( Kiwi::StringTable::GetString( name ) );
+
 	}
 
 	Kiwi::Entity* EntityManager::FindWithName(std::wstring name)
 	{
 
-		auto it = m_entities.find(name);
-		if(it != m_entities.end())
+		auto it = m_nameIndex.find(name);
+		if(it != m_nameIndex.end())
 		{
 			//found it
-			return it->second;
+			return this->GetEntity( it->second );
 		}
 
 		return 0;
@@ -259,17 +714,244 @@ namespace Kiwi
 	std::vector<Kiwi::Entity*> EntityManager::FindAllWithTag(std::wstring tag)
 	{
 
-		std::vector<Kiwi::Entity*> matches;
+		return this->FindAllWithTag( Kiwi::StringTable::Find( tag ) );
+
+	}
+
+	std::vector<Kiwi::Entity*> EntityManager::FindAllWithTag( Kiwi::StringId tag )
+	{
+
+		const Kiwi::EntityList* members = this->GetEntitiesWithTag( tag );
+		if( members != 0 )
+		{
+			return *members;
+		}
+
+		return std::vector<Kiwi::Entity*>();
+
+	}
+
+	const Kiwi::EntityList* EntityManager::GetEntitiesWithTag( Kiwi::StringId tag )const
+	{
+
+		unsigned int tagIndex = Kiwi::TagTable::Find( tag );
+		if( tagIndex < m_tagIndex.size() )
+		{
+			return &m_tagIndex[tagIndex];
+		}
+
+		return 0;
+
+	}
+
+	const Kiwi::EntityList* EntityManager::_GetQueryMatches( Kiwi::ComponentMask mask )
+	{
+
+		auto queryItr = m_queryIndex.find( mask );
+		if( queryItr != m_queryIndex.end() )
+		{
+			return &m_queries[queryItr->second]->matches;
+		}
+
+		if( mask == 0 )
+		{
+			throw Kiwi::Exception( L"EntityManager::Query", L"Query contains a component type without a lookup slot (more than " + Kiwi::ToWString( KIWI_MAX_COMPONENT_TYPES ) + L" component types are in use)" );
+		}
+
+		if( m_queries.size() >= KIWI_MAX_ENTITY_QUERIES )
+		{
+			throw Kiwi::Exception( L"EntityManager::Query", L"Maximum number of queries reached" );
+		}
+
+		unsigned int queryIndex = (unsigned int)m_queries.size();
+		unsigned long long queryBit = (unsigned long long)1 << queryIndex;
+
+		ComponentQuery* query = new ComponentQuery();
+		query->mask = mask;
+
+		//walk all entities once to build the initial match list
+		for( unsigned int i = 0; i < m_entities.size(); i++ )
+		{
+			if( m_entities[i] != 0 && m_entities[i]->_MatchesComponents( mask ) )
+			{
+				query->matches.push_back( m_entities[i] );
+				m_entities[i]->m_queryMembership |= queryBit;
+			}
+		}
+
+		m_queries.push_back( query );
+		m_queryIndex.insert( std::make_pair( mask, queryIndex ) );
+
+		return &query->matches;
+
+	}
+
+	void EntityManager::_UpdateQueryMembership( Kiwi::Entity* entity )
+	{
+
+		assert( Kiwi::EntityUpdateContext::Current == 0 );
+
+		//an entity that is being destroyed stays out of the lists
+		if( entity->m_destroying ) return;
 
-		for(auto entity : m_entities)
+		for( unsigned int queryIndex = 0; queryIndex < m_queries.size(); queryIndex++ )
 		{
-			if( entity.second != 0 && entity.second->HasTag(tag))
+			ComponentQuery* query = m_queries[queryIndex];
+			unsigned long long queryBit = (unsigned long long)1 << queryIndex;
+
+			bool matches = entity->_MatchesComponents( query->mask );
+			bool wasMatching = (entity->m_queryMembership & queryBit) != 0;
+
+			if( matches && !wasMatching )
+			{
+				if( (m_staleQueries & queryBit) != 0 )
+				{
+					//the entity may still be in the list from an earlier removal
+					this->_CompactIndexes();
+				}
+				query->matches.push_back( entity );
+				entity->m_queryMembership |= queryBit;
+
+			} else if( !matches && wasMatching )
 			{
-				matches.push_back(entity.second);
+				//the entity is left in the list until it is compacted, which keeps the order of the list stable
+				entity->m_queryMembership &= ~queryBit;
+				m_staleQueries |= queryBit;
 			}
 		}
 
-		return matches;
+		if( !m_deferIndexRemoval && m_staleQueries != 0 )
+		{
+			this->_CompactIndexes();
+		}
+
+	}
+
+	void EntityManager::_RemoveFromQueries( Kiwi::Entity* entity )
+	{
+
+		//the entity is left in the lists until they are compacted
+		m_staleQueries |= entity->m_queryMembership;
+		entity->m_queryMembership = 0;
+
+		if( !m_deferIndexRemoval && m_staleQueries != 0 )
+		{
+			this->_CompactIndexes();
+		}
+
+	}
+
+	void EntityManager::_CompactIndexes()
+	{
+
+		//one pass over each list that had entities removed from it, the remaining entities keep their order
+		for( unsigned int queryIndex = 0; m_staleQueries != 0 && queryIndex < m_queries.size(); queryIndex++ )
+		{
+			unsigned long long queryBit = (unsigned long long)1 << queryIndex;
+			if( (m_staleQueries & queryBit) != 0 )
+			{
+				Kiwi::EntityList& matches = m_queries[queryIndex]->matches;
+				matches.erase( std::remove_if( matches.begin(), matches.end(),
+											   [queryBit]( const Kiwi::Entity* entity ) { return (entity->m_queryMembership & queryBit) == 0; } ),
+							   matches.end() );
+				m_staleQueries &= ~queryBit;
+			}
+		}
+		m_staleQueries = 0;
+
+		for( unsigned int tagIndex = 0; m_staleTags != 0 && tagIndex < m_tagIndex.size(); tagIndex++ )
+		{
+			Kiwi::TagMask tagBit = (Kiwi::TagMask)1 << tagIndex;
+			if( (m_staleTags & tagBit) != 0 )
+			{
+				Kiwi::EntityList& members = m_tagIndex[tagIndex];
+				members.erase( std::remove_if( members.begin(), members.end(),
+											   [tagBit]( const Kiwi::Entity* entity ) { return entity->m_destroying || (entity->GetTagMask() & tagBit) == 0; } ),
+							   members.end() );
+				m_staleTags &= ~tagBit;
+			}
+		}
+		m_staleTags = 0;
+
+	}
+
+	void EntityManager::_UnlinkEntity( Kiwi::Entity* entity )
+	{
+
+		if( entity->m_destroying ) return;
+
+		entity->m_destroying = true;
+
+		this->_RemoveFromTagIndex( entity, entity->GetTagMask() );
+		this->_RemoveFromQueries( entity );
+
+	}
+
+	void EntityManager::_AddToTagIndex( Kiwi::Entity* entity, Kiwi::TagMask tags )
+	{
+
+		assert( Kiwi::EntityUpdateContext::Current == 0 );
+
+		if( entity->m_destroying ) return;
+
+		if( (m_staleTags & tags) != 0 )
+		{
+			//the entity may still be in a list from an earlier removal
+			this->_CompactIndexes();
+		}
+
+		for( unsigned int tagIndex = 0; tags != 0; tagIndex++, tags >>= 1 )
+		{
+			if( (tags & 1) != 0 )
+			{
+				if( m_tagIndex.size() <= tagIndex )
+				{
+					m_tagIndex.resize( tagIndex + 1 );
+				}
+				m_tagIndex[tagIndex].push_back( entity );
+			}
+		}
+
+	}
+
+	void EntityManager::_RemoveFromTagIndex( Kiwi::Entity* entity, Kiwi::TagMask tags )
+	{
+
+		assert( Kiwi::EntityUpdateContext::Current == 0 );
+
+		//the entity is left in the lists until they are compacted, the entity's tags no longer contain 'tags'
+		//unless it is being destroyed
+		m_staleTags |= tags;
+
+		if( !m_deferIndexRemoval && m_staleTags != 0 )
+		{
+			this->_CompactIndexes();
+		}
+
+	}
+
+	Kiwi::Entity* EntityManager::GetEntity( Kiwi::EntityHandle handle )const
+	{
+
+		if( this->IsValid( handle ) )
+		{
+			return m_entities[m_slots[handle.GetIndex()].denseIndex];
+		}
+
+		return 0;
+
+	}
+
+	bool EntityManager::IsValid( Kiwi::EntityHandle handle )const
+	{
+
+		if( handle.IsNull() || handle.GetIndex() >= m_slots.size() )
+		{
+			return false;
+		}
+
+		const EntitySlot& slot = m_slots[handle.GetIndex()];
+		return slot.denseIndex != INVALID_INDEX && slot.generation == handle.GetGeneration();
 
 	}
 
@@ -2,10 +2,22 @@
 #define _KIWI_ENTITYMANAGER_H_
 
 #include "Entity.h"
+#include "EntityHandle.h"
+#include "EntityQuery.h"
+#include "EntityUpdateContext.h"
+#include "JobSystem.h"
 
 #include <unordered_map>
 #include <vector>
 #include <string>
+#include <mutex>
+#include <atomic>
+
+//parallel updates fall back to a serial update when there are fewer root entities than this
+#define KIWI_PARALLEL_UPDATE_MIN_ROOTS 64
+
+//number of root entities a worker takes at a time when load balancing a parallel update
+#define KIWI_PARALLEL_UPDATE_BATCH_SIZE 32
 
 namespace Kiwi
 {
@@ -16,6 +28,7 @@ namespace Kiwi
 
 	class EntityManager
 	{
+	friend class Entity;
 	private:
 
 		struct LightMap
@@ -24,18 +37,128 @@ namespace Kiwi
 			std::unordered_multimap<std::wstring, std::vector<Kiwi::Entity*>> map;
 		};
 
+		struct EntitySlot
+		{
+			unsigned int denseIndex; //index of the entity in m_entities, or INVALID_INDEX if the slot is free
+			unsigned int generation;
+		};
+
+		struct ComponentQuery
+		{
+			Kiwi::ComponentMask mask; //component types an entity must have to match
+			Kiwi::EntityList matches;
+		};
+
+		static const unsigned int INVALID_INDEX = 0xFFFFFFFF;
+
 	protected:
 
 		Kiwi::Scene* m_scene;
 
-		/*stores the active entities (these are updated every frame)*/
-		EntityMap m_entities;
+		/*stores the active entities (these are updated every frame)
+		the list is kept packed: removing an entity moves the last entity into its place*/
+		EntityList m_entities;
+
+		/*slot map indexed by EntityHandle::GetIndex()*/
+		std::vector<EntitySlot> m_slots;
+		std::vector<unsigned int> m_freeSlots;
+
+		/*secondary index used for name lookups, keyed by the name itself so that unique names (e.g. spawned entities)
+		are erased with their entity instead of staying in the global string table*/
+		std::unordered_multimap<std::wstring, Kiwi::EntityHandle> m_nameIndex;
+
+		/*entities that have each tag, indexed by tag index (see TagTable)*/
+		std::vector<Kiwi::EntityList> m_tagIndex;
+
+		/*shutdown entities waiting to be destroyed once their reference count reaches zero*/
+		EntityList m_pendingDestroy;
+
+		/*entities DestroyPending destroys in the current pass*/
+		EntityList m_destroyBatch;
+
+		/*while true, entities removed from query and tag lists are left in them until _CompactIndexes is called,
+		so removing many entities costs one pass over each affected list instead of one search per entity*/
+		bool m_deferIndexRemoval;
+
+		/*bits of the queries and tags whose lists still hold removed entities*/
+		unsigned long long m_staleQueries;
+		Kiwi::TagMask m_staleTags;
+
+		/*entities with shutdown components waiting to be removed*/
+		EntityList m_pendingComponentCleanup;
+
+		/*cached match lists of every query that has been run, the bit index of a query
+		in Entity::m_queryMembership is its index in m_queries*/
+		std::vector<ComponentQuery*> m_queries;
+		std::unordered_map<Kiwi::ComponentMask, unsigned int> m_queryIndex;
 
 		//stores all of the lights active in the scene
 		LightMap m_lights;
 
 		Kiwi::RenderQueue* m_renderQueue;
 
+		/*number of jobs root entities are split across by the parallel update, 1 if entities are updated on the calling thread only*/
+		unsigned int m_updateThreadCount;
+
+		/*if true each thread updates a fixed range of root entities and the side effects are sorted afterwards*/
+		bool m_deterministicUpdate;
+
+		/*root entities being updated by the current parallel update, in entity list order*/
+		EntityList m_updateRoots;
+
+		/*one context per update job, and the next root to hand out when load balancing*/
+		std::vector<Kiwi::EntityUpdateContext> m_updateContexts;
+		std::atomic<unsigned int> m_nextUpdateRoot;
+
+		/*deferred main-thread updates of all workers, merged in root order*/
+		std::vector<Kiwi::EntityUpdateContext::DeferredUpdate> m_deferredUpdates;
+
+		/*guards the pending destroy/cleanup queues, entities can be shut down from worker threads*/
+		std::mutex m_pendingMutex;
+
+	protected:
+
+		/*updates the root entities in jobs on the engine's job system, then runs the deferred main-thread updates*/
+		void _UpdateParallel( bool fixedUpdate );
+
+		/*body of each of the parallel update's jobs*/
+		void _UpdateWorker( unsigned int workerIndex, bool fixedUpdate );
+
+		/*assigns a slot and handle to the entity and adds it to the entity list*/
+		void _InsertEntity( Kiwi::Entity* entity );
+
+		/*removes the entity at the given index of the entity list, frees its slot and deletes it*/
+		void _DestroyEntity( unsigned int denseIndex );
+
+		/*queues a shutdown entity to be destroyed by DestroyPending*/
+		void _QueueDestroy( Kiwi::Entity* entity );
+
+		/*queues an entity whose shutdown components should be removed by DestroyPending*/
+		void _QueueComponentCleanup( Kiwi::Entity* entity );
+
+		/*adds/removes the entity to/from the tag index lists of each tag in the mask*/
+		void _AddToTagIndex( Kiwi::Entity* entity, Kiwi::TagMask tags );
+		void _RemoveFromTagIndex( Kiwi::Entity* entity, Kiwi::TagMask tags );
+
+		/*returns the match list of the query for the component mask, creating it if needed*/
+		const Kiwi::EntityList* _GetQueryMatches( Kiwi::ComponentMask mask );
+
+		/*adds/removes the entity to/from each query's match list after its components have changed*/
+		void _UpdateQueryMembership( Kiwi::Entity* entity );
+
+		/*removes the entity from every query it matches*/
+		void _RemoveFromQueries( Kiwi::Entity* entity );
+
+		/*removes the entities that were removed from query and tag lists from those lists, keeping the order of the rest
+		called right away unless m_deferIndexRemoval is set*/
+		void _CompactIndexes();
+
+		/*marks the entity as being destroyed and removes it from the query and tag lists*/
+		void _UnlinkEntity( Kiwi::Entity* entity );
+
+		/*destroys the shutdown entities in m_destroyBatch, compacting the query and tag lists once for all of them*/
+		void _DestroyBatch();
+
 	public:
 
 		EntityManager( Kiwi::Scene& scene );
@@ -44,12 +167,33 @@ namespace Kiwi
 		void Update();
 		void FixedUpdate();
 
+		/*enables updating independent root entities (and their children) in 'threadCount' jobs on the engine's job system,
+		the calling thread runs jobs too until all of them are done. at most the job system's worker count + 1 of the jobs
+		run at the same time. a threadCount of 0 or 1 returns to updating every entity on the calling thread
+
+		while updating in parallel, entities and components run concurrently with other root entities and must only change
+		their own entity tree. reading other entities' world transforms returns the values from the last hierarchy update.
+		entities and components that create, destroy or attach objects, change tags or touch graphics resources must be
+		flagged with SetMainThreadOnly(true); they are updated on the calling thread after the parallel part, in entity order
+
+		if 'deterministic' is true each thread updates a fixed range of root entities and the shared lists written during
+		the update (pending destroys, transform changes) are sorted afterwards, so the result of a frame does not depend
+		on the number of threads or on timing*/
+		void SetParallelUpdate( unsigned int threadCount, bool deterministic = false );
+
+		/*returns the number of threads Update and FixedUpdate run on*/
+		unsigned int GetUpdateThreadCount()const { return m_updateThreadCount; }
+		bool IsDeterministicUpdate()const { return m_deterministicUpdate; }
+
 		/*generates a new render queue based on the entities currently managed by the entity manager*/
 		Kiwi::RenderQueue* GenerateRenderQueue();
 
 		/*clears the render queue and all it's render groups so that it contains no entities*/
 		void ClearRenderQueue();
 
+		/*returns the render queue filled by the last call to GenerateRenderQueue*/
+		Kiwi::RenderQueue* GetRenderQueue()const { return m_renderQueue; }
+
 		/*attempts to add the entity to the entity pool
 		if destroyExisting is true, and an entity with the same name already exists, that entity
 		will be destroyed and the new entity will be added
@@ -64,13 +208,43 @@ namespace Kiwi
 		void ShutdownAll();
 		void ShutdownInactive();
 
-		/*immediately destroys all entities that have been shutdown*/
+		/*destroys the queued shutdown entities that are no longer referenced and removes queued shutdown components
+		called once per frame from Update, the cost depends only on the number of objects that were shut down*/
+		void DestroyPending();
+
+		/*returns true if the next DestroyPending will destroy entities or components*/
+		bool HasPendingDestroy()const { return m_pendingDestroy.size() > 0 || m_pendingComponentCleanup.size() > 0; }
+
+		/*immediately destroys all entities that have been shutdown, even if they are still referenced*/
 		void DestroyAllShutdown();
 
+		Kiwi::Entity* FindWithName( Kiwi::StringId name );
 		Kiwi::Entity* FindWithName(std::wstring name);
+		std::vector<Kiwi::Entity*> FindAllWithTag( Kiwi::StringId tag );
 		std::vector<Kiwi::Entity*> FindAllWithTag(std::wstring tag);
 
-		const EntityMap* GetEntityMap()const { return &m_entities; }
+		/*returns the list of entities that have the tag, or 0 if no entity has ever had the tag
+		the list is owned by the entity manager and changes as tags are added and removed*/
+		const Kiwi::EntityList* GetEntitiesWithTag( Kiwi::StringId tag )const;
+
+		/*returns the entity the handle refers to, or 0 if the entity has been destroyed or the handle is invalid*/
+		Kiwi::Entity* GetEntity( Kiwi::EntityHandle handle )const;
+
+		/*returns true if the handle refers to an entity that still exists*/
+		bool IsValid( Kiwi::EntityHandle handle )const;
+
+		unsigned int GetEntityCount()const { return (unsigned int)m_entities.size(); }
+
+		/*returns the entities that have all of the given component types, e.g. Query<Kiwi::Transform, Kiwi::Rigidbody>()
+		the first query for a combination of types walks every entity once, after that the match list is
+		updated as components are attached and detached*/
+		template<class... ComponentClasses>
+		Kiwi::EntityQuery<ComponentClasses...> Query()
+		{
+			return Kiwi::EntityQuery<ComponentClasses...>( this->_GetQueryMatches( Kiwi::EntityQuery<ComponentClasses...>::GetMask() ) );
+		}
+
+		const EntityList* GetEntities()const { return &m_entities; }
 
 	};
 };
@@ -0,0 +1,71 @@
+#ifndef _KIWI_ENTITYQUERY_H_
+#define _KIWI_ENTITYQUERY_H_
+
+#include "Entity.h"
+#include "ComponentType.h"
+
+//maximum number of distinct queries (component combinations) an entity manager keeps match lists for
+#define KIWI_MAX_ENTITY_QUERIES 64
+
+namespace Kiwi
+{
+
+	/*result of EntityManager::Query/Scene::Query: the entities that have all of the given component types
+	the match list is owned and kept up to date by the entity manager, so a query is cheap to copy and
+	holding one across frames always sees the current set of entities
+	entities appear in the order they started matching, which does not change between frames*/
+	template<class... ComponentClasses>
+	class EntityQuery
+	{
+	static_assert( sizeof...(ComponentClasses) > 0, "EntityQuery requires at least one component type" );
+	protected:
+
+		const Kiwi::EntityList* m_matches;
+
+	public:
+
+		EntityQuery( const Kiwi::EntityList* matches ) { m_matches = matches; }
+
+		/*calls function( Kiwi::Entity*, ComponentClasses*... ) for each matching entity that has not been shut down
+		attaching or detaching components during the loop takes effect immediately*/
+		template<class Function>
+		void ForEach( Function function )const
+		{
+
+			//index based, the list can change if the callback attaches or detaches components
+			for( unsigned int i = 0; i < m_matches->size(); i++ )
+			{
+				Kiwi::Entity* entity = (*m_matches)[i];
+				if( entity->IsShutdown() == false )
+				{
+					function( entity, entity->FindComponent<ComponentClasses>()... );
+				}
+			}
+
+		}
+
+		const Kiwi::EntityList* GetEntities()const { return m_matches; }
+		unsigned int GetCount()const { return (unsigned int)m_matches->size(); }
+
+		/*returns the mask of the component types the query matches*/
+		static Kiwi::ComponentMask GetMask()
+		{
+			Kiwi::ComponentMask masks[] = { Kiwi::ComponentType<ComponentClasses>::Mask()... };
+			Kiwi::ComponentMask mask = 0;
+			for( unsigned int i = 0; i < sizeof( masks ) / sizeof( masks[0] ); i++ )
+			{
+				if( masks[i] == 0 )
+				{
+					//the type did not get a lookup slot, it can't be used in a query
+					return 0;
+				}
+				mask |= masks[i];
+			}
+			return mask;
+		}
+
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef _KIWI_ENTITYUPDATECONTEXT_H_
+#define _KIWI_ENTITYUPDATECONTEXT_H_
+
+#include <vector>
+
+namespace Kiwi
+{
+
+	class Entity;
+
+	/*state of a worker thread during EntityManager's parallel update
+	entities and components that are flagged as main-thread-only are not updated on the worker, they are
+	recorded here and updated on the main thread once the parallel part of the update has finished*/
+	struct EntityUpdateContext
+	{
+		struct DeferredUpdate
+		{
+			unsigned int rootIndex; //index of the root entity whose update deferred the entity
+			Kiwi::Entity* entity;
+			bool componentsOnly; //true to only run the entity's main-thread-only components, false to run the whole entity update
+		};
+
+		//index of the root entity currently being updated
+		unsigned int rootIndex;
+
+		std::vector<DeferredUpdate> deferred;
+
+		/*the context of the calling thread, 0 unless the thread is running a parallel entity update*/
+		static thread_local Kiwi::EntityUpdateContext* Current;
+
+		void Defer( Kiwi::Entity* entity, bool componentsOnly )
+		{
+			DeferredUpdate update = { rootIndex, entity, componentsOnly };
+			deferred.push_back( update );
+		}
+	};
+}
+
+#endif
\ No newline at end of file
@@ -3,91 +3,367 @@
 
 #include "Utilities.h"
 #include "Assert.h"
+#include "EventQueue.h"
 
 #include <vector>
 #include <algorithm>
-#include <Windows.h>
+#include <mutex>
 
 namespace Kiwi
 {
 
+	template<class ListenerType, class EventType>
+	class DeferredEventQueue;
+
+	/*sends events to a list of listeners
+
+	the listener list is never resized while it is iterated: removed listeners are cleared in place and added listeners are
+	staged, both changes are applied at the start of the next dispatch. listeners added during a dispatch don't receive the
+	event being dispatched, listeners removed during a dispatch don't receive it anymore
+
+	a deferred broadcaster copies its events into a queue shared by every broadcaster of the same event type instead of sending
+	them right away. the queues are dispatched in batches at fixed points of the frame (see Kiwi::EventQueues). events that
+	point at data which only lives during the broadcast (like Kiwi::TransformChangeEvent) must not be deferred*/
 	template<class ListenerType, class EventType>
 	class EventBroadcaster
 	{
+	friend class Kiwi::DeferredEventQueue<ListenerType, EventType>;
 	private:
 
-		//stores all of the registered listeners
+		//stores all of the registered listeners, removed listeners are 0 until the next dispatch
 		std::vector<ListenerType*> m_listeners;
 
+		//listeners added since the last dispatch
+		std::vector<ListenerType*> m_addedListeners;
+
 		//pointer to the callback function that should be called for each listener
 		void (ListenerType::*m_eventCallback)(const EventType&);
 
-	protected:
+		unsigned int m_listenerCount;
+
+		//the number of dispatches currently running, listener changes are only applied when it is 0
+		unsigned int m_dispatchDepth;
+
+		bool m_listenersChanged;
+
+		bool m_deferred;
+		Kiwi::EVENT_PHASE m_phase;
 
-		//void _BroadcastEvent( const EventType& evt )
-		//{
-		//	//send the event to the callback function of each listener
-		//	auto it = m_listeners.begin();
-		//	while( it != m_listeners.end() )
-		//	{
-		//		if( (*it) == 0 )
-		//		{
-		//			it = m_listeners.erase( it );
-		//		} else
-		//		{
-		//			((*it)->*m_eventCallback)(evt);
-		//			it++;
-		//		}
-		//	}
-		//}
+		//events of this broadcaster waiting in the deferred queues, guarded by the queue's mutex
+		unsigned int m_queuedEvents;
+
+	private:
+
+		void _ApplyListenerChanges()
+		{
+
+			if( m_listenersChanged == false ) return;
+
+			m_listeners.erase( std::remove( m_listeners.begin(), m_listeners.end(), (ListenerType*)0 ), m_listeners.end() );
+			m_listeners.insert( m_listeners.end(), m_addedListeners.begin(), m_addedListeners.end() );
+			m_addedListeners.clear();
+
+			m_listenersChanged = false;
+
+		}
+
+		/*sends the event to the callback function of each listener*/
+		void _Dispatch( const EventType& evt )
+		{
+
+			if( m_dispatchDepth == 0 )
+			{
+				this->_ApplyListenerChanges();
+			}
+
+			m_dispatchDepth++;
+
+			try
+			{
+				//added listeners go to m_addedListeners so the size can't change here
+				for( size_t i = 0; i < m_listeners.size(); i++ )
+				{
+					ListenerType* listener = m_listeners[i];
+					if( listener )
+					{
+						(listener->*m_eventCallback)(evt);
+					}
+				}
+
+			} catch( ... )
+			{
+				m_dispatchDepth--;
+				throw;
+			}
+
+			m_dispatchDepth--;
+
+		}
 
 	public:
 
 		EventBroadcaster(void (ListenerType :: *eventCallback)(const EventType&)) 
 		{ 
 			m_eventCallback = eventCallback; 
+			m_listenerCount = 0;
+			m_dispatchDepth = 0;
+			m_listenersChanged = false;
+			m_deferred = false;
+			m_phase = EVENT_PHASE_UPDATE;
+			m_queuedEvents = 0;
 		}
 
 		virtual ~EventBroadcaster()
 		{
+			if( m_queuedEvents > 0 )
+			{
+				//the queued events would be dispatched to a deleted broadcaster
+				for( unsigned int phase = 0; phase < EVENT_PHASE_COUNT; phase++ )
+				{
+					Kiwi::DeferredEventQueue<ListenerType, EventType>::Get( (Kiwi::EVENT_PHASE)phase ).Purge( this );
+				}
+			}
+
 			Kiwi::FreeMemory(m_listeners);
+			Kiwi::FreeMemory(m_addedListeners);
 		}
 
+		/*the listener receives events from the next dispatch on*/
 		virtual void AddListener(ListenerType* listener) 
 		{ 
 
-			if(listener) m_listeners.push_back(listener); 
+			if(listener)
+			{
+				m_addedListeners.push_back( listener );
+				m_listenersChanged = true;
+				m_listenerCount++;
+			}
 		}
 
+		/*the listener doesn't receive any more events, even if the broadcaster is currently dispatching*/
 		virtual void RemoveListener(ListenerType* listener) 
 		{ 
 
 			if(listener)
 			{
-				m_listeners.erase( std::remove(m_listeners.begin(), m_listeners.end(), listener), m_listeners.end());
+				for( size_t i = 0; i < m_listeners.size(); i++ )
+				{
+					if( m_listeners[i] == listener )
+					{
+						m_listeners[i] = 0;
+						m_listenerCount--;
+						m_listenersChanged = true;
+					}
+				}
+
+				size_t added = m_addedListeners.size();
+				m_addedListeners.erase( std::remove( m_addedListeners.begin(), m_addedListeners.end(), listener ), m_addedListeners.end() );
+				m_listenerCount -= (unsigned int)(added - m_addedListeners.size());
 			}
 		}
 
 		virtual void RemoveAllListeners()
 		{
-			Kiwi::FreeMemory( m_listeners );
+			if( m_dispatchDepth == 0 )
+			{
+				Kiwi::FreeMemory( m_listeners );
+
+			} else
+			{
+				std::fill( m_listeners.begin(), m_listeners.end(), (ListenerType*)0 );
+				m_listenersChanged = true;
+			}
+
+			Kiwi::FreeMemory( m_addedListeners );
+			m_listenerCount = 0;
+		}
+
+		unsigned int GetListenerCount()const { return m_listenerCount; }
+
+		/*while deferred, broadcast events are queued and sent to the listeners when the queues of the phase are dispatched
+		events that were queued before the broadcaster stops deferring are still dispatched with their phase*/
+		void SetDeferred( bool deferred, Kiwi::EVENT_PHASE phase = EVENT_PHASE_UPDATE )
+		{
+			assert( phase < EVENT_PHASE_COUNT );
+
+			m_deferred = deferred;
+			m_phase = phase;
 		}
 
+		bool IsDeferred()const { return m_deferred; }
+		Kiwi::EVENT_PHASE GetDeferredPhase()const { return m_phase; }
+
 		virtual void BroadcastEvent(const EventType& evt)
 		{
-			//send the event to the callback function of each listener
-			auto it = m_listeners.begin();
-			while( it != m_listeners.end() )
+			if( m_deferred )
+			{
+				Kiwi::DeferredEventQueue<ListenerType, EventType>::Get( m_phase ).Push( this, evt );
+
+			} else
+			{
+				this->_Dispatch( evt );
+			}
+		}
+
+	};
+
+	/*ring buffer of the deferred events of one event type and phase, grows when it is full
+	broadcasting into the queue is thread safe, dispatching happens on the thread calling Kiwi::EventQueues::Dispatch*/
+	template<class ListenerType, class EventType>
+	class DeferredEventQueue :
+		public Kiwi::IEventQueue
+	{
+	protected:
+
+		typedef Kiwi::EventBroadcaster<ListenerType, EventType> Broadcaster;
+
+		struct Entry
+		{
+			//0 if the broadcaster was deleted while the event was queued
+			Broadcaster* broadcaster;
+			EventType event;
+
+			Entry( Broadcaster* b, const EventType& e ) : broadcaster( b ), event( e ) {}
+		};
+
+		std::mutex m_mutex;
+
+		//the size of the ring is always a power of two
+		std::vector<Entry> m_ring;
+		unsigned int m_head;
+		unsigned int m_count;
+
+	protected:
+
+		DeferredEventQueue()
+		{
+			m_head = 0;
+			m_count = 0;
+		}
+
+		void _Grow( const Entry& entry )
+		{
+
+			std::vector<Entry> ring;
+			ring.reserve( (m_ring.size() == 0) ? 16 : m_ring.size() * 2 );
+
+			for( unsigned int i = 0; i < m_count; i++ )
 			{
-				if( (*it) == 0 )
+				ring.push_back( m_ring[(m_head + i) & (m_ring.size() - 1)] );
+			}
+
+			//the unused slots only need to hold something, they are overwritten when they are pushed to
+			ring.resize( ring.capacity(), entry );
+
+			m_ring.swap( ring );
+			m_head = 0;
+
+		}
+
+	public:
+
+		/*the queue of the event type for the phase, the queues of each phase are registered when this is first called*/
+		static DeferredEventQueue& Get( Kiwi::EVENT_PHASE phase )
+		{
+
+			struct Queues
+			{
+				DeferredEventQueue queue[EVENT_PHASE_COUNT];
+
+				Queues()
 				{
-					it = m_listeners.erase( it );
-				} else
+					for( unsigned int i = 0; i < EVENT_PHASE_COUNT; i++ )
+					{
+						Kiwi::EventQueues::Register( &queue[i], (Kiwi::EVENT_PHASE)i );
+					}
+				}
+			};
+
+			static Queues queues;
+			return queues.queue[phase];
+
+		}
+
+		void Push( Broadcaster* broadcaster, const EventType& evt )
+		{
+
+			std::lock_guard<std::mutex> lock( m_mutex );
+
+			Entry entry( broadcaster, evt );
+			if( m_count == m_ring.size() )
+			{
+				this->_Grow( entry );
+			}
+
+			m_ring[(m_head + m_count) & (m_ring.size() - 1)] = entry;
+			m_count++;
+
+			broadcaster->m_queuedEvents++;
+
+		}
+
+		/*removes the broadcaster's events from the queue*/
+		void Purge( Broadcaster* broadcaster )
+		{
+
+			std::lock_guard<std::mutex> lock( m_mutex );
+
+			for( unsigned int i = 0; i < m_count; i++ )
+			{
+				Entry& entry = m_ring[(m_head + i) & (m_ring.size() - 1)];
+				if( entry.broadcaster == broadcaster )
+				{
+					entry.broadcaster = 0;
+					broadcaster->m_queuedEvents--;
+				}
+			}
+
+		}
+
+		unsigned int GetQueuedEventCount()
+		{
+
+			std::lock_guard<std::mutex> lock( m_mutex );
+			return m_count;
+
+		}
+
+		unsigned int Dispatch()
+		{
+
+			unsigned int count = 0;
+			{
+				std::lock_guard<std::mutex> lock( m_mutex );
+				count = m_count;
+			}
+
+			//only the events queued before the dispatch started, anything the listeners broadcast waits for the next one
+			unsigned int dispatched = 0;
+			for( unsigned int i = 0; i < count; i++ )
+			{
+				std::unique_lock<std::mutex> lock( m_mutex );
+
+				//copied so the ring can grow while the event is dispatched
+				Entry entry = m_ring[m_head];
+				m_head = (m_head + 1) & (m_ring.size() - 1);
+				m_count--;
+
+				if( entry.broadcaster )
+				{
+					entry.broadcaster->m_queuedEvents--;
+				}
+
+				lock.unlock();
+
+				if( entry.broadcaster )
 				{
-					((*it)->*m_eventCallback)(evt);
-					it++;
+					entry.broadcaster->_Dispatch( entry.event );
+					dispatched++;
 				}
 			}
+
+			return dispatched;
+
 		}
 
 	};
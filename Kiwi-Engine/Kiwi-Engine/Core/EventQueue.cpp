@@ -0,0 +1,43 @@
+#include "EventQueue.h"
+#include "Profiler.h"
+
+namespace Kiwi
+{
+
+	std::mutex EventQueues::m_mutex;
+	std::vector<Kiwi::IEventQueue*> EventQueues::m_queues[EVENT_PHASE_COUNT];
+
+	void EventQueues::Register( Kiwi::IEventQueue* queue, Kiwi::EVENT_PHASE phase )
+	{
+
+		std::lock_guard<std::mutex> lock( m_mutex );
+		m_queues[phase].push_back( queue );
+
+	}
+
+	unsigned int EventQueues::Dispatch( Kiwi::EVENT_PHASE phase )
+	{
+
+		KIWI_PROFILE_ZONE( "EventQueues::Dispatch" );
+
+		unsigned int dispatched = 0;
+
+		//queues can be created while dispatching (a listener deferring an event type that hasn't been deferred before)
+		//so the list is indexed instead of iterated
+		for( unsigned int i = 0; ; i++ )
+		{
+			Kiwi::IEventQueue* queue = 0;
+			{
+				std::lock_guard<std::mutex> lock( m_mutex );
+				if( i >= m_queues[phase].size() ) break;
+				queue = m_queues[phase][i];
+			}
+
+			dispatched += queue->Dispatch();
+		}
+
+		return dispatched;
+
+	}
+
+};
\ No newline at end of file
@@ -0,0 +1,53 @@
+#ifndef _KIWI_EVENTQUEUE_H_
+#define _KIWI_EVENTQUEUE_H_
+
+#include <vector>
+#include <mutex>
+
+namespace Kiwi
+{
+
+	/*points in the frame at which deferred events are dispatched*/
+	enum EVENT_PHASE
+	{
+		//after each fixed time step
+		EVENT_PHASE_FIXED_UPDATE = 0,
+		//after the untimed frame update, before the frame is rendered
+		EVENT_PHASE_UPDATE,
+		EVENT_PHASE_COUNT
+	};
+
+	/*base of the per event type queues deferred broadcasters write into*/
+	class IEventQueue
+	{
+	public:
+
+		virtual ~IEventQueue() {}
+
+		/*sends the queued events to the listeners of the broadcasters that queued them and returns how many were sent*/
+		virtual unsigned int Dispatch() = 0;
+
+	};
+
+	/*keeps track of every event queue so all of them can be dispatched at once*/
+	class EventQueues
+	{
+	protected:
+
+		static std::mutex m_mutex;
+
+		static std::vector<Kiwi::IEventQueue*> m_queues[EVENT_PHASE_COUNT];
+
+	public:
+
+		/*called once by each queue when it is created*/
+		static void Register( Kiwi::IEventQueue* queue, Kiwi::EVENT_PHASE phase );
+
+		/*dispatches the events of every queue of the phase, in the order the queues were created
+		events broadcast by listeners while the queues are dispatched are kept for the next dispatch*/
+		static unsigned int Dispatch( Kiwi::EVENT_PHASE phase );
+
+	};
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "GlobalEventQueue.h"
+
+namespace Kiwi
+{
+
+	GlobalEventQueue::GlobalEventQueue( std::size_t capacity ) :
+		m_head( 0 ),
+		m_offset( 0 ),
+		m_writers( 0 ),
+		m_requested( 0 ),
+		m_heapAllocations( 0 )
+	{
+
+		m_capacity = capacity;
+		m_buffer = (char*)::operator new( m_capacity );
+
+	}
+
+	GlobalEventQueue::~GlobalEventQueue()
+	{
+
+		//destroy the events that were never dispatched
+		this->Dispatch( []( const Kiwi::IGlobalEvent& ) {} );
+
+		::operator delete( m_buffer );
+
+	}
+
+	void* GlobalEventQueue::_Allocate( std::size_t size, bool& heap )
+	{
+
+		size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+		m_requested += size;
+
+		//the capacity can only change while the buffer is closed, and is only read once it has been reopened
+		std::size_t offset = m_offset.fetch_add( size );
+		if( offset < CLOSED_OFFSET && offset <= m_capacity && size <= m_capacity - offset )
+		{
+			heap = false;
+			return m_buffer + offset;
+		}
+
+		heap = true;
+		m_heapAllocations++;
+		return ::operator new( size );
+
+	}
+
+	void GlobalEventQueue::_Push( Node* node )
+	{
+
+		Node* head = m_head.load( std::memory_order_relaxed );
+		do
+		{
+			node->next = head;
+
+		} while( !m_head.compare_exchange_weak( head, node, std::memory_order_release, std::memory_order_relaxed ) );
+
+	}
+
+	void GlobalEventQueue::_Free( Node* node )
+	{
+
+		node->event->~IGlobalEvent();
+
+		if( node->heap )
+		{
+			::operator delete( (void*)node );
+		}
+
+	}
+
+	bool GlobalEventQueue::Reset()
+	{
+
+		std::size_t offset = m_offset.load();
+
+		if( m_head.load() != 0 || m_writers.load() != 0 )
+		{
+			return false;
+		}
+
+		//a thread that started posting since the checks has moved the offset, the reset is tried again next time
+		if( !m_offset.compare_exchange_strong( offset, CLOSED_OFFSET ) )
+		{
+			return false;
+		}
+
+		std::size_t requested = m_requested.exchange( 0 );
+		if( requested > m_capacity )
+		{
+			//no thread can allocate from the buffer while it is closed
+			std::size_t capacity = m_capacity;
+			while( capacity < requested )
+			{
+				capacity *= 2;
+			}
+
+			::operator delete( m_buffer );
+			m_buffer = (char*)::operator new( capacity );
+			m_capacity = capacity;
+		}
+
+		m_offset.store( 0 );
+
+		return true;
+
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#ifndef _KIWI_GLOBALEVENTQUEUE_H_
+#define _KIWI_GLOBALEVENTQUEUE_H_
+
+#include "IGlobalEvent.h"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace Kiwi
+{
+
+	/*multiple producer, single consumer queue of global events
+
+	events are constructed in a buffer that is bump allocated without locking and reset once every event in it has been
+	dispatched, so posting an event doesn't touch the heap once the buffer has grown to the largest frame's events.
+	events that don't fit are allocated from the heap and the buffer is grown at the next reset
+
+	Post can be called from any thread, Dispatch and Reset only from one consumer thread*/
+	class GlobalEventQueue
+	{
+	protected:
+
+		//placed in front of each event
+		struct Node
+		{
+			Node* next;
+			Kiwi::IGlobalEvent* event;
+
+			//the node and event were allocated from the heap because the buffer was full
+			bool heap;
+		};
+
+		static const std::size_t ALIGNMENT = alignof(std::max_align_t);
+		static const std::size_t NODE_SIZE = (sizeof( Node ) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+		//offset of a buffer that is being reset, allocations that see it use the heap
+		static const std::size_t CLOSED_OFFSET = ~(std::size_t)0 >> 1;
+
+		//posted events, most recent first
+		std::atomic<Node*> m_head;
+
+		char* m_buffer;
+		std::size_t m_capacity;
+		std::atomic<std::size_t> m_offset;
+
+		//threads currently posting
+		std::atomic<unsigned int> m_writers;
+
+		//bytes requested since the last reset, the buffer grows to fit them
+		std::atomic<std::size_t> m_requested;
+
+		std::atomic<unsigned long long> m_heapAllocations;
+
+	protected:
+
+		void* _Allocate( std::size_t size, bool& heap );
+
+		void _Push( Node* node );
+
+		void _Free( Node* node );
+
+	public:
+
+		GlobalEventQueue( std::size_t capacity = 16384 );
+		~GlobalEventQueue();
+
+		/*constructs an event of type EventClass in the queue*/
+		template<class EventClass, class... Args>
+		void Post( Args&&... args )
+		{
+
+			static_assert( alignof(EventClass) <= ALIGNMENT, "over-aligned global events are not supported" );
+
+			m_writers++;
+
+			bool heap = false;
+			char* memory = (char*)this->_Allocate( NODE_SIZE + sizeof( EventClass ), heap );
+
+			Node* node = new(memory) Node;
+			node->next = 0;
+			node->heap = heap;
+
+			try
+			{
+				node->event = new(memory + NODE_SIZE) EventClass( std::forward<Args>( args )... );
+
+			} catch( ... )
+			{
+				if( heap ) ::operator delete( memory );
+				m_writers--;
+				throw;
+			}
+
+			this->_Push( node );
+
+			m_writers--;
+
+		}
+
+		/*calls 'function' with each event posted before the call, in the order they were posted, and destroys them
+		returns the number of dispatched events*/
+		template<class Function>
+		unsigned int Dispatch( Function function )
+		{
+
+			Node* node = m_head.exchange( 0, std::memory_order_acquire );
+			if( node == 0 ) return 0;
+
+			//the list is in reverse order
+			Node* first = 0;
+			while( node != 0 )
+			{
+				Node* next = node->next;
+				node->next = first;
+				first = node;
+				node = next;
+			}
+
+			unsigned int count = 0;
+			while( first != 0 )
+			{
+				Node* next = first->next;
+
+				try
+				{
+					function( *first->event );
+
+				} catch( ... )
+				{
+					//the events that were not dispatched yet are dropped
+					while( first != 0 )
+					{
+						next = first->next;
+						this->_Free( first );
+						first = next;
+					}
+					throw;
+				}
+
+				this->_Free( first );
+				first = next;
+				count++;
+			}
+
+			return count;
+
+		}
+
+		/*releases the buffer's memory if there are no queued events and no thread is posting, and grows the buffer if
+		it overflowed since the last reset. returns false if the buffer couldn't be reset*/
+		bool Reset();
+
+		bool IsEmpty()const { return m_head.load() == 0; }
+
+		std::size_t GetCapacity()const { return m_capacity; }
+
+		/*returns the number of events that didn't fit into the buffer*/
+		unsigned long long GetHeapAllocationCount()const { return m_heapAllocations.load(); }
+
+	};
+}
+
+#endif
\ No newline at end of file
@@ -1,11 +1,12 @@
 #ifndef _KIWI_IGLOBALEVENT_H_
 #define _KIWI_IGLOBALEVENT_H_
 
-#include <memory>
-
 namespace Kiwi
 {
 
+	/*base of all global events, the ID selects the listeners the event is sent to. IDs must be positive and small,
+	listeners are stored in a list per ID. events are created by Kiwi::IGlobalEventBroadcaster::PostGlobalEvent and only
+	live until they have been dispatched*/
 	class IGlobalEvent
 	{
 	protected:
@@ -19,13 +20,13 @@ namespace Kiwi
 		{
 		}
 
-		virtual ~IGlobalEvent() = 0 {}
+		virtual ~IGlobalEvent() = 0;
 
 		int GetID()const { return m_eventID; }
 
 	};
 
-	typedef std::shared_ptr<IGlobalEvent> GlobalEventPtr;
+	inline IGlobalEvent::~IGlobalEvent() {}
 
 }
 
@@ -1,45 +1,100 @@
 #include "IGlobalEventBroadcaster.h"
 #include "IGlobalEventListener.h"
 
-#include <Windows.h>
+#include "../Assert.h"
+#include "../Profiler.h"
+
+#include <algorithm>
 
 namespace Kiwi
 {
 
-	void IGlobalEventBroadcaster::BroadcastGlobalEvent( GlobalEventPtr e )
+	IGlobalEventBroadcaster::IGlobalEventBroadcaster()
+	{
+
+		m_dispatchingGlobalEvents = false;
+		m_globalEventListenersChanged = false;
+
+	}
+
+	IGlobalEventBroadcaster::~IGlobalEventBroadcaster()
 	{
 
-		if( e != 0 )
+		//the listeners would try to unregister from this broadcaster when they are deleted
+		for( auto listItr = m_globalEventListeners.begin(); listItr != m_globalEventListeners.end(); listItr++ )
 		{
-			auto gelItr = m_globalEventListeners.find( e->GetID() );
-			if( gelItr != m_globalEventListeners.end() )
+			for( auto listenerItr = listItr->begin(); listenerItr != listItr->end(); listenerItr++ )
 			{
-				for( auto listenerItr = gelItr->second.begin(); listenerItr != gelItr->second.end(); listenerItr++ )
+				if( *listenerItr != 0 )
 				{
-					if( *listenerItr != 0 )
-					{
-						(*listenerItr)->EnqueueGlobalEvent( e );
-					}
+					std::vector<Kiwi::IGlobalEventBroadcaster*>& broadcasters = (*listenerItr)->m_broadcasters;
+					broadcasters.erase( std::remove( broadcasters.begin(), broadcasters.end(), this ), broadcasters.end() );
 				}
 			}
-			
-			if( e->GetID() != 0 )
+		}
+
+	}
+
+	void IGlobalEventBroadcaster::_SendGlobalEvent( const Kiwi::IGlobalEvent& e, unsigned int listenerList )
+	{
+
+		if( listenerList >= m_globalEventListeners.size() ) return;
+
+		//listeners added while sending are appended and don't receive the event, removed listeners are set to 0
+		unsigned int count = (unsigned int)m_globalEventListeners[listenerList].size();
+		for( unsigned int i = 0; i < count; i++ )
+		{
+			Kiwi::IGlobalEventListener* listener = m_globalEventListeners[listenerList][i];
+			if( listener != 0 )
 			{
-				//also need to send the event to the listeners that are listening for all events
-				gelItr = m_globalEventListeners.find( 0 );
-				if( gelItr != m_globalEventListeners.end() )
+				listener->_ProcessGlobalEvent( e );
+			}
+		}
+
+	}
+
+	void IGlobalEventBroadcaster::DispatchGlobalEvents()
+	{
+
+		KIWI_PROFILE_ZONE( "IGlobalEventBroadcaster::DispatchGlobalEvents" );
+
+		m_dispatchingGlobalEvents = true;
+
+		try
+		{
+			//events posted by the listeners are dispatched as well, so keep going until the queue is empty
+			while( m_globalEventQueue.Dispatch( [this]( const Kiwi::IGlobalEvent& e )
 				{
-					for( auto listenerItr = gelItr->second.begin(); listenerItr != gelItr->second.end(); listenerItr++ )
+					if( e.GetID() > 0 )
 					{
-						if( *listenerItr != 0 )
-						{
-							(*listenerItr)->EnqueueGlobalEvent( e );
-						}
+						this->_SendGlobalEvent( e, (unsigned int)e.GetID() );
 					}
-				}
+
+					//also need to send the event to the listeners that are listening for all events
+					this->_SendGlobalEvent( e, 0 );
+
+				} ) > 0 );
+
+		} catch( ... )
+		{
+			m_dispatchingGlobalEvents = false;
+			throw;
+		}
+
+		m_dispatchingGlobalEvents = false;
+
+		if( m_globalEventListenersChanged )
+		{
+			for( auto itr = m_globalEventListeners.begin(); itr != m_globalEventListeners.end(); itr++ )
+			{
+				itr->erase( std::remove( itr->begin(), itr->end(), (Kiwi::IGlobalEventListener*)0 ), itr->end() );
 			}
+			m_globalEventListenersChanged = false;
 		}
 
+		//fails if a thread is posting right now, the memory is then released after the next dispatch
+		m_globalEventQueue.Reset();
+
 	}
 
 	void IGlobalEventBroadcaster::AddGlobalEventListener( Kiwi::IGlobalEventListener* listener )
@@ -47,39 +102,36 @@ namespace Kiwi
 
 		if( listener != 0 )
 		{
-			if( listener->GetRegisteredEventIDs().size() > 0 )
+			std::vector<int> eventIDs = listener->GetRegisteredEventIDs();
+			if( eventIDs.size() == 0 )
 			{
-				//iterate over each event ID the listener wants to receive and add the listener to the list for each
-				for( auto eventIDItr = listener->GetRegisteredEventIDs().begin(); eventIDItr != listener->GetRegisteredEventIDs().end(); eventIDItr++ )
-				{
-					auto gelItr = m_globalEventListeners.find( *eventIDItr );
-					if( gelItr != m_globalEventListeners.end() )
-					{
-						gelItr->second.insert( listener );
-
-					} else
-					{
-						std::unordered_set<Kiwi::IGlobalEventListener*> newSet;
-						newSet.insert( listener );
-						m_globalEventListeners.insert( std::make_pair( *eventIDItr, newSet ) );
-					}
-				}
+				//no event IDs specified, add the listener to the all event list
+				eventIDs.push_back( 0 );
+			}
 
-			} else
+			//add the listener to the list of each event ID it wants to receive
+			for( auto eventIDItr = eventIDs.begin(); eventIDItr != eventIDs.end(); eventIDItr++ )
 			{
-				//no event IDs specified, add the listener to the all event list
-				auto gelItr = m_globalEventListeners.find( 0 );
-				if( gelItr != m_globalEventListeners.end() )
+				assert( *eventIDItr >= 0 );
+				if( *eventIDItr < 0 ) continue;
+
+				unsigned int eventID = (unsigned int)*eventIDItr;
+				if( eventID >= m_globalEventListeners.size() )
 				{
-					gelItr->second.insert( listener );
+					m_globalEventListeners.resize( eventID + 1 );
+				}
 
-				} else
+				std::vector<Kiwi::IGlobalEventListener*>& listeners = m_globalEventListeners[eventID];
+				if( std::find( listeners.begin(), listeners.end(), listener ) == listeners.end() )
 				{
-					std::unordered_set<Kiwi::IGlobalEventListener*> newSet;
-					newSet.insert( listener );
-					m_globalEventListeners.insert( std::make_pair( 0, newSet ) );
+					listeners.push_back( listener );
 				}
 			}
+
+			if( std::find( listener->m_broadcasters.begin(), listener->m_broadcasters.end(), this ) == listener->m_broadcasters.end() )
+			{
+				listener->m_broadcasters.push_back( this );
+			}
 		}
 
 	}
@@ -87,30 +139,24 @@ namespace Kiwi
 	void IGlobalEventBroadcaster::RemoveGlobalEventListener( Kiwi::IGlobalEventListener* listener )
 	{
 
-		if( listener != 0 && m_globalEventListeners.size() > 0 )
+		if( listener != 0 )
 		{
-			if( listener->GetRegisteredEventIDs().size() > 0 )
+			//the listener is removed from every list, its registered event IDs may have changed since it was added
+			for( auto itr = m_globalEventListeners.begin(); itr != m_globalEventListeners.end(); itr++ )
 			{
-				//iterate over each event ID the listener wants to receive and remove the listener from the list for each
-				for( auto eventIDItr = listener->GetRegisteredEventIDs().begin(); eventIDItr != listener->GetRegisteredEventIDs().end(); eventIDItr++ )
+				if( m_dispatchingGlobalEvents )
 				{
-					auto itr = m_globalEventListeners.find( *eventIDItr );
-					if( itr != m_globalEventListeners.end() )
-					{
-						itr->second.erase( listener );
-					}
-				}
+					//the lists can't be resized while they are iterated
+					std::replace( itr->begin(), itr->end(), listener, (Kiwi::IGlobalEventListener*)0 );
+					m_globalEventListenersChanged = true;
 
-			} else
-			{
-				//no event IDs specified, remove the listener from the all event list
-				auto itr = m_globalEventListeners.find( 0 );
-				if( itr != m_globalEventListeners.end() )
+				} else
 				{
-					itr->second.erase( listener );
+					itr->erase( std::remove( itr->begin(), itr->end(), listener ), itr->end() );
 				}
-
 			}
+
+			listener->m_broadcasters.erase( std::remove( listener->m_broadcasters.begin(), listener->m_broadcasters.end(), this ), listener->m_broadcasters.end() );
 		}
 
 	}
@@ -2,9 +2,10 @@
 #define _KIWI_IGLOBALEVENTBROADCASTER_H_
 
 #include "IGlobalEvent.h"
+#include "GlobalEventQueue.h"
 
-#include <unordered_map>
-#include <unordered_set>
+#include <vector>
+#include <utility>
 
 namespace Kiwi
 {
@@ -15,15 +16,36 @@ namespace Kiwi
 	{
 	protected:
 
-		/*stores the list of listeners, sorted by the ID of event they are registered for
-		and ID of 0 indicates a listener wants to receive ALL global events*/
-		std::unordered_map<int, std::unordered_set<Kiwi::IGlobalEventListener*>> m_globalEventListeners;
+		/*stores the list of listeners, indexed by the ID of event they are registered for
+		and ID of 0 indicates a listener wants to receive ALL global events
+		removed listeners are 0 until the lists are compacted after the next dispatch*/
+		std::vector<std::vector<Kiwi::IGlobalEventListener*>> m_globalEventListeners;
+
+		Kiwi::GlobalEventQueue m_globalEventQueue;
+
+		bool m_dispatchingGlobalEvents;
+		bool m_globalEventListenersChanged;
+
+	protected:
+
+		void _SendGlobalEvent( const Kiwi::IGlobalEvent& e, unsigned int listenerList );
 
 	public:
 
-		IGlobalEventBroadcaster() {}
+		IGlobalEventBroadcaster();
+		virtual ~IGlobalEventBroadcaster();
+
+		/*constructs a new event of type EventClass and queues it, the event is sent to the listeners by the next call
+		to DispatchGlobalEvents. can be called from any thread*/
+		template<class EventClass, class... Args>
+		void PostGlobalEvent( Args&&... args )
+		{
+			m_globalEventQueue.Post<EventClass>( std::forward<Args>( args )... );
+		}
 
-		void BroadcastGlobalEvent( GlobalEventPtr e );
+		/*sends all queued events to their listeners, including events posted by the listeners while dispatching
+		must be called from the thread the listeners are added and removed on*/
+		void DispatchGlobalEvents();
 
 		void AddGlobalEventListener( Kiwi::IGlobalEventListener* listener );
 
@@ -2,7 +2,6 @@
 
 #include "IGlobalEventBroadcaster.h"
 
-#include <Windows.h>
 
 namespace Kiwi
 {
@@ -15,39 +14,11 @@ namespace Kiwi
 	IGlobalEventListener::~IGlobalEventListener()
 	{
 		
-		//unregister from all broadcasters
-		/*for( auto itr = m_broadcasters.begin(); itr != m_broadcasters.end(); itr++ )
+		//unregister from all broadcasters, which removes them from m_broadcasters
+		while( m_broadcasters.size() > 0 )
 		{
-			
-		}*/
-
-	}
-
-	void IGlobalEventListener::EnqueueGlobalEvent( GlobalEventPtr& e )
-	{
-
-		if( e != 0 )
-		{
-			m_globalEventQueue.push_back( e );
-		}
-
-	}
-
-	/*pulls the next event in the event queue and sends it to _ProcessGlobalEvent(IGlobalEvent* e)
-	returns true if there are more events in the queue, and false if the queue is empty*/
-	bool IGlobalEventListener::PullNextEvent()
-	{
-		
-		if( m_globalEventQueue.size() == 0 )
-		{
-			return false;
+			m_broadcasters.back()->RemoveGlobalEventListener( this );
 		}
-		
-		this->_ProcessGlobalEvent( m_globalEventQueue.front() );
-		
-		m_globalEventQueue.pop_front();
-		
-		return (m_globalEventQueue.size() == 0) ? false : true;
 
 	}
 }
\ No newline at end of file
@@ -3,9 +3,7 @@
 
 #include "IGlobalEvent.h"
 
-#include <deque>
 #include <vector>
-#include <memory>
 
 namespace Kiwi
 {
@@ -14,35 +12,30 @@ namespace Kiwi
 
 	class IGlobalEventListener
 	{
+	friend class IGlobalEventBroadcaster;
 	protected:
 
+		//the broadcasters the listener is registered with
 		std::vector<IGlobalEventBroadcaster*> m_broadcasters;
 
-		std::deque<GlobalEventPtr> m_globalEventQueue;
-
 		/*stores a list of event IDs that this listener wants to receive
 		if this list is empty, the listener will receive all global events*/
 		std::vector<int> m_registeredEventIDs;
 
 	protected:
 
-		virtual void _ProcessGlobalEvent( GlobalEventPtr e ) {}
-
-		//void _AddBroadcaster( IGlobalEventBroadcaster* broadcaster );
+		/*called by the broadcaster when it dispatches its events. the event is destroyed afterwards, so it
+		must be copied if it is needed later*/
+		virtual void _ProcessGlobalEvent( const Kiwi::IGlobalEvent& e ) {}
 
 	public:
 
 		IGlobalEventListener();
 		virtual ~IGlobalEventListener();
 
-		void EnqueueGlobalEvent( GlobalEventPtr& e );
-
-		/*pulls the next event in the event queue and sends it to _ProcessGlobalEvent(IGlobalEvent* e)
-		returns true if there are more events in the queue, and false if the queue is empty*/
-		bool PullNextEvent();
-
 		/*sets the list of event IDs that this listener wants to receive
-		if this list is not set, the listener will receive all global events*/
+		if this list is not set, the listener will receive all global events
+		must be set before the listener is added to a broadcaster*/
 		void SetRegisteredEventIDs( std::vector<int> eventIDs ) { m_registeredEventIDs = eventIDs; }
 
 		std::vector<int>& GetRegisteredEventIDs() { return m_registeredEventIDs; }
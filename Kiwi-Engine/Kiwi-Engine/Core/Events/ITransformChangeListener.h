@@ -0,0 +1,22 @@
+#ifndef _KIWI_ITRANSFORMCHANGELISTENER_H_
+#define _KIWI_ITRANSFORMCHANGELISTENER_H_
+
+#include "TransformChangeEvent.h"
+
+namespace Kiwi
+{
+
+	class ITransformChangeListener
+	{
+	public:
+
+		ITransformChangeListener(){}
+		virtual ~ITransformChangeListener(){}
+
+		/*called once per frame with all of the transforms that changed during the frame*/
+		virtual void OnTransformsChanged( const Kiwi::TransformChangeEvent& evt ) {}
+
+	};
+};
+
+#endif
\ No newline at end of file
@@ -2,9 +2,8 @@
 #define _KIWI_KEYBOARDEVENT_H_
 
 #include "../RawInputWrapper.h"
-#include "..\Event.h"
+#include "../Event.h"
 
-#include <Windows.h>
 
 namespace Kiwi
 {
@@ -1,7 +1,7 @@
 #ifndef _KIWI_KEYBOARDEVENTBROADCASTER_H_
 #define _KIWI_KEYBOARDEVENTBROADCASTER_H_
 
-#include "..\EventBroadcaster.h"
+#include "../EventBroadcaster.h"
 
 #include "IKeyboardEventListener.h"
 #include "KeyboardEvent.h"
@@ -1,11 +1,10 @@
 #ifndef _KIWI_SCENEEVENT_H_
 #define _KIWI_SCENEEVENT_H_
 
-#include "..\Event.h"
+#include "../Event.h"
 #include "../Quaternion.h"
 #include "../Vector3d.h"
 
-#include <Windows.h>
 
 namespace Kiwi
 {
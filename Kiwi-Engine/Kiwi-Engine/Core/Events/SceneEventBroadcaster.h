@@ -1,7 +1,7 @@
 #ifndef _KIWI_SCENEEVENTBROADCASTER_H_
 #define _KIWI_SCENEEVENTBROADCASTER_H_
 
-#include "..\EventBroadcaster.h"
+#include "../EventBroadcaster.h"
 
 #include "ISceneEventListener.h"
 
@@ -0,0 +1,58 @@
+#ifndef _KIWI_TRANSFORMCHANGEEVENT_H_
+#define _KIWI_TRANSFORMCHANGEEVENT_H_
+
+#include "../Event.h"
+#include "../Quaternion.h"
+#include "../Vector3d.h"
+
+#include <vector>
+
+namespace Kiwi
+{
+
+	class Transform;
+	class TransformStore;
+
+	/*one entry in a transform store's per-frame change list
+	a transform gets a single entry no matter how many times it was changed during the frame*/
+	struct TransformChange
+	{
+		enum CHANGE_FLAGS { POSITION = 1, ROTATION = 2, SCALE = 4 };
+
+		Kiwi::Transform* transform;
+		unsigned int handle;
+
+		//which of the local values changed (CHANGE_FLAGS)
+		unsigned char flags;
+
+		//local values at the time of the first change this frame
+		Kiwi::Vector3d startPosition;
+		Kiwi::Quaternion startRotation;
+		Kiwi::Vector3d startScale;
+	};
+
+	typedef std::vector<Kiwi::TransformChange> TransformChangeList;
+
+	/*sent once per frame by a transform store with every transform that changed since the last dispatch*/
+	class TransformChangeEvent :
+		public Kiwi::Event<Kiwi::TransformStore>
+	{
+	protected:
+
+		const Kiwi::TransformChangeList* m_changes;
+
+	public:
+
+		TransformChangeEvent( Kiwi::TransformStore* source, const Kiwi::TransformChangeList& changes ) :
+			Event( source ),
+			m_changes( &changes ) {}
+
+		virtual ~TransformChangeEvent() {}
+
+		/*entries for transforms that were destroyed before the dispatch have a null transform*/
+		const Kiwi::TransformChangeList& GetChanges()const { return *m_changes; }
+
+	};
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef _KIWI_TRANSFORMCHANGEEVENTBROADCASTER_H_
+#define _KIWI_TRANSFORMCHANGEEVENTBROADCASTER_H_
+
+#include "../EventBroadcaster.h"
+
+#include "ITransformChangeListener.h"
+#include "TransformChangeEvent.h"
+
+namespace Kiwi
+{
+
+	class TransformChangeEventBroadcaster :
+		public Kiwi::EventBroadcaster<Kiwi::ITransformChangeListener, Kiwi::TransformChangeEvent>
+	{
+	public:
+
+		TransformChangeEventBroadcaster() :
+			EventBroadcaster<Kiwi::ITransformChangeListener, Kiwi::TransformChangeEvent>( &Kiwi::ITransformChangeListener::OnTransformsChanged ) {}
+
+		virtual ~TransformChangeEventBroadcaster() {}
+
+		void AddTransformChangeListener( Kiwi::ITransformChangeListener* listener )
+		{
+			this->AddListener( listener );
+		}
+
+		void RemoveTransformChangeListener( Kiwi::ITransformChangeListener* listener )
+		{
+			this->RemoveListener( listener );
+		}
+
+		void BroadcastTransformChangeEvent( const Kiwi::TransformChangeEvent& evt )
+		{
+			this->BroadcastEvent( evt );
+		}
+
+	};
+};
+
+#endif
\ No newline at end of file
@@ -1,12 +1,10 @@
 #ifndef _KIWI_TRANSFORMEVENT_H_
 #define _KIWI_TRANSFORMEVENT_H_
 
-#include "..\RawInputWrapper.h"
-#include "..\Event.h"
+#include "../Event.h"
 #include "../Quaternion.h"
 #include "../Vector3d.h"
 
-#include <Windows.h>
 
 namespace Kiwi
 {
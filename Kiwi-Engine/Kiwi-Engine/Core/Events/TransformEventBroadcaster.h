@@ -1,7 +1,7 @@
 #ifndef _KIWI_TRANSFORMEVENTBROADCASTER_H_
 #define _KIWI_TRANSFORMEVENTBROADCASTER_H_
 
-#include "..\EventBroadcaster.h"
+#include "../EventBroadcaster.h"
 
 #include "ITransformEventListener.h"
 #include "TransformEvent.h"
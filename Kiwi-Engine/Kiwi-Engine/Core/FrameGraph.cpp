@@ -0,0 +1,158 @@
+#include "FrameGraph.h"
+#include "Profiler.h"
+
+#include <algorithm>
+
+namespace Kiwi
+{
+
+	FrameGraph::FrameGraph( Kiwi::JobSystem& jobSystem ):
+		m_jobSystem( jobSystem )
+	{
+
+		m_serial = false;
+
+	}
+
+	void FrameGraph::_AddDependency( Task& task, unsigned int dependency )
+	{
+
+		if( std::find( task.dependencies.begin(), task.dependencies.end(), dependency ) == task.dependencies.end() )
+		{
+			task.dependencies.push_back( dependency );
+		}
+
+	}
+
+	unsigned int FrameGraph::AddTask( const char* name, std::function<void()> function, const Kiwi::FrameResourceList& reads, const Kiwi::FrameResourceList& writes, bool mainThread )
+	{
+
+		unsigned int index = (unsigned int)m_tasks.size();
+
+		m_tasks.push_back( Task() );
+		Task& task = m_tasks.back();
+		task.name = name;
+		task.function = std::move( function );
+		task.mainThread = mainThread;
+
+		//read after write
+		for( unsigned int i = 0; i < reads.size(); i++ )
+		{
+			ResourceState& resource = m_resources[reads[i]];
+			if( resource.lastWriter != 0 )
+			{
+				this->_AddDependency( task, resource.lastWriter - 1 );
+			}
+			resource.readers.push_back( index );
+		}
+
+		//write after write and write after read
+		for( unsigned int i = 0; i < writes.size(); i++ )
+		{
+			ResourceState& resource = m_resources[writes[i]];
+			if( resource.lastWriter != 0 && resource.lastWriter - 1 != index )
+			{
+				this->_AddDependency( task, resource.lastWriter - 1 );
+			}
+			for( unsigned int r = 0; r < resource.readers.size(); r++ )
+			{
+				if( resource.readers[r] != index )
+				{
+					this->_AddDependency( task, resource.readers[r] );
+				}
+			}
+			resource.lastWriter = index + 1;
+			resource.readers.clear();
+		}
+
+		return index;
+
+	}
+
+	void FrameGraph::_RunTask( Task& task )
+	{
+
+		KIWI_PROFILE_ZONE( task.name );
+
+		task.function();
+
+	}
+
+	void FrameGraph::Execute()
+	{
+
+		if( m_serial )
+		{
+			for( unsigned int i = 0; i < m_tasks.size(); i++ )
+			{
+				FrameGraph::_RunTask( m_tasks[i] );
+			}
+			return;
+		}
+
+		//schedule the worker tasks after their dependencies, main thread tasks get a signal that is set once they have run
+		for( unsigned int i = 0; i < m_tasks.size(); i++ )
+		{
+			Task& task = m_tasks[i];
+
+			if( task.mainThread )
+			{
+				task.handle = m_jobSystem.CreateSignal();
+
+			} else
+			{
+				m_handles.clear();
+				for( unsigned int d = 0; d < task.dependencies.size(); d++ )
+				{
+					m_handles.push_back( m_tasks[task.dependencies[d]].handle );
+				}
+
+				Task* taskPtr = &task;
+				task.handle = m_jobSystem.ScheduleAfter( m_handles, [taskPtr]() { FrameGraph::_RunTask( *taskPtr ); } );
+			}
+		}
+
+		for( unsigned int i = 0; i < m_tasks.size(); i++ )
+		{
+			Task& task = m_tasks[i];
+			if( task.mainThread == false ) continue;
+
+			std::exception_ptr exception;
+			try
+			{
+				//runs worker tasks on this thread while waiting
+				for( unsigned int d = 0; d < task.dependencies.size(); d++ )
+				{
+					m_jobSystem.Wait( m_tasks[task.dependencies[d]].handle );
+				}
+
+				FrameGraph::_RunTask( task );
+
+			} catch( ... )
+			{
+				exception = std::current_exception();
+			}
+
+			m_jobSystem.Signal( task.handle, exception );
+		}
+
+		m_handles.clear();
+		for( unsigned int i = 0; i < m_tasks.size(); i++ )
+		{
+			m_handles.push_back( m_tasks[i].handle );
+		}
+
+		m_jobSystem.Wait( m_handles );
+
+	}
+
+	void FrameGraph::Clear()
+	{
+
+		m_tasks.clear();
+		m_resources.clear();
+		m_handles.clear();
+
+	}
+
+}
\ No newline at end of file
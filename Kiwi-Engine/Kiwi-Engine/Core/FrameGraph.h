@@ -0,0 +1,97 @@
+#ifndef _KIWI_FRAMEGRAPH_H_
+#define _KIWI_FRAMEGRAPH_H_
+
+#include "JobSystem.h"
+
+#include <vector>
+#include <unordered_map>
+#include <functional>
+
+namespace Kiwi
+{
+
+	/*anything a frame task reads or writes, identified by its address (a scene, the physics system, a render queue...)*/
+	typedef const void* FrameResource;
+
+	typedef std::vector<Kiwi::FrameResource> FrameResourceList;
+
+	/*the work of one frame as a list of tasks with read and write sets, executed on a job system
+	tasks are added in the order they would run in on a single thread. each task depends on the last earlier task that
+	wrote something it reads or writes, and on every earlier task that read something it writes since that write. tasks
+	that do not share resources may run at the same time
+
+	tasks flagged as main thread tasks (event broadcasts, anything calling into game code, the window or the graphics
+	device) are run on the thread calling Execute, in the order they were added*/
+	class FrameGraph
+	{
+	protected:
+
+		struct Task
+		{
+			//used by the profiler, must be a string literal
+			const char* name;
+
+			std::function<void()> function;
+
+			bool mainThread;
+
+			//indices of the tasks this task depends on
+			std::vector<unsigned int> dependencies;
+
+			Kiwi::JobHandle handle;
+		};
+
+		struct ResourceState
+		{
+			//index + 1 of the last task that wrote the resource, 0 if no task has written it yet
+			unsigned int lastWriter;
+
+			//tasks that read the resource since the last write
+			std::vector<unsigned int> readers;
+		};
+
+		Kiwi::JobSystem& m_jobSystem;
+
+		std::vector<Task> m_tasks;
+		std::unordered_map<Kiwi::FrameResource, ResourceState> m_resources;
+
+		//reused while executing
+		std::vector<Kiwi::JobHandle> m_handles;
+
+		bool m_serial;
+
+	protected:
+
+		void _AddDependency( Task& task, unsigned int dependency );
+
+		/*runs the task inside a profiler zone named after it*/
+		static void _RunTask( Task& task );
+
+	public:
+
+		FrameGraph( Kiwi::JobSystem& jobSystem );
+
+		/*adds a task and returns its index*/
+		unsigned int AddTask( const char* name, std::function<void()> function, const Kiwi::FrameResourceList& reads, const Kiwi::FrameResourceList& writes, bool mainThread = false );
+
+		/*runs all tasks and blocks until they have finished, the calling thread runs the main thread tasks and helps with the rest
+		if tasks throw, the tasks depending on them are skipped and the first exception is re-thrown once all others are done*/
+		void Execute();
+
+		/*removes all tasks so the graph can be built for the next frame*/
+		void Clear();
+
+		/*if true Execute runs every task on the calling thread in the order they were added, used to compare against the
+		single threaded frame*/
+		void SetSerial( bool serial ) { m_serial = serial; }
+
+		bool IsSerial()const { return m_serial; }
+
+		unsigned int GetTaskCount()const { return (unsigned int)m_tasks.size(); }
+		const char* GetTaskName( unsigned int task )const { return m_tasks[task].name; }
+		const std::vector<unsigned int>& GetTaskDependencies( unsigned int task )const { return m_tasks[task].dependencies; }
+
+	};
+}
+
+#endif
\ No newline at end of file
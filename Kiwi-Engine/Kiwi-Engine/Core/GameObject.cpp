@@ -4,39 +4,44 @@
 namespace Kiwi
 {
 
-	int GameObject::GlobalObjectID = 1;
-	std::mutex GameObject::GlobalObjectIDMutex;
+	std::atomic<int> GameObject::GlobalObjectID( 1 );
 
-	GameObject::GameObject()
+	int GameObject::GenerateObjectID()
 	{
 
-		GlobalObjectIDMutex.lock();
-		m_objectID = GlobalObjectID++;
-		if( GlobalObjectID == 0 )
+		//0 is reserved to mean 'no ID', skip it if the counter wraps around
+		int id = GlobalObjectID.fetch_add( 1, std::memory_order_relaxed );
+		while( id == 0 )
 		{
-			GlobalObjectID++;
+			id = GlobalObjectID.fetch_add( 1, std::memory_order_relaxed );
 		}
-		GlobalObjectIDMutex.unlock();
 
+		return id;
+
+	}
+
+	GameObject::GameObject()
+	{
+
+		m_objectID = GenerateObjectID();
+
+		m_tags = 0;
 		m_isShutdown = false;
 		m_isActive = true;
+		m_isMainThreadOnly = false;
 
 	}
 
 	GameObject::GameObject(std::wstring name)
 	{
 
-		GlobalObjectIDMutex.lock();
-		m_objectID = GlobalObjectID++;
-		if( GlobalObjectID == 0 )
-		{
-			GlobalObjectID++;
-		}
-		GlobalObjectIDMutex.unlock();
+		m_objectID = GenerateObjectID();
 
 		m_objectName = name;
+		m_tags = 0;
 		m_isShutdown = false;
 		m_isActive = true;
+		m_isMainThreadOnly = false;
 
 	}
 
@@ -48,8 +53,6 @@ namespace Kiwi
 			this->Shutdown();
 		}
 
-		Kiwi::FreeMemory( m_tags );
-
 	}
 
 	void GameObject::Shutdown()
@@ -82,24 +85,40 @@ namespace Kiwi
 	void GameObject::RemoveAllTags()
 	{
 
-		//empty the tag list and free the memory
-		Kiwi::FreeMemory( m_tags );
+		m_tags = 0;
 
 	}
 
-	/*checks if the entity has a certain tag*/
-	bool GameObject::HasTag( std::wstring tag )
+	void GameObject::AddTag( Kiwi::StringId tag )
 	{
 
-		auto it = m_tags.find( tag );
-		if( it != m_tags.end() )
+		m_tags |= Kiwi::TagTable::GetMask( tag );
+
+	}
+
+	void GameObject::RemoveTag( Kiwi::StringId tag )
+	{
+
+		unsigned int tagIndex = Kiwi::TagTable::Find( tag );
+		if( tagIndex != Kiwi::TagTable::INVALID_TAG )
 		{
-			return true;
-		} else
+			m_tags &= ~((Kiwi::TagMask)1 << tagIndex);
+		}
+
+	}
+
+	/*checks if the entity has a certain tag*/
+	bool GameObject::HasTag( Kiwi::StringId tag )
+	{
+
+		unsigned int tagIndex = Kiwi::TagTable::Find( tag );
+		if( tagIndex == Kiwi::TagTable::INVALID_TAG )
 		{
 			return false;
 		}
 
+		return (m_tags & ((Kiwi::TagMask)1 << tagIndex)) != 0;
+
 	}
 
 	void GameObject::SetActive( bool isActive )
@@ -2,10 +2,11 @@
 #define _KIWI_GAMEOBJECT_H_
 
 #include "IReferencedObject.h"
+#include "StringId.h"
+#include "TagTable.h"
 
 #include <string>
-#include <mutex>
-#include <unordered_set>
+#include <atomic>
 
 namespace Kiwi
 {
@@ -15,19 +16,22 @@ namespace Kiwi
 	{
 	protected:
 		//stores the current object ID that will be assigned to the next created object
-		static int GlobalObjectID; 
-		static std::mutex GlobalObjectIDMutex;
+		static std::atomic<int> GlobalObjectID;
 
 		int m_objectID;
 
+		/*not interned, names are often unique (e.g. spawned entities) and the string table never removes strings*/
 		std::wstring m_objectName;
 
-		/*optional, non-unique identifiers*/
-		std::unordered_set<std::wstring> m_tags;
+		/*optional, non-unique identifiers, one bit per tag in the global tag table*/
+		Kiwi::TagMask m_tags;
 
 		bool m_isShutdown;
 		bool m_isActive;
 
+		/*if true the object is always updated on the main thread, even when its entity manager updates in parallel*/
+		bool m_isMainThreadOnly;
+
 	protected:
 
 		virtual void _OnShutdown() {}
@@ -38,6 +42,9 @@ namespace Kiwi
 		
 	public:
 
+		/*returns a new unique object ID (never 0)*/
+		static int GenerateObjectID();
+
 		GameObject();
 		GameObject( std::wstring name );
 		virtual ~GameObject() = 0;
@@ -46,23 +53,39 @@ namespace Kiwi
 		virtual void FixedUpdate();
 		virtual void Update();
 
-		virtual void AddTag( std::wstring tag ) { m_tags.insert( tag ); }
+		virtual void AddTag( Kiwi::StringId tag );
+		void AddTag( std::wstring tag ) { this->AddTag( Kiwi::StringTable::Intern( tag ) ); }
 
 		/*removes the matching string from the entity*/
-		virtual void RemoveTag( std::wstring tag ) { m_tags.erase( tag ); }
+		virtual void RemoveTag( Kiwi::StringId tag );
+		void RemoveTag( std::wstring tag ) { this->RemoveTag( Kiwi::StringTable::Find( tag ) ); }
 		/*removes all tags from the entity*/
 		virtual void RemoveAllTags();
 
 		/*checks if the entity has a certain tag*/
-		virtual bool HasTag( std::wstring tag );
+		virtual bool HasTag( Kiwi::StringId tag );
+		bool HasTag( std::wstring tag ) { return this->HasTag( Kiwi::StringTable::Find( tag ) ); }
+
+		/*checks if the entity has all of the tags in the mask (see TagTable::GetMask)*/
+		bool HasTags( Kiwi::TagMask tags )const { return (m_tags & tags) == tags; }
+
+		Kiwi::TagMask GetTagMask()const { return m_tags; }
 
 		bool IsShutdown()const { return m_isShutdown; }
 		bool IsActive()const { return m_isActive; }
+		bool IsMainThreadOnly()const { return m_isMainThreadOnly; }
+
+		/*objects that create or destroy other objects, touch graphics resources or are otherwise not safe
+		to update concurrently with other entities should be flagged as main-thread-only*/
+		void SetMainThreadOnly( bool mainThreadOnly ) { m_isMainThreadOnly = mainThreadOnly; }
 
 		void SetActive( bool isActive );
 		void SetName( std::wstring name ) { m_objectName = name; }
 
 		std::wstring GetName()const { return m_objectName; }
+
+		/*interns the name and returns its ID, only use this for names that are looked up repeatedly*/
+		Kiwi::StringId GetNameID()const { return Kiwi::StringTable::Intern( m_objectName ); }
 		int GetID()const { return m_objectID; }
 
 	};
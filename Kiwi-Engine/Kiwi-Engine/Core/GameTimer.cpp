@@ -2,9 +2,50 @@
 #include "Logger.h"
 #include "Utilities.h"
 
+#include <cmath>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
 namespace Kiwi
 {
 
+	namespace
+	{
+		//the frame time histogram has 0.1ms buckets up to 200ms plus one bucket for all longer frames
+		const double HistogramBucketSize = 0.1;
+		const unsigned int HistogramBucketCount = 2000;
+
+		//frames needed in the statistics window before the median is trusted for hitch detection
+		const unsigned int MinHitchFrames = 30;
+
+		unsigned int HistogramBucket( double frameTime )
+		{
+			if( frameTime >= HistogramBucketSize * HistogramBucketCount ) return HistogramBucketCount;
+			if( frameTime <= 0.0 ) return 0;
+
+			return (unsigned int)(frameTime / HistogramBucketSize);
+		}
+
+		//writes 'text' as a quoted CSV field
+		void WriteCSVString( std::ofstream& file, const std::string& text )
+		{
+			file << '"';
+			for( char c : text )
+			{
+				if( c == '"' ) file << '"';
+				file << c;
+			}
+			file << '"';
+		}
+
+		void WriteCSVRow( std::ofstream& file, const std::string& name, const Kiwi::FrameTimeStatistics& statistics )
+		{
+			WriteCSVString( file, name );
+			file << "," << statistics.frameCount << "," << statistics.average << "," << statistics.p50 << "," << statistics.p95 << "," << statistics.p99 << "," << statistics.max;
+		}
+	}
+
 	GameTimer::GameTimer()
 	{
 
@@ -12,12 +53,27 @@ namespace Kiwi
 		m_fixedUpdatesPerSecond = 1;
 		m_targetUpdatesPerSecond = 60;
 		m_oneOverTUPS = 1.0 / 60.0;
+		m_maxFixedSteps = 5;
+		m_fixedSteps = 0;
 
 		m_deltaTime = 0.0f;
 		m_fixedDeltaTime = m_oneOverTUPS;
+		m_fixedAccumulator = 0.0;
+		m_interpolationAlpha = 0.0f;
+
+		m_rateTimer = 0.0;
+		m_rateFrameCount = 0;
+		m_rateFixedStepCount = 0;
 
 		m_doFixedUpdate = false;
 
+		m_statisticsWindow = 1000;
+		m_frameStartStamp = 0;
+		m_statisticsStarted = false;
+		m_hitchMultiplier = 2.0;
+		m_minHitchTime = 1.0 / 30.0;
+		this->ResetStatistics();
+
 	}
 
 	GameTimer::~GameTimer()
@@ -30,45 +86,221 @@ namespace Kiwi
 
 		if(m_started == false) return;
 
-		static double timeSinceFixedUpdate = 0.0;
-		static double elapsedTime = 0.0;
-		static int lastFPSFrame = 0; //stores the frame count when the fps was last calculated
-		//static double FPSTimer = 0.0;
-
 		//update the main timer
 		this->_Tick();
 
-		elapsedTime += m_frameTime;
-		timeSinceFixedUpdate += m_frameTime;
-		m_doFixedUpdate = false;
 		m_deltaTime = (float)m_frameTime;
+		m_fixedDeltaTime = (float)m_oneOverTUPS;
 
-		/*if deltaTime was less than the current fixedDeltaTime, set fixedDeltaTime to equal deltaTime*/
-		if( m_fixedDeltaTime < m_deltaTime )
+		/*every fixed update simulates exactly one fixed step, run as many as fit into the time that has passed
+		and carry the remainder over to the next frame*/
+		m_fixedAccumulator += m_frameTime;
+		m_fixedSteps = (int)(m_fixedAccumulator / m_oneOverTUPS);
+		m_fixedAccumulator -= m_fixedSteps * m_oneOverTUPS;
+
+		if( m_fixedSteps > m_maxFixedSteps )
+		{
+			/*the frame took longer than the fixed step budget, drop the time that can't be simulated
+			so that a long frame doesn't cause even longer frames trying to catch up*/
+			m_fixedSteps = m_maxFixedSteps;
+		}
+
+		m_doFixedUpdate = (m_fixedSteps > 0);
+		m_interpolationAlpha = (float)(m_fixedAccumulator / m_oneOverTUPS);
+
+		/*calculates the current FPS and fixed updates per second once per second*/
+		m_rateTimer += m_frameTime;
+		m_rateFrameCount++;
+		m_rateFixedStepCount += m_fixedSteps;
+		if( m_rateTimer >= 1.0 )
 		{
-			m_fixedDeltaTime = m_deltaTime;
-			m_fixedUpdatesPerSecond = (int)(1.0 / m_frameTime);
+			m_framesPerSecond = m_rateFrameCount;
+			m_fixedUpdatesPerSecond = m_rateFixedStepCount;
+			m_rateTimer = std::fmod( m_rateTimer, 1.0 );
+			m_rateFrameCount = 0;
+			m_rateFixedStepCount = 0;
+		}
+
+		this->_UpdateStatistics();
+
+	}
+
+	void GameTimer::_UpdateStatistics()
+	{
+
+		unsigned long long now = Kiwi::Profiler::Now();
+
+		if( !m_statisticsStarted )
+		{
+			//the first update only marks the start of the first frame
+			m_statisticsStarted = true;
+			m_frameStartStamp = now;
+			return;
+		}
+
+		double frameTime = m_frameTime * 1000.0;
+		unsigned int windowFrames = (unsigned int)std::min<unsigned long long>( m_statisticsFrameCount, m_statisticsWindow );
+
+		//the hitch threshold comes from the frames before this one
+		double median = this->_GetHistogramPercentile( 0.5 );
+
+		//the frame replaces the oldest frame in the window
+		unsigned int slot = (unsigned int)(m_statisticsFrameCount % m_statisticsWindow);
+		if( m_statisticsFrameCount >= m_statisticsWindow )
+		{
+			m_frameHistogram[HistogramBucket( m_frameHistory[slot] )]--;
+		}
+		m_frameHistory[slot] = frameTime;
+		m_frameHistogram[HistogramBucket( frameTime )]++;
+
+		//per stage breakdown from the zones that started during the frame
+		m_frameZones.clear();
+#ifdef KIWI_PROFILER
+		if( Kiwi::Profiler::IsEnabled() )
+		{
+			Kiwi::Profiler::Collect( m_frameStartStamp, now, m_frameZones );
+		}
+#endif
+
+		std::fill( m_stageTotals.begin(), m_stageTotals.end(), 0.0 );
+		for( auto itr = m_frameZones.begin(); itr != m_frameZones.end(); itr++ )
+		{
+			unsigned int stage = this->_GetStage( itr->name );
+			m_stageTotals[stage] += (double)(itr->end - itr->start) / 1000000.0;
+		}
+
+		for( size_t i = 0; i < m_stages.size(); i++ )
+		{
+			m_stages[i].samples[slot] = m_stageTotals[i];
+		}
+
+		m_statisticsFrameCount++;
+		m_frameStartStamp = now;
+
+		if( windowFrames >= std::min( MinHitchFrames, m_statisticsWindow ) && frameTime > median * m_hitchMultiplier && frameTime > m_minHitchTime * 1000.0 )
+		{
+			m_hitchCount++;
+			this->_LogHitch( frameTime, median );
+		}
+
+	}
+
+	unsigned int GameTimer::_GetStage( const char* name )
+	{
+
+		auto itr = m_stageByPointer.find( name );
+		if( itr != m_stageByPointer.end() )
+		{
+			return itr->second;
+		}
+
+		//the same zone name can be a different literal in each translation unit, those share one stage
+		unsigned int stage = 0;
+		auto nameItr = m_stageByName.find( name );
+		if( nameItr != m_stageByName.end() )
+		{
+			stage = nameItr->second;
 
 		} else
 		{
-			m_fixedDeltaTime = (float)m_oneOverTUPS;
-			m_fixedUpdatesPerSecond = m_targetUpdatesPerSecond;
+			stage = (unsigned int)m_stages.size();
+
+			Stage newStage;
+			newStage.name = name;
+			newStage.samples.assign( m_statisticsWindow, 0.0 );
+			m_stages.push_back( newStage );
+			m_stageTotals.push_back( 0.0 );
+
+			m_stageByName[name] = stage;
+		}
+
+		m_stageByPointer[name] = stage;
+
+		return stage;
+
+	}
+
+	double GameTimer::_GetHistogramPercentile( double percentile )const
+	{
+
+		unsigned int frames = (unsigned int)std::min<unsigned long long>( m_statisticsFrameCount, m_statisticsWindow );
+		if( frames == 0 ) return 0.0;
+
+		unsigned int target = (unsigned int)std::ceil( percentile * frames );
+		if( target < 1 ) target = 1;
+
+		unsigned int seen = 0;
+		for( unsigned int i = 0; i < HistogramBucketCount; i++ )
+		{
+			seen += m_frameHistogram[i];
+			if( seen >= target )
+			{
+				return (i + 1) * HistogramBucketSize;
+			}
 		}
 
-		/*if enough time has passed, it is time to do a fixed update*/
-		if( timeSinceFixedUpdate >= m_fixedDeltaTime )
+		//the percentile is past the end of the histogram, the longest frame is the closest known value
+		return *std::max_element( m_frameHistory.begin(), m_frameHistory.begin() + frames );
+
+	}
+
+	void GameTimer::_LogHitch( double frameTime, double median )
+	{
+
+		//group the zones by thread with every zone following its parent
+		std::sort( m_frameZones.begin(), m_frameZones.end(), []( const Kiwi::ProfileEvent& a, const Kiwi::ProfileEvent& b )
+		{
+			if( a.threadIndex != b.threadIndex ) return a.threadIndex < b.threadIndex;
+			if( a.start != b.start ) return a.start < b.start;
+			return a.depth < b.depth;
+		} );
+
+		//one entry per line, the text is only built by the logging thread (or the log decoder in binary mode)
+		KIWI_LOG( _Logger, L"Hitch: frame {} took {} ms, the median frame time is {} ms", m_statisticsFrameCount - 1, frameTime, median );
+
+		unsigned int thread = ~0u;
+		for( auto itr = m_frameZones.begin(); itr != m_frameZones.end(); itr++ )
 		{
-			m_doFixedUpdate = true;
-			timeSinceFixedUpdate -= m_fixedDeltaTime;
+			if( itr->threadIndex != thread )
+			{
+				thread = itr->threadIndex;
+				KIWI_LOG( _Logger, L"\t[{}]", Kiwi::Profiler::GetThreadName( thread ) );
+			}
+
+			KIWI_LOG( _Logger, L"\t\t{}{}: {} ms", std::string( itr->depth * 2, ' ' ), itr->name, (double)(itr->end - itr->start) / 1000000.0 );
 		}
 
-		/*calculates the current FPS once per second*/
-		if( elapsedTime >= 1.0 )
+	}
+
+	void GameTimer::_CalculateStatistics( const std::vector<double>& samples, unsigned int count, Kiwi::FrameTimeStatistics& statistics )
+	{
+
+		statistics.frameCount = count;
+		statistics.average = statistics.p50 = statistics.p95 = statistics.p99 = statistics.max = 0.0;
+		if( count == 0 ) return;
+
+		std::vector<double> sorted( samples.begin(), samples.begin() + count );
+		std::sort( sorted.begin(), sorted.end() );
+
+		double total = 0.0;
+		for( auto itr = sorted.begin(); itr != sorted.end(); itr++ )
 		{
-			m_framesPerSecond = m_frameCount - lastFPSFrame;
-			elapsedTime -= 1.0;
-			lastFPSFrame = m_frameCount;
+			total += *itr;
 		}
+
+		//nearest rank percentiles
+		auto percentile = [&sorted]( double p )
+		{
+			size_t rank = (size_t)std::ceil( p * sorted.size() );
+			return sorted[(rank > 0) ? rank - 1 : 0];
+		};
+
+		statistics.average = total / count;
+		statistics.p50 = percentile( 0.5 );
+		statistics.p95 = percentile( 0.95 );
+		statistics.p99 = percentile( 0.99 );
+		statistics.max = sorted.back();
+
 	}
 
 	void GameTimer::SetTargetUpdatesPerSecond(int updatesPerSecond)
@@ -83,6 +315,120 @@ namespace Kiwi
 		}
 
 		m_oneOverTUPS = 1.0/(double)m_targetUpdatesPerSecond;
+		m_fixedDeltaTime = (float)m_oneOverTUPS;
+
+	}
+
+	void GameTimer::SetMaxFixedSteps( int maxSteps )
+	{
+
+		m_maxFixedSteps = (maxSteps < 1) ? 1 : maxSteps;
+
+	}
+
+	void GameTimer::SetStatisticsWindow( unsigned int frames )
+	{
+
+		m_statisticsWindow = (frames < 1) ? 1 : frames;
+		this->ResetStatistics();
+
+	}
+
+	void GameTimer::ResetStatistics()
+	{
+
+		m_frameHistory.assign( m_statisticsWindow, 0.0 );
+		m_frameHistogram.assign( HistogramBucketCount + 1, 0 );
+		m_statisticsFrameCount = 0;
+
+		m_stages.clear();
+		m_stageByPointer.clear();
+		m_stageByName.clear();
+		m_stageTotals.clear();
+
+		m_hitchCount = 0;
+
+	}
+
+	void GameTimer::SetHitchThreshold( double medianMultiplier, double minimumTime )
+	{
+
+		m_hitchMultiplier = medianMultiplier;
+		m_minHitchTime = minimumTime;
+
+	}
+
+	Kiwi::FrameTimeStatistics GameTimer::GetFrameTimeStatistics()const
+	{
+
+		Kiwi::FrameTimeStatistics statistics;
+		statistics.frameCount = (unsigned int)std::min<unsigned long long>( m_statisticsFrameCount, m_statisticsWindow );
+		statistics.average = statistics.p50 = statistics.p95 = statistics.p99 = statistics.max = 0.0;
+		if( statistics.frameCount == 0 ) return statistics;
+
+		double total = 0.0;
+		for( unsigned int i = 0; i < statistics.frameCount; i++ )
+		{
+			total += m_frameHistory[i];
+			statistics.max = std::max( statistics.max, m_frameHistory[i] );
+		}
+
+		statistics.average = total / statistics.frameCount;
+
+		//the histogram rounds up, which can overshoot the longest frame
+		statistics.p50 = std::min( this->_GetHistogramPercentile( 0.5 ), statistics.max );
+		statistics.p95 = std::min( this->_GetHistogramPercentile( 0.95 ), statistics.max );
+		statistics.p99 = std::min( this->_GetHistogramPercentile( 0.99 ), statistics.max );
+
+		return statistics;
+
+	}
+
+	std::vector<Kiwi::FrameStageStatistics> GameTimer::GetStageStatistics()const
+	{
+
+		unsigned int frames = (unsigned int)std::min<unsigned long long>( m_statisticsFrameCount, m_statisticsWindow );
+
+		std::vector<Kiwi::FrameStageStatistics> stages( m_stages.size() );
+		for( size_t i = 0; i < m_stages.size(); i++ )
+		{
+			stages[i].name = m_stages[i].name;
+			GameTimer::_CalculateStatistics( m_stages[i].samples, frames, stages[i].time );
+		}
+
+		std::sort( stages.begin(), stages.end(), []( const Kiwi::FrameStageStatistics& a, const Kiwi::FrameStageStatistics& b )
+		{
+			return a.time.average > b.time.average;
+		} );
+
+		return stages;
+
+	}
+
+	bool GameTimer::WriteStatistics( std::wstring file )const
+	{
+
+		std::ofstream csv( Kiwi::ToNativePath( file ).c_str(), std::ios_base::out | std::ios_base::trunc );
+		if( !csv.good() )
+		{
+			return false;
+		}
+
+		csv << std::fixed << std::setprecision( 4 );
+		csv << "stage,frames,average_ms,p50_ms,p95_ms,p99_ms,max_ms,hitches\n";
+
+		//the first row is the whole frame, followed by the profiler zones slowest first
+		WriteCSVRow( csv, "Frame time", this->GetFrameTimeStatistics() );
+		csv << "," << m_hitchCount << "\n";
+
+		std::vector<Kiwi::FrameStageStatistics> stages = this->GetStageStatistics();
+		for( auto itr = stages.begin(); itr != stages.end(); itr++ )
+		{
+			WriteCSVRow( csv, itr->name, itr->time );
+			csv << ",\n";
+		}
+
+		return csv.good();
 
 	}
 
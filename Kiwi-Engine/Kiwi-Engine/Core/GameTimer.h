@@ -2,10 +2,35 @@
 #define _KIWI_GAMETIMER_H_
 
 #include "HighResolutionTimer.h"
+#include "Profiler.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
 
 namespace Kiwi
 {
 
+	/*frame time statistics over the last GameTimer::GetStatisticsWindow() frames, all times are in milliseconds*/
+	struct FrameTimeStatistics
+	{
+		unsigned int frameCount;
+		double average;
+		double p50;
+		double p95;
+		double p99;
+		double max;
+	};
+
+	/*time spent per frame in every profiler zone with the given name
+	nested zones are also counted in their parent's stage*/
+	struct FrameStageStatistics
+	{
+		std::string name;
+		Kiwi::FrameTimeStatistics time;
+	};
+
 	class GameTimer: 
 		public Kiwi::HighResolutionTimer
 	{
@@ -14,16 +39,22 @@ namespace Kiwi
 		//stores the current FPS
 		int m_framesPerSecond;
 
-		/*the current number of fixed updates each second
-		this is equal to targetUpdatesPerSecond unless the current
-		framerate is lower than that, in which case this value equals the frame rate*/
+		/*the number of fixed updates that ran during the last second
+		this is equal to targetUpdatesPerSecond unless the fixed step budget
+		was exceeded, in which case the simulation runs slower than real time*/
 		int m_fixedUpdatesPerSecond;
 
 		/*stores the desired number of fixed updates per second
-		if the current FPS is lower than this value then m_fixedDeltaTime = m_deltaTime
-		otherwise m_fixedDeltaTime = 1/m_targetUpdatesPerSecond*/
+		every fixed update advances the simulation by exactly 1/m_targetUpdatesPerSecond*/
 		int m_targetUpdatesPerSecond;
 
+		/*the most fixed updates that are run in a single frame
+		when a frame takes longer than m_maxFixedSteps fixed updates the rest of the time is dropped*/
+		int m_maxFixedSteps;
+
+		//the number of fixed updates to run this frame
+		int m_fixedSteps;
+
 		/*optimization to avoid a divide every frame
 		stores 1/m_targetUpdatesPerSecond*/
 		double m_oneOverTUPS;
@@ -33,12 +64,82 @@ namespace Kiwi
 		each update cycle*/
 		float m_deltaTime;
 
-		/*equal to 1/fixedUpdatesPerSecond*/
+		/*equal to 1/targetUpdatesPerSecond*/
 		float m_fixedDeltaTime;
 
+		//time that has passed but has not been simulated by a fixed update yet
+		double m_fixedAccumulator;
+
+		/*how far, from 0 to 1, the current time is between the last fixed update and the next one
+		used to blend the previous and current simulation state when rendering*/
+		float m_interpolationAlpha;
+
+		//used to calculate the frames and fixed updates per second once per second
+		double m_rateTimer;
+		int m_rateFrameCount;
+		int m_rateFixedStepCount;
+
 		//true when it's time to do a fixedupdate call
 		bool m_doFixedUpdate;
 
+		/*per frame time spent in the profiler zones with one name, stored like m_frameHistory*/
+		struct Stage
+		{
+			std::string name;
+			std::vector<double> samples;
+		};
+
+		//number of frames the statistics are kept for
+		unsigned int m_statisticsWindow;
+
+		/*ring buffer of the last frame times in milliseconds
+		frame i of m_statisticsFrameCount is at i % m_statisticsWindow*/
+		std::vector<double> m_frameHistory;
+		unsigned long long m_statisticsFrameCount;
+
+		/*rolling histogram of the frame times in m_frameHistory, the last bucket holds every frame that is
+		longer than the histogram range. lets the median be read every frame without sorting the history*/
+		std::vector<unsigned int> m_frameHistogram;
+
+		//profiler time the current frame started at, zones that start after it belong to the current frame
+		unsigned long long m_frameStartStamp;
+		bool m_statisticsStarted;
+
+		std::vector<Stage> m_stages;
+
+		//stage index by zone name. zone names are literals so the pointer is looked up first
+		std::unordered_map<const char*, unsigned int> m_stageByPointer;
+		std::map<std::string, unsigned int> m_stageByName;
+
+		//zones and per stage totals of the frame that just ended, reused every frame
+		std::vector<Kiwi::ProfileEvent> m_frameZones;
+		std::vector<double> m_stageTotals;
+
+		/*a frame is a hitch when it takes longer than m_hitchMultiplier times the median frame time
+		and at least m_minHitchTime seconds*/
+		double m_hitchMultiplier;
+		double m_minHitchTime;
+		unsigned int m_hitchCount;
+
+		//file the statistics are written to on shutdown, empty to not write them
+		std::wstring m_statisticsFile;
+
+	protected:
+
+		/*adds the frame that just ended to the statistics and checks it for a hitch*/
+		void _UpdateStatistics();
+
+		unsigned int _GetStage( const char* name );
+
+		/*returns the frame time at or below which 'percentile' (0 to 1) of the frames in the window are,
+		rounded up to the histogram bucket size*/
+		double _GetHistogramPercentile( double percentile )const;
+
+		/*logs the zones recorded during the last frame, indented by their nesting depth*/
+		void _LogHitch( double frameTime, double median );
+
+		static void _CalculateStatistics( const std::vector<double>& samples, unsigned int count, Kiwi::FrameTimeStatistics& statistics );
+
 	public:
 
 		GameTimer();
@@ -48,9 +149,13 @@ namespace Kiwi
 
 		void SetTargetUpdatesPerSecond(int updatesPerSecond);
 
+		/*sets the most fixed updates run in one frame (at least 1)*/
+		void SetMaxFixedSteps( int maxSteps );
+
 		int GetFramesPerSecond()const { return m_framesPerSecond; }
 		int GetFixedUpdatesPerSecond()const { return m_fixedUpdatesPerSecond; }
 		int GetTargetUpdatesPerSecond()const { return m_targetUpdatesPerSecond; }
+		int GetMaxFixedSteps()const { return m_maxFixedSteps; }
 
 		/*returns the total time, in seconds, since the game was started*/
 		double GetGameTime()const { return m_totalTime; }
@@ -58,15 +163,50 @@ namespace Kiwi
 		/*gets the time the last frame took to complete*/
 		float GetDeltaTime()const { return m_deltaTime; }
 
-		/*returns the current fixed frame value
-		it is equal to 1/TargetUpdatesPerSecond if greater than 
-		deltaTime and is equal to the delta time otherwise*/
+		/*returns the time each fixed update simulates, always 1/TargetUpdatesPerSecond*/
 		float GetFixedDeltaTime()const { return m_fixedDeltaTime; }
 
 		/*Call on every update cycle to determine if a FixedUpdate should occur
 		this should be called only after the Update method is called*/
 		bool QueryFixedUpdate() { return m_doFixedUpdate; }
 
+		/*returns the number of fixed updates to run this frame, between 0 and the max fixed steps*/
+		int GetFixedStepCount()const { return m_fixedSteps; }
+
+		/*returns how far the current time is between the last fixed update (0) and the next one (1)
+		rendering the previous and current fixed state blended by this value gives smooth motion
+		when the frame rate and the fixed update rate differ*/
+		float GetInterpolationAlpha()const { return m_interpolationAlpha; }
+
+		/*sets the number of frames the frame time statistics are kept for and resets the statistics*/
+		void SetStatisticsWindow( unsigned int frames );
+		unsigned int GetStatisticsWindow()const { return m_statisticsWindow; }
+
+		/*discards the frame time statistics, the stages and the hitch count*/
+		void ResetStatistics();
+
+		/*a frame is logged as a hitch, along with the zones recorded during it, when it takes longer than
+		'medianMultiplier' times the median frame time and at least 'minimumTime' seconds*/
+		void SetHitchThreshold( double medianMultiplier, double minimumTime );
+
+		/*returns the number of hitches since the statistics were last reset*/
+		unsigned int GetHitchCount()const { return m_hitchCount; }
+
+		/*returns the frame time percentiles over the statistics window
+		the percentiles are read from the frame time histogram and are rounded up to a tenth of a millisecond*/
+		Kiwi::FrameTimeStatistics GetFrameTimeStatistics()const;
+
+		/*returns the time spent per frame in each profiler zone, slowest first
+		empty when the profiler is not compiled in or is disabled*/
+		std::vector<Kiwi::FrameStageStatistics> GetStageStatistics()const;
+
+		/*writes the frame time and stage statistics to 'file' as CSV, returns false if the file could not be written*/
+		bool WriteStatistics( std::wstring file )const;
+
+		/*sets the file the statistics are written to when the engine shuts down, empty to not write them*/
+		void SetStatisticsFile( std::wstring file ) { m_statisticsFile = file; }
+		const std::wstring& GetStatisticsFile()const { return m_statisticsFile; }
+
 	};
 };
 
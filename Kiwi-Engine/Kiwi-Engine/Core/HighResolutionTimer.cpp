@@ -3,7 +3,7 @@
 #include "Math.h"
 #include "Utilities.h"
 
-#include <Windows.h>
+#include <chrono>
 
 namespace Kiwi
 {
@@ -32,14 +32,11 @@ namespace Kiwi
 
 		this->Reset();
 
-		//get the 64-bit integer containing the number of counts per second
-		LARGE_INTEGER freqCount;
-		QueryPerformanceFrequency(&freqCount);
-		m_countsPerSecond = (double)(freqCount.QuadPart);
+		//steady_clock is the performance counter on Windows and a monotonic clock everywhere else
+		m_countsPerSecond = (double)std::chrono::steady_clock::period::den / (double)std::chrono::steady_clock::period::num;
 
 		//now get the current time (in counts)
-		QueryPerformanceCounter(&freqCount);
-		m_counterStart = freqCount.QuadPart;
+		m_counterStart = (long long)std::chrono::steady_clock::now().time_since_epoch().count();
 		m_frameTimeOld = m_counterStart;
 
 		m_started = true;
@@ -83,14 +80,13 @@ namespace Kiwi
 	{
 
 		//store the time in seconds since the timer was started
-		LARGE_INTEGER currentTime;
-		QueryPerformanceCounter(&currentTime);
-		m_totalTime = (double)(currentTime.QuadPart - m_counterStart)/m_countsPerSecond;
+		long long currentTime = (long long)std::chrono::steady_clock::now().time_since_epoch().count();
+		m_totalTime = (double)(currentTime - m_counterStart)/m_countsPerSecond;
 
 		//now store the time since the last update (time since the last frame)
-		__int64 tickCount;
-		tickCount = currentTime.QuadPart - m_frameTimeOld;
-		m_frameTimeOld = currentTime.QuadPart;
+		long long tickCount;
+		tickCount = currentTime - m_frameTimeOld;
+		m_frameTimeOld = currentTime;
 
 		if(tickCount < 0)
 			tickCount = 1;
@@ -9,11 +9,11 @@ namespace Kiwi
 	protected:
 
 		double m_countsPerSecond;
-		__int64 m_counterStart;
+		long long m_counterStart;
 
 		int m_frameCount;
 
-		__int64 m_frameTimeOld;
+		long long m_frameTimeOld;
 
 		//stores the time the last frame took to complete, in seconds
 		double m_frameTime;
@@ -3,27 +3,21 @@
 namespace Kiwi
 {
 
-	int IAsset::GlobalAssetID = 1;
-	std::mutex IAsset::GlobalAssetIDMutex;
+	std::atomic<unsigned long> IAsset::GlobalAssetID( 1 );
 
 	IAsset::IAsset( std::wstring name, std::wstring assetType )
 	{
 
-		m_mutex->lock();
+		m_assetLoadState = UNLOADED;
+		m_assetName = name;
+		m_assetType = assetType;
 
-			m_assetLoadState = UNLOADED;
-			m_assetName = name;
-			m_assetType = assetType;
-
-			GlobalAssetIDMutex.lock();
-				m_assetID = GlobalAssetID++;
-				if( GlobalAssetID == 0 )
-				{
-					GlobalAssetID++;
-				}
-			GlobalAssetIDMutex.unlock();
-
-		m_mutex->unlock();
+		//0 is reserved to mean 'no ID', skip it if the counter wraps around
+		m_assetID = GlobalAssetID.fetch_add( 1, std::memory_order_relaxed );
+		while( m_assetID == 0 )
+		{
+			m_assetID = GlobalAssetID.fetch_add( 1, std::memory_order_relaxed );
+		}
 
 	}
 
@@ -1,10 +1,10 @@
 #ifndef _KIWI_IASSET_H_
 #define _KIWI_IASSET_H_
 
-#include "IThreadSafe.h"
+#include "Utilities.h"
 
 #include <string>
-#include <mutex>
+#include <atomic>
 #include <vector>
 
 namespace Kiwi
@@ -12,8 +12,8 @@ namespace Kiwi
 
 	enum ASSET_LOAD_STATE { UNLOADED = 0, LOADING, LOADED, LOAD_FAILED };
 
-	class IAsset : 
-		public IThreadSafe
+	/*assets do not carry their own mutex, classes that need to lock an asset should derive from IThreadSafe themselves*/
+	class IAsset
 	{
 	protected:
 
@@ -32,8 +32,7 @@ namespace Kiwi
 		unsigned long m_assetID;
 
 		//current ID number that will be assigned to the next asset that is created
-		static int GlobalAssetID;
-		static std::mutex GlobalAssetIDMutex;
+		static std::atomic<unsigned long> GlobalAssetID;
 
 	public:
 
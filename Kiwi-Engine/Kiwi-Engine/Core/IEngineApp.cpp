@@ -9,7 +9,9 @@ namespace Kiwi
 
 		m_engine = new Kiwi::EngineRoot();
 
+#ifndef KIWI_HEADLESS
 		m_graphicsManager = m_engine->GetGraphicsManager();
+#endif
 		m_sceneManager = m_engine->GetSceneManager();
 
 		m_engine->AddListener( this );
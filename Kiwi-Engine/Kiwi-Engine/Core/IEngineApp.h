@@ -2,8 +2,11 @@
 #define _KIWI_IENGINEAPP_H_
 
 #include "EngineRoot.h"
+#include "Platform.h"
 
+#ifndef KIWI_HEADLESS
 #include "../Graphics/IWindowEventListener.h"
+#endif
 
 namespace Kiwi
 {
@@ -11,18 +14,24 @@ namespace Kiwi
 	class EngineRoot;
 
 	class IEngineApp:
+#ifndef KIWI_HEADLESS
 		public Kiwi::IWindowEventListener,
+#endif
 		public Kiwi::IFrameEventListener
 	{
 	protected:
 
 		Kiwi::EngineRoot* m_engine;
+#ifndef KIWI_HEADLESS
 		Kiwi::GraphicsManager* m_graphicsManager;
+#endif
 		Kiwi::SceneManager* m_sceneManager;
 
 	protected:
 
+#ifndef KIWI_HEADLESS
 		virtual void OnWindowEvent( const Kiwi::WindowEvent& evt ) {}
+#endif
 		virtual void OnUpdate() {}
 		virtual void OnFixedUpdate() {}
 		virtual void OnShutdown() {}
@@ -18,6 +18,9 @@ namespace Kiwi
 		m_maxConcurrentEntities = 0;
 		m_maxSpawnCount = 0;
 
+		//spawns entities into the scene while updating
+		m_isMainThreadOnly = true;
+
 	}
 
 	IEntitySpawner::~IEntitySpawner()
@@ -1,6 +1,6 @@
 #include "IReferencedObject.h"
 
-#include <Windows.h>
+#include "Utilities.h"
 
 namespace Kiwi
 {
@@ -9,26 +9,24 @@ namespace Kiwi
 	{
 		if( m_refenceCount != 0 )
 		{
-			MessageBox( NULL, L"Referenced object was deleted with a reference count not 0", L"Error", MB_OK );
+			Kiwi::ShowError( L"Error", L"Referenced object was deleted with a reference count not 0" );
 		}
 	}
 
 	void IReferencedObject::Reserve()
 	{
 
-		std::lock_guard<std::mutex> lock( m_referenceMutex );
-
-		m_refenceCount++;
+		m_refenceCount.fetch_add( 1, std::memory_order_relaxed );
 
 	}
 
 	void IReferencedObject::Free()
 	{
 
-		std::lock_guard<std::mutex> lock( m_referenceMutex );
-		if( m_refenceCount > 0 )
+		//decrement, but never below 0
+		int count = m_refenceCount.load( std::memory_order_relaxed );
+		while( count > 0 && !m_refenceCount.compare_exchange_weak( count, count - 1, std::memory_order_release, std::memory_order_relaxed ) )
 		{
-			m_refenceCount--;
 		}
 
 	}
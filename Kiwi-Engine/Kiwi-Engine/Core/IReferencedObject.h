@@ -1,18 +1,18 @@
 #ifndef _KIWI_IREFERENCEDOBJECT_H_
 #define _KIWI_IREFERENCEDOBJECT_H_
 
-#include <mutex>
+#include <atomic>
 
 namespace Kiwi
 {
 
+	/*reference counted object. the count is a lock-free atomic so that reserving and freeing
+	from multiple threads is safe without giving every object its own mutex*/
 	class IReferencedObject
 	{
 	protected:
 
-		std::mutex m_referenceMutex;
-
-		int m_refenceCount;
+		std::atomic<int> m_refenceCount;
 
 	public:
 
@@ -31,7 +31,7 @@ namespace Kiwi
 		void Free();
 
 		/*returns the current reference count*/
-		int GetReferenceCount()const { return m_refenceCount; }
+		int GetReferenceCount()const { return m_refenceCount.load( std::memory_order_acquire ); }
 
 	};
 }
@@ -5,17 +5,16 @@ namespace Kiwi
 
 	IThreadSafe::~IThreadSafe()
 	{
-		SAFE_DELETE( m_mutex );
 	}
 
 	void IThreadSafe::MutexLock()
 	{
-		if( m_mutex ) m_mutex->lock();
+		m_mutex.lock();
 	}
 
 	void IThreadSafe::MutexUnlock()
 	{
-		if( m_mutex ) m_mutex->unlock();
+		m_mutex.unlock();
 	}
 
 }
\ No newline at end of file
@@ -8,18 +8,17 @@
 namespace Kiwi
 {
 
+	/*opt-in locking for objects that are shared between threads (scenes, the renderer)
+	the mutex is stored inline instead of being allocated on the heap for every instance*/
 	class IThreadSafe
 	{
 	public:
 
-		std::mutex* m_mutex;
+		std::mutex m_mutex;
 
 	public:
 
-		IThreadSafe()
-		{
-			m_mutex = new std::mutex();
-		}
+		IThreadSafe() {}
 
 		virtual ~IThreadSafe() = 0;
 
@@ -0,0 +1,441 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+
+namespace Kiwi
+{
+
+	thread_local Kiwi::JobSystem* JobSystem::CurrentSystem = 0;
+	thread_local unsigned int JobSystem::CurrentWorker = 0;
+
+	JobSystem::JobSystem( unsigned int threadCount )
+	{
+
+		m_queuedJobs = 0;
+		m_queuedBackgroundJobs = 0;
+		m_sleepingWaiters = 0;
+		m_shutdown = false;
+
+		if( threadCount == 0 )
+		{
+			//hardware_concurrency may return 0 if the core count is unknown
+			unsigned int coreCount = std::thread::hardware_concurrency();
+			threadCount = (coreCount > 1) ? coreCount - 1 : 1;
+		}
+
+		for( unsigned int i = 0; i < threadCount; i++ )
+		{
+			m_workerQueues.push_back( std::unique_ptr<JobQueue>( new JobQueue() ) );
+		}
+
+		for( unsigned int i = 0; i < threadCount; i++ )
+		{
+			m_threads.push_back( std::thread( &JobSystem::_WorkerMain, this, i ) );
+		}
+
+	}
+
+	JobSystem::~JobSystem()
+	{
+
+		{
+			std::lock_guard<std::mutex> lock( m_sleepMutex );
+			m_shutdown = true;
+		}
+		m_wakeCondition.notify_all();
+
+		for( unsigned int i = 0; i < m_threads.size(); i++ )
+		{
+			m_threads[i].join();
+		}
+
+	}
+
+	void JobSystem::_WorkerMain( unsigned int workerIndex )
+	{
+
+		CurrentSystem = this;
+		CurrentWorker = workerIndex;
+
+		KIWI_PROFILE_THREAD( "Worker " + std::to_string( workerIndex ) );
+
+		std::shared_ptr<Kiwi::Job> job;
+
+		while( true )
+		{
+			if( this->_TryPop( job, true ) )
+			{
+				this->_Execute( job );
+				job.reset();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock( m_sleepMutex );
+			if( m_shutdown && m_queuedJobs == 0 && m_queuedBackgroundJobs == 0 )
+			{
+				break;
+			}
+			m_wakeCondition.wait( lock, [this]() { return m_shutdown || m_queuedJobs > 0 || m_queuedBackgroundJobs > 0; } );
+		}
+
+		CurrentSystem = 0;
+
+	}
+
+	void JobSystem::_Enqueue( const std::shared_ptr<Kiwi::Job>& job )
+	{
+
+		if( job->type == JOB_BACKGROUND )
+		{
+			{
+				std::lock_guard<std::mutex> lock( m_backgroundQueue.mutex );
+				m_backgroundQueue.jobs.push_back( job );
+			}
+			m_queuedBackgroundJobs++;
+
+			//waiting threads ignore background jobs, so wake everyone to make sure a worker gets it
+			{
+				std::lock_guard<std::mutex> lock( m_sleepMutex );
+			}
+			m_wakeCondition.notify_all();
+			return;
+		}
+
+		JobQueue& queue = (CurrentSystem == this) ? *m_workerQueues[CurrentWorker] : m_sharedQueue;
+		{
+			std::lock_guard<std::mutex> lock( queue.mutex );
+			queue.jobs.push_back( job );
+		}
+		m_queuedJobs++;
+
+		{
+			std::lock_guard<std::mutex> lock( m_sleepMutex );
+		}
+		m_wakeCondition.notify_one();
+
+	}
+
+	bool JobSystem::_TryPop( std::shared_ptr<Kiwi::Job>& job, bool allowBackground )
+	{
+
+		if( m_queuedJobs > 0 )
+		{
+			unsigned int queueCount = (unsigned int)m_workerQueues.size();
+			unsigned int first = 0;
+
+			//a worker runs its own newest job first, that is the one most likely to still be in its cache
+			if( CurrentSystem == this )
+			{
+				JobQueue& queue = *m_workerQueues[CurrentWorker];
+				std::lock_guard<std::mutex> lock( queue.mutex );
+				if( queue.jobs.size() > 0 )
+				{
+					job = queue.jobs.back();
+					queue.jobs.pop_back();
+					m_queuedJobs--;
+					return true;
+				}
+				first = CurrentWorker + 1;
+			}
+
+			{
+				std::lock_guard<std::mutex> lock( m_sharedQueue.mutex );
+				if( m_sharedQueue.jobs.size() > 0 )
+				{
+					job = m_sharedQueue.jobs.front();
+					m_sharedQueue.jobs.pop_front();
+					m_queuedJobs--;
+					return true;
+				}
+			}
+
+			//steal the oldest job of another worker
+			for( unsigned int i = 0; i < queueCount; i++ )
+			{
+				JobQueue& queue = *m_workerQueues[(first + i) % queueCount];
+				std::lock_guard<std::mutex> lock( queue.mutex );
+				if( queue.jobs.size() > 0 )
+				{
+					job = queue.jobs.front();
+					queue.jobs.pop_front();
+					m_queuedJobs--;
+					return true;
+				}
+			}
+		}
+
+		if( allowBackground && m_queuedBackgroundJobs > 0 )
+		{
+			std::lock_guard<std::mutex> lock( m_backgroundQueue.mutex );
+			if( m_backgroundQueue.jobs.size() > 0 )
+			{
+				job = m_backgroundQueue.jobs.front();
+				m_backgroundQueue.jobs.pop_front();
+				m_queuedBackgroundJobs--;
+				return true;
+			}
+		}
+
+		return false;
+
+	}
+
+	void JobSystem::_Execute( const std::shared_ptr<Kiwi::Job>& job )
+	{
+
+		try
+		{
+			job->function();
+
+		} catch( ... )
+		{
+			job->exception = std::current_exception();
+		}
+
+		//release anything captured by the function as soon as it has run
+		job->function = nullptr;
+
+		this->_Finish( job );
+
+	}
+
+	void JobSystem::_Finish( const std::shared_ptr<Kiwi::Job>& job )
+	{
+
+		std::vector<std::shared_ptr<Kiwi::Job>> continuations;
+		{
+			std::lock_guard<std::mutex> lock( job->continuationMutex );
+			job->finished = true;
+			continuations.swap( job->continuations );
+		}
+
+		if( m_sleepingWaiters > 0 )
+		{
+			{
+				std::lock_guard<std::mutex> lock( m_sleepMutex );
+			}
+			m_wakeCondition.notify_all();
+		}
+
+		for( unsigned int i = 0; i < continuations.size(); i++ )
+		{
+			this->_ReleaseDependency( continuations[i], job->exception );
+		}
+
+	}
+
+	void JobSystem::_ReleaseDependency( const std::shared_ptr<Kiwi::Job>& job, const std::exception_ptr& dependencyException )
+	{
+
+		if( dependencyException )
+		{
+			std::lock_guard<std::mutex> lock( job->continuationMutex );
+			if( !job->exception ) job->exception = dependencyException;
+		}
+
+		if( job->dependencyCount.fetch_sub( 1 ) == 1 )
+		{
+			bool failed = false;
+			{
+				std::lock_guard<std::mutex> lock( job->continuationMutex );
+				failed = (bool)job->exception;
+			}
+
+			if( failed || !job->function )
+			{
+				//a dependency threw, skip the job and pass the exception on to its own continuations
+				//signals have no function and finish as soon as they are released
+				job->function = nullptr;
+				this->_Finish( job );
+
+			} else
+			{
+				this->_Enqueue( job );
+			}
+		}
+
+	}
+
+	Kiwi::JobHandle JobSystem::_Schedule( std::function<void()> function, const Kiwi::JobHandle* dependencies, unsigned int dependencyCount, Kiwi::JobType type )
+	{
+
+		std::shared_ptr<Kiwi::Job> job( new Kiwi::Job() );
+		job->function = std::move( function );
+		job->type = type;
+		job->finished = false;
+
+		//the extra count keeps the job from being queued before every dependency has been registered
+		job->dependencyCount = dependencyCount + 1;
+
+		for( unsigned int i = 0; i < dependencyCount; i++ )
+		{
+			const std::shared_ptr<Kiwi::Job>& dependency = dependencies[i].m_job;
+
+			bool registered = false;
+			if( dependency != 0 )
+			{
+				std::lock_guard<std::mutex> lock( dependency->continuationMutex );
+				if( !dependency->finished )
+				{
+					dependency->continuations.push_back( job );
+					registered = true;
+				}
+			}
+
+			if( !registered )
+			{
+				//the dependency has already finished
+				this->_ReleaseDependency( job, (dependency != 0) ? dependency->exception : std::exception_ptr() );
+			}
+		}
+
+		this->_ReleaseDependency( job, std::exception_ptr() );
+
+		Kiwi::JobHandle handle;
+		handle.m_job = job;
+		return handle;
+
+	}
+
+	Kiwi::JobHandle JobSystem::Schedule( std::function<void()> function, Kiwi::JobType type )
+	{
+
+		return this->_Schedule( std::move( function ), 0, 0, type );
+
+	}
+
+	Kiwi::JobHandle JobSystem::ScheduleAfter( const Kiwi::JobHandle& dependency, std::function<void()> function, Kiwi::JobType type )
+	{
+
+		return this->_Schedule( std::move( function ), &dependency, 1, type );
+
+	}
+
+	Kiwi::JobHandle JobSystem::ScheduleAfter( const std::vector<Kiwi::JobHandle>& dependencies, std::function<void()> function, Kiwi::JobType type )
+	{
+
+		return this->_Schedule( std::move( function ), (dependencies.size() > 0) ? &dependencies[0] : 0, (unsigned int)dependencies.size(), type );
+
+	}
+
+	Kiwi::JobHandle JobSystem::CreateSignal()
+	{
+
+		std::shared_ptr<Kiwi::Job> job( new Kiwi::Job() );
+		job->type = JOB_NORMAL;
+		job->finished = false;
+
+		//released by Signal
+		job->dependencyCount = 1;
+
+		Kiwi::JobHandle handle;
+		handle.m_job = job;
+		return handle;
+
+	}
+
+	void JobSystem::Signal( const Kiwi::JobHandle& signal, const std::exception_ptr& exception )
+	{
+
+		if( signal.m_job == 0 ) return;
+
+		this->_ReleaseDependency( signal.m_job, exception );
+
+	}
+
+	void JobSystem::Wait( const Kiwi::JobHandle& job )
+	{
+
+		if( job.m_job == 0 ) return;
+
+		std::shared_ptr<Kiwi::Job> pending;
+
+		while( !job.m_job->finished )
+		{
+			if( this->_TryPop( pending, false ) )
+			{
+				this->_Execute( pending );
+				pending.reset();
+				continue;
+			}
+
+			//nothing to help with, sleep until a job finishes or new work is queued
+			m_sleepingWaiters++;
+			{
+				std::unique_lock<std::mutex> lock( m_sleepMutex );
+				m_wakeCondition.wait( lock, [this, &job]() { return job.m_job->finished || m_queuedJobs > 0; } );
+			}
+			m_sleepingWaiters--;
+		}
+
+		std::exception_ptr exception;
+		{
+			std::lock_guard<std::mutex> lock( job.m_job->continuationMutex );
+			exception = job.m_job->exception;
+		}
+
+		if( exception ) std::rethrow_exception( exception );
+
+	}
+
+	void JobSystem::Wait( const std::vector<Kiwi::JobHandle>& jobs )
+	{
+
+		std::exception_ptr firstException;
+
+		for( unsigned int i = 0; i < jobs.size(); i++ )
+		{
+			try
+			{
+				this->Wait( jobs[i] );
+
+			} catch( ... )
+			{
+				if( !firstException ) firstException = std::current_exception();
+			}
+		}
+
+		if( firstException ) std::rethrow_exception( firstException );
+
+	}
+
+	bool JobSystem::RunPendingJob()
+	{
+
+		std::shared_ptr<Kiwi::Job> job;
+		if( this->_TryPop( job, false ) )
+		{
+			this->_Execute( job );
+			return true;
+		}
+
+		return false;
+
+	}
+
+	void JobSystem::ParallelFor( unsigned int count, unsigned int batchSize, const std::function<void( unsigned int, unsigned int )>& function )
+	{
+
+		if( count == 0 ) return;
+		if( batchSize == 0 ) batchSize = 1;
+
+		if( count <= batchSize )
+		{
+			function( 0, count );
+			return;
+		}
+
+		std::vector<Kiwi::JobHandle> batches;
+		batches.reserve( (count + batchSize - 1) / batchSize );
+
+		for( unsigned int begin = 0; begin < count; begin += batchSize )
+		{
+			unsigned int end = (count - begin > batchSize) ? begin + batchSize : count;
+			batches.push_back( this->Schedule( [&function, begin, end]() { function( begin, end ); } ) );
+		}
+
+		//the calling thread runs batches until all of them are done
+		this->Wait( batches );
+
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,172 @@
+#ifndef _KIWI_JOBSYSTEM_H_
+#define _KIWI_JOBSYSTEM_H_
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <memory>
+#include <atomic>
+
+namespace Kiwi
+{
+
+	enum JobType { JOB_NORMAL, JOB_BACKGROUND };
+
+	class JobSystem;
+
+	struct Job
+	{
+
+		std::function<void()> function;
+
+		Kiwi::JobType type;
+
+		/*number of unfinished dependencies, the job is queued once this reaches 0*/
+		std::atomic<int> dependencyCount;
+
+		std::atomic<bool> finished;
+
+		/*exception thrown by the job, or by one of its dependencies*/
+		std::exception_ptr exception;
+
+		/*guards 'finished' transitions and the continuation list*/
+		std::mutex continuationMutex;
+		std::vector<std::shared_ptr<Kiwi::Job>> continuations;
+
+	};
+
+	/*refers to a scheduled job, copies refer to the same job*/
+	class JobHandle
+	{
+		friend class JobSystem;
+	protected:
+
+		std::shared_ptr<Kiwi::Job> m_job;
+
+	public:
+
+		JobHandle() {}
+
+		/*returns false for a default constructed handle*/
+		bool IsValid()const { return m_job.get() != 0; }
+
+		/*returns true once the job has run, or has been skipped because a dependency threw*/
+		bool IsFinished()const { return m_job.get() == 0 || m_job->finished; }
+
+	};
+
+	/*fixed set of worker threads that run jobs from per-thread work-stealing queues
+	jobs scheduled from a worker go to the back of its own queue, which it runs newest first. idle workers steal the oldest
+	jobs from the other queues. jobs scheduled from any other thread go to a shared queue
+
+	JOB_BACKGROUND jobs (asset loading, other long or blocking work) are only ever run by the worker threads, never by a
+	thread that is waiting for another job, so waiting on a frame job can not get stuck behind them*/
+	class JobSystem
+	{
+	protected:
+
+		struct JobQueue
+		{
+			std::mutex mutex;
+			std::deque<std::shared_ptr<Kiwi::Job>> jobs;
+		};
+
+		/*the worker thread currently running, and the job system it belongs to*/
+		static thread_local Kiwi::JobSystem* CurrentSystem;
+		static thread_local unsigned int CurrentWorker;
+
+		std::vector<std::thread> m_threads;
+
+		/*one queue per worker thread*/
+		std::vector<std::unique_ptr<JobQueue>> m_workerQueues;
+
+		/*jobs scheduled from threads that are not workers*/
+		JobQueue m_sharedQueue;
+		JobQueue m_backgroundQueue;
+
+		/*number of queued, not yet started jobs*/
+		std::atomic<unsigned int> m_queuedJobs;
+		std::atomic<unsigned int> m_queuedBackgroundJobs;
+
+		/*number of threads sleeping in Wait until a job finishes*/
+		std::atomic<unsigned int> m_sleepingWaiters;
+
+		std::mutex m_sleepMutex;
+		std::condition_variable m_wakeCondition;
+
+		bool m_shutdown;
+
+	protected:
+
+		void _WorkerMain( unsigned int workerIndex );
+
+		/*adds a job whose dependencies have all finished to a queue*/
+		void _Enqueue( const std::shared_ptr<Kiwi::Job>& job );
+
+		/*pops the next job this thread should run, background jobs are only returned if 'allowBackground' is true*/
+		bool _TryPop( std::shared_ptr<Kiwi::Job>& job, bool allowBackground );
+
+		void _Execute( const std::shared_ptr<Kiwi::Job>& job );
+
+		/*marks the job as finished and releases its continuations*/
+		void _Finish( const std::shared_ptr<Kiwi::Job>& job );
+
+		/*called once for every finished dependency of the job*/
+		void _ReleaseDependency( const std::shared_ptr<Kiwi::Job>& job, const std::exception_ptr& dependencyException );
+
+		Kiwi::JobHandle _Schedule( std::function<void()> function, const Kiwi::JobHandle* dependencies, unsigned int dependencyCount, Kiwi::JobType type );
+
+	public:
+
+		/*creates 'threadCount' worker threads. if threadCount is 0 one worker is created for every core except the
+		calling thread's, there is always at least one worker*/
+		JobSystem( unsigned int threadCount = 0 );
+
+		/*runs every job that is still queued, then joins the worker threads*/
+		~JobSystem();
+
+		/*queues a job and returns its handle*/
+		Kiwi::JobHandle Schedule( std::function<void()> function, Kiwi::JobType type = JOB_NORMAL );
+
+		/*queues a job that runs once all dependencies have finished
+		if a dependency threw, the job is not run and waiting on it re-throws the dependency's exception*/
+		Kiwi::JobHandle ScheduleAfter( const Kiwi::JobHandle& dependency, std::function<void()> function, Kiwi::JobType type = JOB_NORMAL );
+		Kiwi::JobHandle ScheduleAfter( const std::vector<Kiwi::JobHandle>& dependencies, std::function<void()> function, Kiwi::JobType type = JOB_NORMAL );
+
+		/*returns a handle that is finished by calling Signal instead of by running a function
+		jobs can be scheduled after it like after any other job, e.g. to depend on work done outside the job system*/
+		Kiwi::JobHandle CreateSignal();
+
+		/*finishes a handle returned by CreateSignal, this must be called exactly once for each signal
+		if 'exception' is set, jobs scheduled after the signal are skipped and waiting on it re-throws the exception*/
+		void Signal( const Kiwi::JobHandle& signal, const std::exception_ptr& exception = std::exception_ptr() );
+
+		/*blocks until the job has finished, running other queued jobs on the calling thread while it waits
+		if the job threw, the exception is re-thrown here*/
+		void Wait( const Kiwi::JobHandle& job );
+
+		/*waits for every job in the list, then re-throws the first exception any of them threw*/
+		void Wait( const std::vector<Kiwi::JobHandle>& jobs );
+
+		/*runs one queued job on the calling thread, returns false if there was nothing to run
+		background jobs are not run*/
+		bool RunPendingJob();
+
+		/*calls function( begin, end ) for consecutive ranges of at most 'batchSize' indices covering [0, count)
+		the ranges run as jobs on the workers and the calling thread, this returns once all of them have finished*/
+		void ParallelFor( unsigned int count, unsigned int batchSize, const std::function<void( unsigned int, unsigned int )>& function );
+
+		/*returns the number of worker threads, not counting threads that help while waiting*/
+		unsigned int GetWorkerCount()const { return (unsigned int)m_threads.size(); }
+
+		/*returns true if the calling thread is one of this job system's workers*/
+		bool IsWorkerThread()const { return CurrentSystem == this; }
+
+	};
+}
+
+#endif
\ No newline at end of file
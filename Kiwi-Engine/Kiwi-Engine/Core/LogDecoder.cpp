@@ -0,0 +1,518 @@
+#include "LogDecoder.h"
+#include "Utilities.h"
+#include "Exception.h"
+
+#include <fstream>
+#include <vector>
+#include <cwchar>
+
+namespace Kiwi
+{
+
+	static bool ReadUInt32( const char*& cursor, const char* end, unsigned int& value )
+	{
+
+		if( end - cursor < 4 ) return false;
+
+		memcpy( &value, cursor, 4 );
+		cursor += 4;
+
+		return true;
+
+	}
+
+	static bool ReadStreamVarint( std::istream& input, unsigned long long& value )
+	{
+
+		value = 0;
+		for( unsigned int shift = 0; shift < 64; shift += 7 )
+		{
+			int byte = input.get();
+			if( byte == std::char_traits<char>::eof() ) return false;
+
+			value |= (unsigned long long)(byte & 0x7F) << shift;
+			if( (byte & 0x80) == 0 ) return true;
+		}
+
+		return false;
+
+	}
+
+	static bool ReadString( std::istream& input, std::string& value )
+	{
+
+		unsigned long long length = 0;
+		if( !ReadStreamVarint( input, length ) || length > 0xFFFFFFFF ) return false;
+
+		value.resize( (size_t)length );
+		return length == 0 || (bool)input.read( &value[0], length );
+
+	}
+
+	void LogDecoder::AppendVarint( std::string& output, unsigned long long value )
+	{
+
+		while( value >= 0x80 )
+		{
+			output += (char)((value & 0x7F) | 0x80);
+			value >>= 7;
+		}
+		output += (char)value;
+
+	}
+
+	void LogDecoder::AppendString( std::string& output, const std::string& value )
+	{
+
+		LogDecoder::AppendVarint( output, value.size() );
+		output += value;
+
+	}
+
+	/*returns the code point starting at text[i] and moves i past it, UTF-16 surrogate pairs are combined*/
+	static unsigned int NextCodePoint( const wchar_t* text, size_t length, size_t& i )
+	{
+
+		unsigned int codePoint = (unsigned int)text[i];
+		i++;
+
+		if( sizeof( wchar_t ) == 2 && codePoint >= 0xD800 && codePoint <= 0xDBFF && i < length )
+		{
+			unsigned int low = (unsigned int)text[i];
+			if( low >= 0xDC00 && low <= 0xDFFF )
+			{
+				codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+				i++;
+			}
+		}
+
+		return codePoint;
+
+	}
+
+	void LogDecoder::AppendString( std::string& output, const wchar_t* text, size_t length )
+	{
+
+		size_t size = 0;
+		for( size_t i = 0; i < length; )
+		{
+			unsigned int codePoint = NextCodePoint( text, length, i );
+			size += (codePoint < 0x80) ? 1 : (codePoint < 0x800) ? 2 : (codePoint < 0x10000) ? 3 : 4;
+		}
+
+		LogDecoder::AppendVarint( output, size );
+
+		for( size_t i = 0; i < length; )
+		{
+			unsigned int codePoint = NextCodePoint( text, length, i );
+			if( codePoint < 0x80 )
+			{
+				output += (char)codePoint;
+
+			} else if( codePoint < 0x800 )
+			{
+				output += (char)(0xC0 | (codePoint >> 6));
+				output += (char)(0x80 | (codePoint & 0x3F));
+
+			} else if( codePoint < 0x10000 )
+			{
+				output += (char)(0xE0 | (codePoint >> 12));
+				output += (char)(0x80 | ((codePoint >> 6) & 0x3F));
+				output += (char)(0x80 | (codePoint & 0x3F));
+
+			} else
+			{
+				output += (char)(0xF0 | (codePoint >> 18));
+				output += (char)(0x80 | ((codePoint >> 12) & 0x3F));
+				output += (char)(0x80 | ((codePoint >> 6) & 0x3F));
+				output += (char)(0x80 | (codePoint & 0x3F));
+			}
+		}
+
+	}
+
+	bool LogDecoder::ReadVarint( const char*& cursor, const char* end, unsigned long long& value )
+	{
+
+		value = 0;
+		for( unsigned int shift = 0; shift < 64 && cursor < end; shift += 7 )
+		{
+			unsigned char byte = (unsigned char)*cursor;
+			cursor++;
+
+			value |= (unsigned long long)(byte & 0x7F) << shift;
+			if( (byte & 0x80) == 0 ) return true;
+		}
+
+		return false;
+
+	}
+
+	bool LogDecoder::_AppendArgument( const char*& cursor, const char* end, std::wstring& output )
+	{
+
+		if( cursor >= end ) return false;
+
+		Kiwi::LOG_ARGUMENT type = (Kiwi::LOG_ARGUMENT)(unsigned char)*cursor;
+		cursor++;
+
+		switch( type )
+		{
+			case LOG_ARGUMENT_INT32:
+			case LOG_ARGUMENT_UINT32:
+				{
+					unsigned int value = 0;
+					if( !ReadUInt32( cursor, end, value ) ) return false;
+
+					output += (type == LOG_ARGUMENT_INT32) ? std::to_wstring( (int)value ) : std::to_wstring( value );
+					return true;
+				}
+			case LOG_ARGUMENT_INT64:
+			case LOG_ARGUMENT_UINT64:
+				{
+					if( end - cursor < 8 ) return false;
+
+					unsigned long long value = 0;
+					memcpy( &value, cursor, 8 );
+					cursor += 8;
+
+					output += (type == LOG_ARGUMENT_INT64) ? std::to_wstring( (long long)value ) : std::to_wstring( value );
+					return true;
+				}
+			case LOG_ARGUMENT_DOUBLE:
+				{
+					if( end - cursor < 8 ) return false;
+
+					double value = 0.0;
+					memcpy( &value, cursor, 8 );
+					cursor += 8;
+
+					//the same as a stream's default formatting
+					wchar_t buffer[64];
+					swprintf( buffer, 64, L"%g", value );
+					output += buffer;
+					return true;
+				}
+			case LOG_ARGUMENT_BOOL:
+				{
+					if( end - cursor < 1 ) return false;
+
+					output += (*cursor != 0) ? L"1" : L"0";
+					cursor++;
+					return true;
+				}
+			case LOG_ARGUMENT_WSTRING:
+				{
+					unsigned int length = 0;
+					if( !ReadUInt32( cursor, end, length ) ) return false;
+					if( (size_t)(end - cursor) / sizeof( wchar_t ) < length ) return false;
+
+					size_t start = output.size();
+					output.resize( start + length );
+					if( length > 0 )
+					{
+						memcpy( &output[start], cursor, length * sizeof( wchar_t ) );
+					}
+					cursor += length * sizeof( wchar_t );
+					return true;
+				}
+			case LOG_ARGUMENT_STRING:
+				{
+					unsigned int length = 0;
+					if( !ReadUInt32( cursor, end, length ) ) return false;
+					if( (size_t)(end - cursor) < length ) return false;
+
+					output += Kiwi::s2ws( std::string( cursor, length ) );
+					cursor += length;
+					return true;
+				}
+			case LOG_ARGUMENT_VARINT:
+				{
+					unsigned long long value = 0;
+					if( !LogDecoder::ReadVarint( cursor, end, value ) ) return false;
+
+					//zigzag encoded, the lowest bit is the sign
+					output += std::to_wstring( (long long)(value >> 1) ^ -(long long)(value & 1) );
+					return true;
+				}
+			case LOG_ARGUMENT_VARUINT:
+				{
+					unsigned long long value = 0;
+					if( !LogDecoder::ReadVarint( cursor, end, value ) ) return false;
+
+					output += std::to_wstring( value );
+					return true;
+				}
+			case LOG_ARGUMENT_UTF8:
+				{
+					unsigned long long length = 0;
+					if( !LogDecoder::ReadVarint( cursor, end, length ) ) return false;
+					if( (unsigned long long)(end - cursor) < length ) return false;
+
+					output += Kiwi::s2ws( std::string( cursor, (size_t)length ) );
+					cursor += length;
+					return true;
+				}
+			default: return false;
+		}
+
+	}
+
+	bool LogDecoder::FormatRecord( const std::wstring& format, const char* arguments, size_t size, std::wstring& output )
+	{
+
+		const char* cursor = arguments;
+		const char* end = arguments + size;
+
+		size_t i = 0;
+		while( i < format.size() )
+		{
+			if( format[i] == L'{' && i + 1 < format.size() && format[i + 1] == L'}' && cursor < end )
+			{
+				if( !LogDecoder::_AppendArgument( cursor, end, output ) )
+				{
+					return false;
+				}
+				i += 2;
+
+			} else
+			{
+				output += format[i];
+				i++;
+			}
+		}
+
+		return true;
+
+	}
+
+	bool LogDecoder::ConvertArguments( const char* arguments, size_t size, std::string& output )
+	{
+
+		const char* cursor = arguments;
+		const char* end = arguments + size;
+
+		while( cursor < end )
+		{
+			Kiwi::LOG_ARGUMENT type = (Kiwi::LOG_ARGUMENT)(unsigned char)*cursor;
+			const char* start = cursor;
+			cursor++;
+
+			switch( type )
+			{
+				case LOG_ARGUMENT_INT32:
+				case LOG_ARGUMENT_INT64:
+					{
+						long long value = 0;
+						if( type == LOG_ARGUMENT_INT32 )
+						{
+							int value32 = 0;
+							if( end - cursor < 4 ) return false;
+							memcpy( &value32, cursor, 4 );
+							value = value32;
+
+						} else
+						{
+							if( end - cursor < 8 ) return false;
+							memcpy( &value, cursor, 8 );
+						}
+						cursor += (type == LOG_ARGUMENT_INT32) ? 4 : 8;
+
+						//small negative numbers stay small
+						output += (char)LOG_ARGUMENT_VARINT;
+						LogDecoder::AppendVarint( output, ((unsigned long long)value << 1) ^ (unsigned long long)(value >> 63) );
+						break;
+					}
+				case LOG_ARGUMENT_UINT32:
+				case LOG_ARGUMENT_UINT64:
+					{
+						unsigned long long value = 0;
+						size_t size = (type == LOG_ARGUMENT_UINT32) ? 4 : 8;
+						if( (size_t)(end - cursor) < size ) return false;
+						memcpy( &value, cursor, size );
+						cursor += size;
+
+						output += (char)LOG_ARGUMENT_VARUINT;
+						LogDecoder::AppendVarint( output, value );
+						break;
+					}
+				case LOG_ARGUMENT_DOUBLE:
+				case LOG_ARGUMENT_BOOL:
+					{
+						size_t size = (type == LOG_ARGUMENT_DOUBLE) ? 8 : 1;
+						if( (size_t)(end - cursor) < size ) return false;
+						cursor += size;
+
+						output.append( start, cursor - start );
+						break;
+					}
+				case LOG_ARGUMENT_WSTRING:
+					{
+						unsigned int length = 0;
+						if( !ReadUInt32( cursor, end, length ) ) return false;
+						if( (size_t)(end - cursor) / sizeof( wchar_t ) < length ) return false;
+
+						//the characters may not be aligned in the arguments
+						wchar_t buffer[256];
+						const wchar_t* text = (const wchar_t*)cursor;
+						std::wstring copy;
+						if( length <= 256 )
+						{
+							memcpy( buffer, cursor, length * sizeof( wchar_t ) );
+							text = buffer;
+
+						} else
+						{
+							copy.assign( length, L'\0' );
+							memcpy( &copy[0], cursor, length * sizeof( wchar_t ) );
+							text = copy.c_str();
+						}
+						cursor += length * sizeof( wchar_t );
+
+						output += (char)LOG_ARGUMENT_UTF8;
+						LogDecoder::AppendString( output, text, length );
+						break;
+					}
+				case LOG_ARGUMENT_STRING:
+					{
+						//already UTF-8
+						unsigned int length = 0;
+						if( !ReadUInt32( cursor, end, length ) ) return false;
+						if( (size_t)(end - cursor) < length ) return false;
+
+						output += (char)LOG_ARGUMENT_UTF8;
+						LogDecoder::AppendVarint( output, length );
+						output.append( cursor, length );
+						cursor += length;
+						break;
+					}
+				default: return false;
+			}
+		}
+
+		return true;
+
+	}
+
+	unsigned int LogDecoder::Decode( std::istream& input, std::ostream& output )
+	{
+
+		const char* started = "=============================================\n"
+			"               Logging Started\n"
+			"=============================================\n";
+
+		const char* ended = "=============================================\n"
+			"                Logging Ended\n"
+			"=============================================\n";
+
+		char magic[LOG_FILE_MAGIC_SIZE];
+		if( !input.read( magic, LOG_FILE_MAGIC_SIZE ) || memcmp( magic, LOG_FILE_MAGIC, LOG_FILE_MAGIC_SIZE ) != 0 )
+		{
+			throw Kiwi::Exception( L"LogDecoder::Decode", L"The input is not a binary log" );
+		}
+
+		output << started;
+
+		//format IDs are only valid until the next logger opens the file
+		std::vector<std::wstring> formats;
+		std::string bytes;
+		std::wstring text;
+		unsigned int messageCount = 0;
+
+		int type = 0;
+		while( (type = input.get()) != std::char_traits<char>::eof() )
+		{
+			if( type == LOG_FILE_MAGIC[0] )
+			{
+				if( !input.read( magic + 1, LOG_FILE_MAGIC_SIZE - 1 ) || memcmp( magic + 1, LOG_FILE_MAGIC + 1, LOG_FILE_MAGIC_SIZE - 1 ) != 0 )
+				{
+					break;
+				}
+
+				formats.clear();
+				output << started;
+				continue;
+			}
+
+			bool valid = true;
+			text.clear();
+
+			switch( type )
+			{
+				case LOG_RECORD_FORMAT:
+					{
+						unsigned long long id = 0;
+						valid = ReadStreamVarint( input, id ) && id < 0x100000 && ReadString( input, bytes );
+						if( valid )
+						{
+							if( id >= formats.size() ) formats.resize( id + 1 );
+							formats[id] = Kiwi::s2ws( bytes );
+						}
+						break;
+					}
+				case LOG_RECORD_MESSAGE:
+					{
+						unsigned long long id = 0;
+						valid = ReadStreamVarint( input, id ) && ReadString( input, bytes );
+						if( valid )
+						{
+							std::wstring format = (id < formats.size()) ? formats[id] : L"<unknown format " + std::to_wstring( id ) + L">";
+							if( !LogDecoder::FormatRecord( format, bytes.data(), bytes.size(), text ) )
+							{
+								text += L" <malformed arguments>";
+							}
+							output << Kiwi::ws2s( text ) << '\n';
+							messageCount++;
+						}
+						break;
+					}
+				case LOG_RECORD_TEXT:
+					{
+						valid = ReadString( input, bytes );
+						if( valid )
+						{
+							output << bytes << '\n';
+							messageCount++;
+						}
+						break;
+					}
+				case LOG_RECORD_END:
+					{
+						output << ended;
+						break;
+					}
+				default: valid = false;
+			}
+
+			if( !valid )
+			{
+				//a log that was cut off, e.g. because the program crashed
+				output << "<the rest of the log is unreadable>\n";
+				break;
+			}
+		}
+
+		return messageCount;
+
+	}
+
+	unsigned int LogDecoder::DecodeFile( const std::wstring& binaryLog, const std::wstring& textLog )
+	{
+
+		std::ifstream input( Kiwi::ToNativePath( binaryLog ).c_str(), std::ios_base::in | std::ios_base::binary );
+		if( !input.good() )
+		{
+			throw Kiwi::Exception( L"LogDecoder::DecodeFile", L"Failed to open '" + binaryLog + L"'" );
+		}
+
+		std::ofstream output( Kiwi::ToNativePath( textLog ).c_str(), std::ios_base::out | std::ios_base::binary );
+		if( !output.good() )
+		{
+			throw Kiwi::Exception( L"LogDecoder::DecodeFile", L"Failed to open '" + textLog + L"'" );
+		}
+
+		return LogDecoder::Decode( input, output );
+
+	}
+
+};
\ No newline at end of file
@@ -0,0 +1,68 @@
+#ifndef _KIWI_LOGDECODER_H_
+#define _KIWI_LOGDECODER_H_
+
+#include "Logger.h"
+
+#include <string>
+#include <istream>
+#include <ostream>
+
+namespace Kiwi
+{
+
+	/*written at the start of a binary log each time a logger opens it*/
+	static const char LOG_FILE_MAGIC[] = "KIWILOG1";
+	static const size_t LOG_FILE_MAGIC_SIZE = 8;
+
+	/*records of a binary log, each starts with its type as a single byte. IDs and sizes are stored as variable length
+	integers (7 bits per byte, least significant first, the high bit is set on all but the last byte) and strings as
+	their size followed by UTF-8 text
+
+	LOG_RECORD_FORMAT: format ID, format string. written before the first message with the format
+	LOG_RECORD_MESSAGE: format ID, size of the arguments, the arguments (see Kiwi::LOG_ARGUMENT)
+	LOG_RECORD_TEXT: string, a message that was logged as text
+	LOG_RECORD_END: the logger was shut down*/
+	enum LOG_RECORD
+	{
+		LOG_RECORD_FORMAT = 1,
+		LOG_RECORD_MESSAGE,
+		LOG_RECORD_TEXT,
+		LOG_RECORD_END
+	};
+
+	/*turns formatted messages and binary logs back into text*/
+	class LogDecoder
+	{
+	protected:
+
+		/*appends the next argument as text and moves 'cursor' past it, returns false if the argument is malformed*/
+		static bool _AppendArgument( const char*& cursor, const char* end, std::wstring& output );
+
+	public:
+
+		/*appends the message built from the format and the encoded arguments to 'output', each {} in the format is
+		replaced with the next argument. returns false if the arguments are malformed*/
+		static bool FormatRecord( const std::wstring& format, const char* arguments, size_t size, std::wstring& output );
+
+		/*appends the arguments to 'output' in the compact form they are stored in binary logs, integers are stored as
+		variable length integers and strings as UTF-8. returns false if the arguments are malformed*/
+		static bool ConvertArguments( const char* arguments, size_t size, std::string& output );
+
+		/*reads a binary log and writes it as UTF-8 text, returns the number of messages
+		throws a Kiwi::Exception if the input isn't a binary log*/
+		static unsigned int Decode( std::istream& input, std::ostream& output );
+
+		static unsigned int DecodeFile( const std::wstring& binaryLog, const std::wstring& textLog );
+
+		static void AppendVarint( std::string& output, unsigned long long value );
+		static void AppendString( std::string& output, const std::string& value );
+
+		/*appends the text as its UTF-8 size followed by the UTF-8 text, without allocating temporary strings*/
+		static void AppendString( std::string& output, const wchar_t* text, size_t length );
+
+		static bool ReadVarint( const char*& cursor, const char* end, unsigned long long& value );
+
+	};
+};
+
+#endif
\ No newline at end of file
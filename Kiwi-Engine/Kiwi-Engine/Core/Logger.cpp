@@ -1,28 +1,69 @@
 #include "Logger.h"
+#include "LogDecoder.h"
 #include "Utilities.h"
 
-#include <Windows.h>
 #include <iostream>
 #include <fstream>
+#include <chrono>
 
 namespace Kiwi
 {
 
+	//number of messages that can wait for the output thread before logging threads have to wait
+	static const size_t LOGGER_RING_SIZE = 8192;
+
+	//the formats registered by KIWI_LOG, the ID of a format is its index + 1
+	static std::mutex& FormatMutex()
+	{
+
+		static std::mutex mutex;
+		return mutex;
+
+	}
+
+	static std::vector<std::wstring>& Formats()
+	{
+
+		static std::vector<std::wstring> formats;
+		return formats;
+
+	}
+
 	Logger::Logger()
 	{
 		m_shutdownThread = false;
 		m_initialized = false;
+		m_outputWaiting = false;
+		m_binary = false;
+
+		m_flushCharacters = 64 * 1024;
+		m_flushMilliseconds = 100;
+
+		m_ring.reset( new Slot[LOGGER_RING_SIZE] );
+		m_ringMask = LOGGER_RING_SIZE - 1;
+		m_enqueuePosition = 0;
+		m_dequeuePosition = 0;
+
+		for( size_t i = 0; i < LOGGER_RING_SIZE; i++ )
+		{
+			m_ring[i].sequence.store( i, std::memory_order_relaxed );
+			m_ring[i].format = 0;
+		}
 	}
 
 	Logger::~Logger()
 	{
 
+		//a joinable thread terminates the process when destroyed
+		this->Shutdown();
+
 	}
 
 	void Logger::Initialize(std::wstring logFile)
 	{
 
-		//start the logging thread
+		//start the logging thread, the logger can be initialized again after a shutdown
+		m_shutdownThread = false;
 		m_outputThread = std::thread(&Logger::_OutputThread, this, logFile);
 
 		m_filename = logFile;
@@ -34,73 +75,368 @@ namespace Kiwi
 	void Logger::Shutdown()
 	{
 
+		m_initialized = false;
+
 		//tell the thread to shutdown once it's finished writing
-		m_outputStrings_mutex.lock();
+		{
+			std::lock_guard<std::mutex> lock( m_outputMutex );
 			m_shutdownThread = true;
-		m_outputStrings_mutex.unlock();
+		}
+		m_outputCondition.notify_one();
 
 		//wait for the thread to finish, and close it
-		m_outputThread.join();
+		if( m_outputThread.joinable() )
+		{
+			m_outputThread.join();
+		}
+
+	}
+
+	void Logger::SetFlushThreshold( size_t characters, unsigned int milliseconds )
+	{
+
+		m_flushCharacters = characters;
+		m_flushMilliseconds = milliseconds;
+
+	}
+
+	unsigned int Logger::RegisterFormat( const std::wstring& format )
+	{
+
+		std::lock_guard<std::mutex> lock( FormatMutex() );
+
+		Formats().push_back( format );
+		return (unsigned int)Formats().size();
+
+	}
+
+	std::wstring Logger::GetFormat( unsigned int format )
+	{
+
+		std::lock_guard<std::mutex> lock( FormatMutex() );
+
+		if( format == 0 || format > Formats().size() )
+		{
+			return L"";
+		}
+
+		return Formats()[format - 1];
+
+	}
+
+	void Logger::_EncodeValue( std::string& output, Kiwi::LOG_ARGUMENT type, const void* value, size_t size )
+	{
+
+		output += (char)type;
+		output.append( (const char*)value, size );
+
+	}
+
+	void Logger::_EncodeString( std::string& output, Kiwi::LOG_ARGUMENT type, const void* characters, size_t length, size_t characterSize )
+	{
+
+		unsigned int length32 = (unsigned int)length;
+
+		output += (char)type;
+		output.append( (const char*)&length32, 4 );
+		output.append( (const char*)characters, length * characterSize );
+
+	}
+
+	Logger::Slot* Logger::_TryClaim( size_t& position )
+	{
+
+		position = m_enqueuePosition.load( std::memory_order_relaxed );
+		Slot* slot = 0;
+
+		while( true )
+		{
+			slot = &m_ring[position & m_ringMask];
+			size_t sequence = slot->sequence.load( std::memory_order_acquire );
+			ptrdiff_t difference = (ptrdiff_t)sequence - (ptrdiff_t)position;
+
+			if( difference == 0 )
+			{
+				//the slot is free, claim it
+				if( m_enqueuePosition.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) )
+				{
+					break;
+				}
+
+			} else if( difference < 0 )
+			{
+				//the output thread hasn't read the message a full ring ago yet
+				return 0;
+
+			} else
+			{
+				//another thread claimed the slot
+				position = m_enqueuePosition.load( std::memory_order_relaxed );
+			}
+		}
+
+		return slot;
+
+	}
+
+	Logger::Slot* Logger::_Claim( size_t& position )
+	{
+
+		Slot* slot = 0;
+		while( (slot = this->_TryClaim( position )) == 0 )
+		{
+			if( !m_initialized ) return 0;
+
+			//the ring is full, make sure the output thread is emptying it
+			this->_WakeOutputThread();
+			std::this_thread::yield();
+		}
+
+		return slot;
+
+	}
+
+	void Logger::_Push( const std::wstring& message )
+	{
+
+		size_t position = 0;
+		Slot* slot = this->_Claim( position );
+		if( slot == 0 ) return;
+
+		slot->format = 0;
+		slot->text.assign( message );
+
+		this->_Publish( slot, position );
+
+	}
+
+	void Logger::_Publish( Slot* slot, size_t position )
+	{
+
+		slot->sequence.store( position + 1, std::memory_order_release );
+
+		//pairs with the output thread setting m_outputWaiting before it checks for messages
+		std::atomic_thread_fence( std::memory_order_seq_cst );
+		if( m_outputWaiting.load() )
+		{
+			this->_WakeOutputThread();
+		}
+
+	}
+
+	Logger::Slot* Logger::_Peek()
+	{
+
+		Slot& slot = m_ring[m_dequeuePosition & m_ringMask];
+		if( slot.sequence.load( std::memory_order_acquire ) != m_dequeuePosition + 1 )
+		{
+			return 0;
+		}
+
+		return &slot;
+
+	}
+
+	void Logger::_Release( Slot* slot )
+	{
+
+		//hand the slot back to the logging threads for the next time around the ring
+		slot->sequence.store( m_dequeuePosition + LOGGER_RING_SIZE, std::memory_order_release );
+		m_dequeuePosition++;
+
+	}
+
+	void Logger::_WriteMessage( Slot& slot, std::wstring& textBatch, std::string& binaryBatch, std::vector<std::wstring>& formats )
+	{
+
+		//formats are looked up once per output thread
+		bool newFormat = false;
+		if( slot.format != 0 )
+		{
+			if( slot.format >= formats.size() )
+			{
+				formats.resize( slot.format + 1 );
+			}
+
+			if( formats[slot.format].size() == 0 )
+			{
+				formats[slot.format] = Logger::GetFormat( slot.format );
+				newFormat = true;
+			}
+		}
+
+		if( m_binary == false )
+		{
+			if( slot.format == 0 )
+			{
+				textBatch.append( slot.text );
+
+			} else if( !Kiwi::LogDecoder::FormatRecord( formats[slot.format], slot.arguments.data(), slot.arguments.size(), textBatch ) )
+			{
+				textBatch.append( L" <malformed arguments>" );
+			}
+
+			textBatch += L'\n';
+			return;
+		}
+
+		if( slot.format == 0 )
+		{
+			binaryBatch += (char)LOG_RECORD_TEXT;
+			Kiwi::LogDecoder::AppendString( binaryBatch, slot.text.c_str(), slot.text.size() );
+			return;
+		}
+
+		if( newFormat )
+		{
+			binaryBatch += (char)LOG_RECORD_FORMAT;
+			Kiwi::LogDecoder::AppendVarint( binaryBatch, slot.format );
+			Kiwi::LogDecoder::AppendString( binaryBatch, Kiwi::ws2s( formats[slot.format] ) );
+		}
+
+		//reused by each output thread
+		static thread_local std::string arguments;
+		arguments.clear();
+
+		if( !Kiwi::LogDecoder::ConvertArguments( slot.arguments.data(), slot.arguments.size(), arguments ) )
+		{
+			arguments.clear();
+		}
+
+		binaryBatch += (char)LOG_RECORD_MESSAGE;
+		Kiwi::LogDecoder::AppendVarint( binaryBatch, slot.format );
+		Kiwi::LogDecoder::AppendString( binaryBatch, arguments );
+
+	}
+
+	void Logger::_WakeOutputThread()
+	{
+
+		//locking makes sure the output thread is either waiting or hasn't checked for messages yet
+		std::lock_guard<std::mutex> lock( m_outputMutex );
+		m_outputCondition.notify_one();
 
 	}
 
 	void Logger::_OutputThread(std::wstring outputFileName)
 	{
 
-		std::wofstream outputFile(outputFileName.c_str(), std::ios_base::app | std::ios_base::out);
-		if(outputFile.good())
+		//the file stays open until the thread ends
+		std::wofstream outputFile;
+		std::ofstream binaryFile;
+
+		if( m_binary )
 		{
-			outputFile << "=============================================\n";
-			outputFile << "               Logging Started\n";
-			outputFile << "=============================================\n";
+			binaryFile.open(Kiwi::ToNativePath(outputFileName).c_str(), std::ios_base::app | std::ios_base::out | std::ios_base::binary);
+			if(binaryFile.good())
+			{
+				binaryFile.write( LOG_FILE_MAGIC, LOG_FILE_MAGIC_SIZE );
+				binaryFile.flush();
+			}
 
-			outputFile.close();
+		} else
+		{
+			outputFile.open(Kiwi::ToNativePath(outputFileName).c_str(), std::ios_base::app | std::ios_base::out);
+			if(outputFile.good())
+			{
+				outputFile << "=============================================\n";
+				outputFile << "               Logging Started\n";
+				outputFile << "=============================================\n";
+				outputFile.flush();
+			}
 		}
 
-		while(true)
+		//only one of the batches is used, depending on the mode
+		std::wstring textBatch;
+		std::string binaryBatch;
+		if( m_binary )
 		{
+			binaryBatch.reserve( m_flushCharacters + 1024 );
 
-			bool shutdown = false;
-			unsigned int size = 0;
-			std::wstring output = L"";
+		} else
+		{
+			textBatch.reserve( m_flushCharacters + 1024 );
+		}
 
-			m_outputStrings_mutex.lock();
+		//the formats seen by this thread, indexed by ID
+		std::vector<std::wstring> formats;
 
-				size = m_outputStrings.size();
-				if(size > 0)
-				{
-					output = m_outputStrings.front();
-					m_outputStrings.pop_front();
-				}
-				shutdown = m_shutdownThread;
+		auto lastFlush = std::chrono::steady_clock::now();
+		std::chrono::milliseconds flushInterval( m_flushMilliseconds );
 
-			m_outputStrings_mutex.unlock();
+		while(true)
+		{
+
+			bool shutdown = m_shutdownThread.load();
 
-			if(size == 0)
+			unsigned int count = 0;
+			Slot* slot = 0;
+			while( textBatch.size() + binaryBatch.size() < m_flushCharacters && (slot = this->_Peek()) != 0 )
 			{
-				Sleep(1);
-				if(shutdown)
+				this->_WriteMessage( *slot, textBatch, binaryBatch, formats );
+				this->_Release( slot );
+				count++;
+			}
+
+			size_t batchSize = textBatch.size() + binaryBatch.size();
+
+			auto now = std::chrono::steady_clock::now();
+			if( batchSize > 0 && (shutdown || batchSize >= m_flushCharacters || now - lastFlush >= flushInterval) )
+			{
+				if(outputFile.good() && textBatch.size() > 0)
 				{
-					break;
-				}else
+					outputFile << textBatch;
+					outputFile.flush();
+				}
+
+				if(binaryFile.good() && binaryBatch.size() > 0)
 				{
-					continue;
+					binaryFile.write( binaryBatch.data(), binaryBatch.size() );
+					binaryFile.flush();
 				}
-			}else if(output.compare(L"") != 0)
+
+				textBatch.clear();
+				binaryBatch.clear();
+				lastFlush = now;
+				continue;
+			}
+
+			if( count > 0 )
 			{
-				outputFile.open(outputFileName.c_str(), std::ios_base::app | std::ios_base::out);
-				if(outputFile.good())
-				{
+				continue;
+			}
 
-					outputFile << output;
+			if( shutdown )
+			{
+				//messages logged after the shutdown flag was read have been written above
+				break;
+			}
 
-					outputFile.close();
-				}
+			std::unique_lock<std::mutex> lock( m_outputMutex );
+
+			//set before checking for messages again, a message written after the check sees it and wakes the thread up
+			m_outputWaiting = (batchSize == 0);
+
+			if( this->_Peek() != 0 || m_shutdownThread.load() )
+			{
+				m_outputWaiting = false;
+				continue;
+			}
+
+			if( batchSize == 0 )
+			{
+				//nothing to write until a new message arrives
+				m_outputCondition.wait( lock );
+				m_outputWaiting = false;
+
+			} else
+			{
+				//new messages are collected without waking the thread up until the batch is due
+				m_outputCondition.wait_until( lock, lastFlush + flushInterval );
 			}
 
 		}
 
-		outputFile.open(outputFileName.c_str(), std::ios_base::app | std::ios_base::out);
 		if(outputFile.good())
 		{
 
@@ -111,6 +447,13 @@ namespace Kiwi
 			outputFile.close();
 		}
 
+		if(binaryFile.good())
+		{
+			char end = (char)LOG_RECORD_END;
+			binaryFile.write( &end, 1 );
+			binaryFile.close();
+		}
+
 	}
 
 };
\ No newline at end of file
@@ -2,38 +2,175 @@
 #define _KIWI_LOGGER_H_
 
 #include <string>
-#include <Windows.h>
 #include <sstream>
 #include <mutex>
+#include <condition_variable>
 #include <thread>
-#include <deque>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstring>
+#include <cwchar>
+
+/*logs a message built from a format string and arguments, each {} in the format is replaced with the next argument
+the format is registered once per call site, logging only copies the format's ID and the argument values into the log.
+the text is built by the output thread, or in binary mode by Kiwi::LogDecoder when the log is read. the format must be a
+string literal*/
+#define KIWI_LOG( logger, format, ... ) \
+	do \
+	{ \
+		static const unsigned int _kiwiLogFormat = Kiwi::Logger::RegisterFormat( format ); \
+		(logger).LogFormat( _kiwiLogFormat, ##__VA_ARGS__ ); \
+	} while( 0 )
 
 namespace Kiwi
 {
 
+	/*type of an argument of a formatted message, stored in front of the argument's value*/
+	enum LOG_ARGUMENT
+	{
+		LOG_ARGUMENT_INT32 = 1,
+		LOG_ARGUMENT_UINT32,
+		LOG_ARGUMENT_INT64,
+		LOG_ARGUMENT_UINT64,
+		LOG_ARGUMENT_DOUBLE,
+		LOG_ARGUMENT_BOOL,
+		//32 bit length in characters followed by the characters. only used in memory, log files store UTF-8 strings
+		LOG_ARGUMENT_WSTRING,
+		//32 bit length in bytes followed by UTF-8 text
+		LOG_ARGUMENT_STRING,
+
+		//the compact forms binary log files store the arguments in, see Kiwi::LogDecoder
+		//zigzag encoded variable length integer
+		LOG_ARGUMENT_VARINT,
+		//variable length unsigned integer
+		LOG_ARGUMENT_VARUINT,
+		//variable length size in bytes followed by UTF-8 text
+		LOG_ARGUMENT_UTF8
+	};
+
+	/*writes messages to a log file on a separate thread
+
+	messages are formatted on the logging thread and handed to the output thread through a lock free ring buffer
+	that any number of threads can write to. the output thread keeps the file open and writes the messages in batches,
+	once enough text has been collected or the oldest message has waited long enough
+
+	in binary mode formatted messages are written as their format ID and argument values, and the formats once per log.
+	Kiwi::LogDecoder turns the file back into text*/
 	class Logger
 	{
 	private:
 
+		struct Slot
+		{
+			//equal to the slot's position when it is free and to position + 1 once a message was written to it
+			std::atomic<size_t> sequence;
+
+			//the ID of the message's format, or 0 if the message is 'text'
+			unsigned int format;
+
+			//keep their memory when the message is read, so writing to a slot stops allocating once it is large enough
+			std::wstring text;
+			std::string arguments;
+		};
+
 		std::wstring m_filename;
 
-		//array of strings waiting to be written
-		//this is shared with the output thread and locked using m_outputStrings_mutex
-		std::deque<std::wstring> m_outputStrings;
-		std::mutex m_outputStrings_mutex;
+		//ring of messages waiting to be written, the size is a power of two
+		std::unique_ptr<Slot[]> m_ring;
+		size_t m_ringMask;
+
+		//position the next message is written to, shared by all logging threads
+		std::atomic<size_t> m_enqueuePosition;
+
+		//position the output thread reads the next message from
+		size_t m_dequeuePosition;
 
 		//thread used to write the output
 		std::thread m_outputThread;
 
+		//wakes the output thread up when it is waiting for messages
+		std::mutex m_outputMutex;
+		std::condition_variable m_outputCondition;
+
+		//true while the output thread waits for a message without a timeout
+		std::atomic<bool> m_outputWaiting;
+
 		//when true the thread will end after it has finished writing its output
-		bool m_shutdownThread;
+		std::atomic<bool> m_shutdownThread;
 
-		bool m_initialized;
+		std::atomic<bool> m_initialized;
+
+		bool m_binary;
+
+		//the output thread writes to the file once this many characters are waiting, or the oldest message is this old
+		size_t m_flushCharacters;
+		unsigned int m_flushMilliseconds;
 
 	private:
 
 		void _OutputThread(std::wstring outputFile);
 
+		/*claims the next slot of the ring, returns 0 if the ring is full*/
+		Slot* _TryClaim( size_t& position );
+
+		/*waits for space in the ring if it is full, returns 0 if the logger was shut down while waiting*/
+		Slot* _Claim( size_t& position );
+
+		/*hands a claimed slot to the output thread*/
+		void _Publish( Slot* slot, size_t position );
+
+		void _Push( const std::wstring& message );
+
+		/*returns the next message for the output thread, or 0 if there is none*/
+		Slot* _Peek();
+
+		/*hands the slot returned by _Peek back to the logging threads*/
+		void _Release( Slot* slot );
+
+		void _WakeOutputThread();
+
+		/*appends the message in the slot to the text or binary batch*/
+		void _WriteMessage( Slot& slot, std::wstring& textBatch, std::string& binaryBatch, std::vector<std::wstring>& formats );
+
+		//argument encoders, an argument is written as its type followed by its value
+		static void _EncodeValue( std::string& output, Kiwi::LOG_ARGUMENT type, const void* value, size_t size );
+		static void _EncodeString( std::string& output, Kiwi::LOG_ARGUMENT type, const void* characters, size_t length, size_t characterSize );
+
+		static void _Encode( std::string& output, bool value ) { unsigned char b = value ? 1 : 0; _EncodeValue( output, LOG_ARGUMENT_BOOL, &b, 1 ); }
+		static void _Encode( std::string& output, short value ) { _Encode( output, (int)value ); }
+		static void _Encode( std::string& output, unsigned short value ) { _Encode( output, (unsigned int)value ); }
+		static void _Encode( std::string& output, int value ) { _EncodeValue( output, LOG_ARGUMENT_INT32, &value, 4 ); }
+		static void _Encode( std::string& output, unsigned int value ) { _EncodeValue( output, LOG_ARGUMENT_UINT32, &value, 4 ); }
+		static void _Encode( std::string& output, long value ) { _Encode( output, (long long)value ); }
+		static void _Encode( std::string& output, unsigned long value ) { _Encode( output, (unsigned long long)value ); }
+		static void _Encode( std::string& output, long long value ) { _EncodeValue( output, LOG_ARGUMENT_INT64, &value, 8 ); }
+		static void _Encode( std::string& output, unsigned long long value ) { _EncodeValue( output, LOG_ARGUMENT_UINT64, &value, 8 ); }
+		static void _Encode( std::string& output, float value ) { _Encode( output, (double)value ); }
+		static void _Encode( std::string& output, double value ) { _EncodeValue( output, LOG_ARGUMENT_DOUBLE, &value, 8 ); }
+		static void _Encode( std::string& output, const wchar_t* value ) { _EncodeString( output, LOG_ARGUMENT_WSTRING, value, wcslen( value ), sizeof( wchar_t ) ); }
+		static void _Encode( std::string& output, const std::wstring& value ) { _EncodeString( output, LOG_ARGUMENT_WSTRING, value.c_str(), value.size(), sizeof( wchar_t ) ); }
+		static void _Encode( std::string& output, const char* value ) { _EncodeString( output, LOG_ARGUMENT_STRING, value, strlen( value ), 1 ); }
+		static void _Encode( std::string& output, const std::string& value ) { _EncodeString( output, LOG_ARGUMENT_STRING, value.c_str(), value.size(), 1 ); }
+
+		/*any other type is formatted by a stream on the logging thread*/
+		template<typename T>
+		static void _Encode( std::string& output, const T& value )
+		{
+			std::wstringstream wstr;
+			wstr << value;
+			_Encode( output, wstr.str() );
+		}
+
+		static void _EncodeArguments( std::string& output ) {}
+
+		template<typename First, typename... Rest>
+		static void _EncodeArguments( std::string& output, const First& first, const Rest&... rest )
+		{
+			_Encode( output, first );
+			_EncodeArguments( output, rest... );
+		}
+
 	public:
 
 		Logger();
@@ -43,8 +180,29 @@ namespace Kiwi
 
 		void Shutdown();
 
+		/*sets when the output thread writes the collected messages to the file, must be called before Initialize
+		in binary mode 'characters' is the number of bytes*/
+		void SetFlushThreshold( size_t characters, unsigned int milliseconds );
+
+		/*in binary mode the log file stores formatted messages without formatting them, see Kiwi::LogDecoder
+		must be called before Initialize*/
+		void SetBinary( bool binary ) { m_binary = binary; }
+
+		bool IsBinary()const { return m_binary; }
+
 		template<typename T> void Log(const T& output);
 
+		void Log( const std::wstring& output );
+
+		/*logs a message with a format returned by RegisterFormat, use KIWI_LOG instead of calling this directly*/
+		template<typename... Args> void LogFormat( unsigned int format, const Args&... args );
+
+		/*stores the format string and returns its ID, IDs start at 1*/
+		static unsigned int RegisterFormat( const std::wstring& format );
+
+		/*returns the format string of the ID, or an empty string if there is no format with the ID*/
+		static std::wstring GetFormat( unsigned int format );
+
 	};
 
 	template<typename T> 
@@ -53,20 +211,53 @@ namespace Kiwi
 
 		if( !m_initialized ) return;
 
-		std::lock_guard<std::mutex> guard(m_outputStrings_mutex);
-
-		std::wstring msg;
-		std::wstringstream wstr;
+		//every thread formats into its own stream, no lock is held while formatting
+		static thread_local std::wstringstream wstr;
+		wstr.str( std::wstring() );
+		wstr.clear();
 		wstr << output;
-		msg = wstr.str();
 
-		msg += L"\n";
+		this->_Push( wstr.str() );
+
+	}
+
+	inline void Logger::Log( const std::wstring& output )
+	{
+
+		if( !m_initialized ) return;
+
+		this->_Push( output );
+
+	}
+
+	template<typename... Args>
+	void Logger::LogFormat( unsigned int format, const Args&... args )
+	{
 
-		if(msg.size() > 0)
+		if( !m_initialized ) return;
+
+		size_t position = 0;
+		Slot* slot = this->_Claim( position );
+		if( slot == 0 ) return;
+
+		//only the values are copied into the slot, formatting is left to the output thread
+		slot->format = format;
+		slot->arguments.clear();
+
+		try
 		{
-			m_outputStrings.push_back(msg);
+			_EncodeArguments( slot->arguments, args... );
+
+		} catch( ... )
+		{
+			//the slot has to be published or the ring would stop at it
+			slot->arguments.clear();
+			this->_Publish( slot, position );
+			throw;
 		}
 
+		this->_Publish( slot, position );
+
 	}
 
 	extern Kiwi::Logger _Logger;
@@ -1,6 +1,8 @@
 #include "Math.h"
 
+#ifndef KIWI_HEADLESS
 #include "../Graphics/DirectX.h"
+#endif
 
 #include <math.h>
 
@@ -12,6 +14,7 @@ namespace Kiwi
 		return ( round( value * (1.0 / nearest) ) * nearest);
 	}
 
+#ifndef KIWI_HEADLESS
 	void Matrix4ToXMMATRIX( const Kiwi::Matrix4& kMat, DirectX::XMMATRIX& xmMat )
 	{
 
@@ -56,6 +59,7 @@ namespace Kiwi
 		xmFloat = DirectX::XMFLOAT2( (float)kVec.x, (float)kVec.y );
 
 	}
+#endif
 
 	void ClipVector( Kiwi::Vector3d& vector, double threshold )
 	{
@@ -1,6 +1,7 @@
 #ifndef _KIWI_MATH_H_
 #define _KIWI_MATH_H_
 
+#include "Platform.h"
 #include "Vector2.h"
 #include "Vector2d.h"
 #include "Vector3.h"
@@ -74,6 +75,7 @@ namespace Kiwi
 
 	}
 
+#ifndef KIWI_HEADLESS
 	/*copies a Kiwi::Matrix4 into an XMMATRIX*/
 	void Matrix4ToXMMATRIX( const Kiwi::Matrix4& kMat, DirectX::XMMATRIX& xmMat );
 
@@ -85,6 +87,7 @@ namespace Kiwi
 
 	void Vector3dToXMFLOAT3( const Kiwi::Vector3d& kVec, DirectX::XMFLOAT3& xmFloat );
 	void Vector2dToXMFLOAT2( const Kiwi::Vector2d& kVec, DirectX::XMFLOAT2& xmFloat );
+#endif
 
 	/*if the magnitude of the vector is less than threshold, sets the vector to 0*/
 	void ClipVector( Kiwi::Vector3d& vector, double threshold );
@@ -1,6 +1,7 @@
 #include "Matrix4.h"
 
 #include <sstream>
+#include <cmath>
 
 namespace Kiwi
 {
@@ -0,0 +1,125 @@
+#include "MemoryPool.h"
+#include "Utilities.h"
+#include "Assert.h"
+
+namespace Kiwi
+{
+
+	std::atomic<unsigned long long> MemoryPool::TotalPoolAllocations( 0 );
+	std::atomic<unsigned long long> MemoryPool::TotalChunkAllocations( 0 );
+	std::atomic<unsigned long long> MemoryPool::TotalFallbackAllocations( 0 );
+
+	MemoryPool::MemoryPool( std::size_t blockSize, unsigned int blocksPerChunk )
+	{
+
+		//every block must be able to hold a free list pointer and keep the alignment of new
+		const std::size_t alignment = alignof(std::max_align_t);
+		if( blockSize < sizeof( FreeBlock ) ) blockSize = sizeof( FreeBlock );
+		m_blockSize = ((blockSize + alignment - 1) / alignment) * alignment;
+
+		m_blocksPerChunk = (blocksPerChunk > 0) ? blocksPerChunk : 1;
+		m_freeList = 0;
+
+		m_stats.allocations = 0;
+		m_stats.frees = 0;
+		m_stats.chunkAllocations = 0;
+		m_stats.liveBlocks = 0;
+		m_stats.peakBlocks = 0;
+		m_stats.capacity = 0;
+
+	}
+
+	MemoryPool::~MemoryPool()
+	{
+
+		for( auto itr = m_chunks.begin(); itr != m_chunks.end(); itr++ )
+		{
+			delete[] *itr;
+		}
+
+		Kiwi::FreeMemory( m_chunks );
+
+	}
+
+	void MemoryPool::_AllocateChunk()
+	{
+
+		char* chunk = new char[m_blockSize * m_blocksPerChunk];
+		m_chunks.push_back( chunk );
+
+		//push the blocks in reverse so they are handed out in address order
+		for( unsigned int i = m_blocksPerChunk; i > 0; i-- )
+		{
+			FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * m_blockSize);
+			block->next = m_freeList;
+			m_freeList = block;
+		}
+
+		m_stats.chunkAllocations++;
+		m_stats.capacity += m_blocksPerChunk;
+		TotalChunkAllocations++;
+
+	}
+
+	void* MemoryPool::Allocate()
+	{
+
+		std::lock_guard<std::mutex> guard( m_poolMutex );
+
+		if( m_freeList == 0 )
+		{
+			this->_AllocateChunk();
+		}
+
+		FreeBlock* block = m_freeList;
+		m_freeList = block->next;
+
+		m_stats.allocations++;
+		m_stats.liveBlocks++;
+		if( m_stats.liveBlocks > m_stats.peakBlocks ) m_stats.peakBlocks = m_stats.liveBlocks;
+		TotalPoolAllocations++;
+
+		return block;
+
+	}
+
+	void MemoryPool::Free( void* block )
+	{
+
+		if( block == 0 ) return;
+
+		std::lock_guard<std::mutex> guard( m_poolMutex );
+
+		assert( m_stats.liveBlocks > 0 );
+
+		FreeBlock* freed = static_cast<FreeBlock*>(block);
+		freed->next = m_freeList;
+		m_freeList = freed;
+
+		m_stats.frees++;
+		m_stats.liveBlocks--;
+
+	}
+
+	void MemoryPool::Reserve( unsigned int blockCount )
+	{
+
+		std::lock_guard<std::mutex> guard( m_poolMutex );
+
+		while( m_stats.capacity < blockCount )
+		{
+			this->_AllocateChunk();
+		}
+
+	}
+
+	Kiwi::MemoryPoolStats MemoryPool::GetStats()
+	{
+
+		std::lock_guard<std::mutex> guard( m_poolMutex );
+
+		return m_stats;
+
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+#ifndef _KIWI_MEMORYPOOL_H_
+#define _KIWI_MEMORYPOOL_H_
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <cstddef>
+
+/*declares class-specific operator new and delete that allocate objects of exactly this class from
+Kiwi::ObjectPool<ClassName>. objects of derived classes have a different size and fall back to the global heap
+place inside the public section of the class. only the object itself is pooled, strings and containers it owns
+still allocate from the global heap*/
+#define KIWI_DECLARE_POOLED( ClassName ) \
+		static void* operator new( std::size_t size ) { return Kiwi::ObjectPool<ClassName>::Allocate( size ); } \
+		static void operator delete( void* object, std::size_t size ) { Kiwi::ObjectPool<ClassName>::Free( object, size ); }
+
+namespace Kiwi
+{
+
+	struct MemoryPoolStats
+	{
+		unsigned long long allocations; //total number of blocks handed out
+		unsigned long long frees;
+		unsigned long long chunkAllocations; //number of times the pool had to allocate more memory from the global heap
+		unsigned int liveBlocks; //blocks currently in use
+		unsigned int peakBlocks;
+		unsigned int capacity; //total number of blocks the pool owns
+	};
+
+	/*fixed size block allocator. memory is taken from the global heap in chunks of 'blocksPerChunk' blocks,
+	freed blocks go onto a free list and are reused, and chunks are never returned to the heap.
+	once a pool has grown to its peak size, allocating and freeing does not touch the global heap*/
+	class MemoryPool
+	{
+	private:
+
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+		//totals over every pool
+		static std::atomic<unsigned long long> TotalPoolAllocations;
+		static std::atomic<unsigned long long> TotalChunkAllocations;
+		static std::atomic<unsigned long long> TotalFallbackAllocations;
+
+	protected:
+
+		std::size_t m_blockSize;
+		unsigned int m_blocksPerChunk;
+
+		FreeBlock* m_freeList;
+		std::vector<char*> m_chunks;
+
+		Kiwi::MemoryPoolStats m_stats;
+
+		std::mutex m_poolMutex;
+
+	protected:
+
+		//allocates a new chunk and adds its blocks to the free list
+		void _AllocateChunk();
+
+	public:
+
+		MemoryPool( std::size_t blockSize, unsigned int blocksPerChunk = 256 );
+		~MemoryPool();
+
+		void* Allocate();
+		void Free( void* block );
+
+		/*makes sure the pool can hand out at least 'blockCount' blocks in total without growing*/
+		void Reserve( unsigned int blockCount );
+
+		Kiwi::MemoryPoolStats GetStats();
+
+		std::size_t GetBlockSize()const { return m_blockSize; }
+
+		/*returns the number of blocks handed out by all pools*/
+		static unsigned long long GetTotalPoolAllocations() { return TotalPoolAllocations.load(); }
+
+		/*returns the number of chunks all pools have allocated, this stays flat once the pools have reached their peak size.
+		it does not count any other heap allocation, see the allocations per operation Kiwi-Benchmark reports for those*/
+		static unsigned long long GetTotalChunkAllocations() { return TotalChunkAllocations.load(); }
+
+		/*returns the number of objects of derived classes that could not use their base class's pool*/
+		static unsigned long long GetTotalFallbackAllocations() { return TotalFallbackAllocations.load(); }
+
+		/*counts an object a pooled class had to allocate from the global heap*/
+		static void CountFallbackAllocation() { TotalFallbackAllocations++; }
+
+	};
+
+	/*pool shared by all objects of type T*/
+	template<class T>
+	class ObjectPool
+	{
+	public:
+
+		static Kiwi::MemoryPool& GetPool()
+		{
+			//the pool is intentionally never destroyed, so objects freed during static destruction
+			//(after the pool's destructor would have run) are still returned safely
+			static Kiwi::MemoryPool* pool = new Kiwi::MemoryPool( sizeof( T ) );
+			return *pool;
+		}
+
+		static void* Allocate( std::size_t size )
+		{
+			if( size != sizeof( T ) )
+			{
+				Kiwi::MemoryPool::CountFallbackAllocation();
+				return ::operator new( size );
+			}
+			return GetPool().Allocate();
+		}
+
+		static void Free( void* object, std::size_t size )
+		{
+			if( object == 0 ) return;
+
+			if( size != sizeof( T ) )
+			{
+				::operator delete( object );
+				return;
+			}
+			GetPool().Free( object );
+		}
+
+		static void Reserve( unsigned int count ) { GetPool().Reserve( count ); }
+		static Kiwi::MemoryPoolStats GetStats() { return GetPool().GetStats(); }
+
+	};
+
+}
+
+#endif
\ No newline at end of file
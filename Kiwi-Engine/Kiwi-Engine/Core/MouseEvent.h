@@ -3,9 +3,8 @@
 
 #include "RawInputWrapper.h"
 
-#include "..\Core\Event.h"
+#include "../Core/Event.h"
 
-#include <Windows.h>
 
 namespace Kiwi
 {
@@ -1,7 +1,7 @@
 #ifndef _KIWI_MOUSEEVENTBROADCASTER_H_
 #define _KIWI_MOUSEEVENTBROADCASTER_H_
 
-#include "..\Core\EventBroadcaster.h"
+#include "../Core/EventBroadcaster.h"
 
 #include "IMouseEventListener.h"
 #include "MouseEvent.h"
@@ -0,0 +1,17 @@
+#ifndef _KIWI_PLATFORM_H_
+#define _KIWI_PLATFORM_H_
+
+/*KIWI_HEADLESS builds the engine without a window, a graphics device or any Windows header
+scenes, entities and physics are driven by the EngineRoot as usual and scenes render through a null renderer
+it is always defined when not building for Windows*/
+#if !defined(_WIN32) && !defined(KIWI_HEADLESS)
+#define KIWI_HEADLESS
+#endif
+
+/*KIWI_PROFILER compiles in the profiler zones (see Profiler.h). it is defined for debug builds, and for release
+builds that define KIWI_ENABLE_PROFILER. otherwise KIWI_PROFILE_ZONE expands to nothing*/
+#if !defined(KIWI_PROFILER) && (!defined(NDEBUG) || defined(KIWI_ENABLE_PROFILER))
+#define KIWI_PROFILER
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,248 @@
+#include "Profiler.h"
+#include "Utilities.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+namespace Kiwi
+{
+
+	std::mutex Profiler::m_bufferMutex;
+	std::vector<std::unique_ptr<Kiwi::ProfileThreadBuffer>> Profiler::m_buffers;
+	std::atomic<bool> Profiler::m_enabled( true );
+	unsigned int Profiler::m_bufferCapacity = 65536;
+
+	namespace
+	{
+		const std::chrono::steady_clock::time_point ProfilerEpoch = std::chrono::steady_clock::now();
+
+		thread_local Kiwi::ProfileThreadBuffer* ThreadBuffer = 0;
+
+		//writes 'text' as a JSON string
+		void WriteJSONString( std::ofstream& file, const std::string& text )
+		{
+			file << '"';
+			for( char c : text )
+			{
+				if( c == '"' || c == '\\' ) file << '\\';
+				file << c;
+			}
+			file << '"';
+		}
+	}
+
+	ProfileThreadBuffer::ProfileThreadBuffer( unsigned int threadIndex, unsigned int capacity ) :
+		m_events( capacity )
+	{
+
+		m_writeCount = 0;
+		m_clearCount = 0;
+		m_threadIndex = threadIndex;
+		m_depth = 0;
+		m_threadName = "Thread " + std::to_string( threadIndex );
+
+	}
+
+	void ProfileThreadBuffer::Record( const char* name, unsigned long long start, unsigned long long end, unsigned int depth )
+	{
+
+		unsigned long long index = m_writeCount.load( std::memory_order_relaxed );
+
+		Kiwi::ProfileEvent& evt = m_events[index % m_events.size()];
+		evt.name = name;
+		evt.start = start;
+		evt.end = end;
+		evt.depth = depth;
+		evt.threadIndex = m_threadIndex;
+
+		//publish the zone to Collect
+		m_writeCount.store( index + 1, std::memory_order_release );
+
+	}
+
+	unsigned long long Profiler::Now()
+	{
+
+		return (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - ProfilerEpoch ).count();
+
+	}
+
+	Kiwi::ProfileThreadBuffer* Profiler::GetThreadBuffer()
+	{
+
+		if( ThreadBuffer == 0 )
+		{
+			std::lock_guard<std::mutex> guard( m_bufferMutex );
+
+			m_buffers.push_back( std::unique_ptr<Kiwi::ProfileThreadBuffer>( new Kiwi::ProfileThreadBuffer( (unsigned int)m_buffers.size(), m_bufferCapacity ) ) );
+			ThreadBuffer = m_buffers.back().get();
+		}
+
+		return ThreadBuffer;
+
+	}
+
+	void Profiler::SetThreadName( const std::string& name )
+	{
+
+		Kiwi::ProfileThreadBuffer* buffer = Profiler::GetThreadBuffer();
+
+		std::lock_guard<std::mutex> guard( m_bufferMutex );
+		buffer->m_threadName = name;
+
+	}
+
+	void Profiler::SetBufferCapacity( unsigned int zoneCount )
+	{
+
+		std::lock_guard<std::mutex> guard( m_bufferMutex );
+		m_bufferCapacity = (zoneCount > 0) ? zoneCount : 1;
+
+	}
+
+	void Profiler::Collect( unsigned long long from, unsigned long long to, std::vector<Kiwi::ProfileEvent>& events )
+	{
+
+		std::lock_guard<std::mutex> guard( m_bufferMutex );
+
+		for( auto itr = m_buffers.begin(); itr != m_buffers.end(); itr++ )
+		{
+			Kiwi::ProfileThreadBuffer* buffer = itr->get();
+			unsigned long long capacity = buffer->m_events.size();
+
+			unsigned long long count = buffer->m_writeCount.load( std::memory_order_acquire );
+			unsigned long long first = (count > capacity) ? count - capacity : 0;
+			if( first < buffer->m_clearCount ) first = buffer->m_clearCount;
+
+			/*zones are recorded when they end so every buffer is sorted by end time, walk it back from the newest zone
+			and stop at the first zone that ended before 'from' (it and everything older also started before 'from').
+			this keeps collecting a single frame cheap no matter how many zones the buffers hold*/
+			size_t collectStart = events.size();
+			unsigned long long firstCollected = 0;
+			for( unsigned long long i = count; i > first; i-- )
+			{
+				const Kiwi::ProfileEvent& evt = buffer->m_events[(i - 1) % capacity];
+				if( evt.end < from ) break;
+
+				if( evt.start >= from && evt.start < to )
+				{
+					firstCollected = i - 1;
+					events.push_back( evt );
+				}
+			}
+
+			//back to recording order
+			std::reverse( events.begin() + collectStart, events.end() );
+
+			//the owning thread kept recording while the zones were copied, if it wrapped around into the copied
+			//range the copies can't be trusted and are dropped
+			unsigned long long newCount = buffer->m_writeCount.load( std::memory_order_acquire );
+			if( events.size() > collectStart && newCount > capacity && newCount - capacity > firstCollected )
+			{
+				events.resize( collectStart );
+			}
+		}
+
+	}
+
+	std::string Profiler::GetThreadName( unsigned int threadIndex )
+	{
+
+		std::lock_guard<std::mutex> guard( m_bufferMutex );
+
+		if( threadIndex < m_buffers.size() )
+		{
+			return m_buffers[threadIndex]->m_threadName;
+		}
+
+		return "Thread " + std::to_string( threadIndex );
+
+	}
+
+	bool Profiler::ExportChromeTrace( std::wstring file )
+	{
+
+		std::vector<Kiwi::ProfileEvent> events;
+		Profiler::Collect( 0, ~0ull, events );
+
+		std::ofstream trace( Kiwi::ToNativePath( file ).c_str(), std::ios_base::out | std::ios_base::trunc );
+		if( !trace.good() )
+		{
+			return false;
+		}
+
+		trace << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+		//thread names as metadata events
+		bool first = true;
+		{
+			std::lock_guard<std::mutex> guard( m_bufferMutex );
+			for( auto itr = m_buffers.begin(); itr != m_buffers.end(); itr++ )
+			{
+				trace << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << (*itr)->m_threadIndex << ",\"args\":{\"name\":";
+				WriteJSONString( trace, (*itr)->m_threadName );
+				trace << "}}";
+				first = false;
+			}
+		}
+
+		//complete events, timestamps in microseconds
+		trace << std::fixed << std::setprecision( 3 );
+		for( auto itr = events.begin(); itr != events.end(); itr++ )
+		{
+			trace << (first ? "" : ",\n") << "{\"name\":";
+			WriteJSONString( trace, itr->name );
+			trace << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << itr->threadIndex << ",\"ts\":" << (double)itr->start / 1000.0 << ",\"dur\":" << (double)(itr->end - itr->start) / 1000.0 << "}";
+			first = false;
+		}
+
+		trace << "\n]}\n";
+
+		return trace.good();
+
+	}
+
+	void Profiler::Clear()
+	{
+
+		std::lock_guard<std::mutex> guard( m_bufferMutex );
+
+		//the owning threads keep writing, the zones recorded so far are just no longer collected
+		for( auto itr = m_buffers.begin(); itr != m_buffers.end(); itr++ )
+		{
+			(*itr)->m_clearCount = (*itr)->m_writeCount.load( std::memory_order_acquire );
+		}
+
+	}
+
+	ProfileScope::ProfileScope( const char* name )
+	{
+
+		m_name = name;
+		m_buffer = 0;
+		m_start = 0;
+
+		if( Profiler::IsEnabled() )
+		{
+			m_buffer = Profiler::GetThreadBuffer();
+			m_buffer->m_depth++;
+			m_start = Profiler::Now();
+		}
+
+	}
+
+	ProfileScope::~ProfileScope()
+	{
+
+		if( m_buffer != 0 )
+		{
+			unsigned long long end = Profiler::Now();
+			m_buffer->m_depth--;
+			m_buffer->Record( m_name, m_start, end, m_buffer->m_depth );
+		}
+
+	}
+
+}
\ No newline at end of file
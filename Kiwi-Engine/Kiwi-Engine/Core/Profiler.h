@@ -0,0 +1,147 @@
+#ifndef _KIWI_PROFILER_H_
+#define _KIWI_PROFILER_H_
+
+#include "Platform.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+
+namespace Kiwi
+{
+
+	/*a finished profiler zone: a named span of time on one thread
+	times are in nanoseconds since the profiler started*/
+	struct ProfileEvent
+	{
+		const char* name;
+		unsigned long long start;
+		unsigned long long end;
+		unsigned int depth; //number of zones this zone is nested in on its thread
+		unsigned int threadIndex;
+	};
+
+	/*fixed size ring buffer holding the last zones recorded by one thread
+	only the owning thread writes to it, once full the oldest zones are overwritten*/
+	class ProfileThreadBuffer
+	{
+	friend class Profiler;
+	friend class ProfileScope;
+	protected:
+
+		std::vector<Kiwi::ProfileEvent> m_events;
+
+		//number of zones written so far, the newest zone is at (m_writeCount - 1) % capacity
+		std::atomic<unsigned long long> m_writeCount;
+
+		//value of m_writeCount at the last Profiler::Clear, older zones are not collected
+		unsigned long long m_clearCount;
+
+		unsigned int m_threadIndex;
+
+		//number of zones currently open on the thread
+		unsigned int m_depth;
+
+		std::string m_threadName;
+
+	public:
+
+		ProfileThreadBuffer( unsigned int threadIndex, unsigned int capacity );
+
+		void Record( const char* name, unsigned long long start, unsigned long long end, unsigned int depth );
+
+		unsigned int GetThreadIndex()const { return m_threadIndex; }
+		const std::string& GetThreadName()const { return m_threadName; }
+
+	};
+
+	/*collects the zones recorded with KIWI_PROFILE_ZONE on every thread
+	each thread records into its own ring buffer without locking, the buffers are only locked when a thread
+	records its first zone and when the zones are collected or exported
+
+	zones are compiled in when KIWI_PROFILER is defined (see Platform.h) and can also be switched off at runtime*/
+	class Profiler
+	{
+	protected:
+
+		static std::mutex m_bufferMutex;
+		static std::vector<std::unique_ptr<Kiwi::ProfileThreadBuffer>> m_buffers;
+
+		static std::atomic<bool> m_enabled;
+
+		static unsigned int m_bufferCapacity;
+
+	public:
+
+		/*returns the current time in nanoseconds since the profiler started*/
+		static unsigned long long Now();
+
+		/*returns the calling thread's buffer, creating it on the first call*/
+		static Kiwi::ProfileThreadBuffer* GetThreadBuffer();
+
+		/*names the calling thread in exported traces*/
+		static void SetThreadName( const std::string& name );
+
+		/*returns the name of the thread that recorded zones with the given ProfileEvent::threadIndex*/
+		static std::string GetThreadName( unsigned int threadIndex );
+
+		static void SetEnabled( bool enabled ) { m_enabled = enabled; }
+		static bool IsEnabled() { return m_enabled; }
+
+		/*sets the number of zones each thread keeps, only affects threads that have not recorded a zone yet*/
+		static void SetBufferCapacity( unsigned int zoneCount );
+
+		/*appends the zones that started in [from, to) on any thread to 'events'
+		zones that are overwritten while being collected are skipped*/
+		static void Collect( unsigned long long from, unsigned long long to, std::vector<Kiwi::ProfileEvent>& events );
+
+		/*writes every zone still held in the ring buffers to 'file' in the Chrome trace event format
+		(load it in chrome://tracing or Perfetto). returns false if the file could not be written*/
+		static bool ExportChromeTrace( std::wstring file );
+
+		/*discards all recorded zones*/
+		static void Clear();
+
+	};
+
+	/*measures the time between its construction and destruction as a zone of the calling thread
+	'name' must outlive the profiler, use string literals*/
+	class ProfileScope
+	{
+	protected:
+
+		const char* m_name;
+
+		unsigned long long m_start;
+
+		Kiwi::ProfileThreadBuffer* m_buffer;
+
+	public:
+
+		ProfileScope( const char* name );
+		~ProfileScope();
+
+	};
+};
+
+#ifdef KIWI_PROFILER
+
+#define KIWI_PROFILE_CONCAT_( a, b ) a##b
+#define KIWI_PROFILE_CONCAT( a, b ) KIWI_PROFILE_CONCAT_( a, b )
+
+/*records the rest of the enclosing scope as a zone*/
+#define KIWI_PROFILE_ZONE( name ) Kiwi::ProfileScope KIWI_PROFILE_CONCAT( _kiwiProfileScope, __LINE__ )( name )
+
+/*names the calling thread in exported traces*/
+#define KIWI_PROFILE_THREAD( name ) Kiwi::Profiler::SetThreadName( name )
+
+#else
+
+#define KIWI_PROFILE_ZONE( name )
+#define KIWI_PROFILE_THREAD( name )
+
+#endif
+
+#endif
\ No newline at end of file
@@ -1,8 +1,8 @@
 #include "Quaternion.h"
 
 #include <sstream>
+#include <cmath>
 
-#include <Windows.h>
 
 namespace Kiwi
 {
@@ -371,6 +371,21 @@ namespace Kiwi
 
 	/*Returns a quaternion q such that v1*q = v2; the quaternion that rotates v1 to v2
 	Both v1 and v2 are assumed to be normalized*/
+	Quaternion Quaternion::Nlerp(const Quaternion& from, const Quaternion& to, double t)
+	{
+
+		//q and -q are the same rotation, flip 'to' if needed so the blend takes the short way around
+		double sign = (from.Dot( to ) < 0.0) ? -1.0 : 1.0;
+
+		Quaternion result( from.w + ((to.w * sign) - from.w) * t,
+						   from.x + ((to.x * sign) - from.x) * t,
+						   from.y + ((to.y * sign) - from.y) * t,
+						   from.z + ((to.z * sign) - from.z) * t );
+
+		return result.Normalized();
+
+	}
+
 	Quaternion Quaternion::RotateTo(const Kiwi::Vector3& v1, const Kiwi::Vector3& v2)
 	{
 
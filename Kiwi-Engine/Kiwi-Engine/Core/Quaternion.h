@@ -103,6 +103,10 @@ namespace Kiwi
 		Both v1 and v2 are assumed to be normalized*/
 		static Quaternion RotateTo(const Kiwi::Vector3& v1, const Kiwi::Vector3& v2);
 
+		/*blends from 'from' (t = 0) to 'to' (t = 1) along the shortest arc and normalizes the result
+		cheaper than a slerp and close to it for the small rotations between two fixed updates*/
+		static Quaternion Nlerp(const Quaternion& from, const Quaternion& to, double t);
+
 	};
 };
 
@@ -4,8 +4,11 @@
 #define NUM_MOUSE_BUTTONS 5 //using left, right, middle, and buttons 1-5
 
 #include "Vector2.h"
+#include "Platform.h"
 
+#ifndef KIWI_HEADLESS
 #include <Windows.h>
+#endif
 #include <vector>
 
 namespace Kiwi
@@ -181,7 +184,9 @@ namespace Kiwi
 
 		void OnUpdate( float deltaTime );
 
+#ifndef KIWI_HEADLESS
 		void ProcessInput( WPARAM wParam, LPARAM lParam );
+#endif
 
 		void SetMouseSpeed( Kiwi::Vector2 speed ) { m_mouseSpeed = speed; }
 
@@ -0,0 +1,111 @@
+#ifndef _KIWI_RINGBUFFER_H_
+#define _KIWI_RINGBUFFER_H_
+
+#include <vector>
+#include <utility>
+
+namespace Kiwi
+{
+
+	/*holds up to a fixed number of items, once it is full each new item replaces the oldest one
+	items are indexed from the oldest (0) to the newest (GetSize() - 1)*/
+	template<typename T>
+	class RingBuffer
+	{
+	protected:
+
+		//grows until it holds 'capacity' items, after that the storage is reused
+		std::vector<T> m_items;
+
+		size_t m_capacity;
+
+		//position of the oldest item in m_items
+		size_t m_first;
+
+	public:
+
+		RingBuffer( size_t capacity )
+		{
+
+			m_capacity = (capacity > 0) ? capacity : 1;
+			m_first = 0;
+
+		}
+
+		/*adds the item as the newest item, returns true if the oldest item had to be removed to make room*/
+		bool Push( const T& item )
+		{
+
+			T copy( item );
+			return this->Push( std::move( copy ) );
+
+		}
+
+		bool Push( T&& item )
+		{
+
+			if( m_items.size() < m_capacity )
+			{
+				m_items.push_back( std::move( item ) );
+				return false;
+			}
+
+			m_items[m_first] = std::move( item );
+			m_first = (m_first + 1) % m_capacity;
+
+			return true;
+
+		}
+
+		/*removes all items, keeping the memory of the storage*/
+		void Clear()
+		{
+
+			m_items.clear();
+			m_first = 0;
+
+		}
+
+		/*changes the maximum number of items, if there are more items than this the oldest ones are removed*/
+		void SetCapacity( size_t capacity )
+		{
+
+			if( capacity == 0 ) capacity = 1;
+			if( capacity == m_capacity ) return;
+
+			size_t size = m_items.size();
+			size_t kept = (size < capacity) ? size : capacity;
+
+			std::vector<T> items;
+			items.reserve( kept );
+			for( size_t i = size - kept; i < size; i++ )
+			{
+				items.push_back( std::move( (*this)[i] ) );
+			}
+
+			m_items.swap( items );
+			m_capacity = capacity;
+			m_first = 0;
+
+		}
+
+		T& operator[]( size_t index ) { return m_items[(m_first + index) % m_items.size()]; }
+		const T& operator[]( size_t index )const { return m_items[(m_first + index) % m_items.size()]; }
+
+		T& Front() { return (*this)[0]; }
+		const T& Front()const { return (*this)[0]; }
+
+		T& Back() { return (*this)[m_items.size() - 1]; }
+		const T& Back()const { return (*this)[m_items.size() - 1]; }
+
+		size_t GetSize()const { return m_items.size(); }
+		size_t GetCapacity()const { return m_capacity; }
+
+		bool IsEmpty()const { return m_items.size() == 0; }
+		bool IsFull()const { return m_items.size() == m_capacity; }
+
+	};
+
+}
+
+#endif
\ No newline at end of file
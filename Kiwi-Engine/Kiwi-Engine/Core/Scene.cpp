@@ -4,21 +4,32 @@
 #include "Assert.h"
 #include "EntityManager.h"
 #include "AssetManager.h"
-#include "SceneLoader.h"
 #include "EngineRoot.h"
 #include "ITerrain.h"
 #include "Console.h"
+#include "Profiler.h"
+
+#include "../Graphics/Mesh.h"
+#include "../Graphics/Camera.h"
+#include "../Graphics/RenderQueue.h"
+#include "../Graphics/RenderSnapshot.h"
+#include "../Graphics/RenderThread.h"
+#include "../Graphics/NullRenderBackend.h"
+
+#ifndef KIWI_HEADLESS
+#include "SceneLoader.h"
 
 #include "../Graphics/Renderer.h"
 #include "../Graphics/IShader.h"
-#include "../Graphics/Mesh.h"
 #include "../Graphics/InstancedMesh.h"
 #include "../Graphics/Renderable.h"
 #include "../Graphics/RenderTargetManager.h"
-#include "../Graphics/Camera.h"
 #include "../Graphics/D3D11Interface.h"
 #include "../Graphics/DepthStencil.h"
-#include "../Graphics/RenderQueue.h"
+#include "../Graphics/RenderWindow.h"
+#endif
+
+#include <algorithm>
 
 namespace Kiwi
 {
@@ -29,15 +40,21 @@ namespace Kiwi
 
 		assert( engine != 0 );
 
+#ifndef KIWI_HEADLESS
 		if( renderer == 0 )
 		{
 			throw Kiwi::Exception( L"Scene", L"Invalid renderer" );
 		}
+#endif
 
 		m_sceneLoader = 0;
 		m_playerEntity = 0;
 		m_terrain = 0;
 		m_renderer = 0;
+		m_console = 0;
+		m_renderThread = 0;
+		m_nullBackend = 0;
+		m_renderFrame = 0;
 		m_engine = engine;
 		m_physicsSystem = m_engine->GetPhysicsSystem();
 		m_shutdown = false;
@@ -53,11 +70,13 @@ namespace Kiwi
 			m_diffuseDirection = Kiwi::Vector4( 1.0f, -1.0f, 0.0f, 0.0f );
 			m_ambientLight = Kiwi::Vector4( 0.4f, 0.4f, 0.4f, 1.0f );
 
+#ifndef KIWI_HEADLESS
 			m_sceneLoader = new Kiwi::SceneLoader( this );
 
 			//add the back buffer render target to the render target manager
 			Kiwi::RenderTarget* backBuffer = m_renderer->GetBackBuffer();
 			m_renderTargetManager.AddRenderTarget( backBuffer );
+#endif
 
 		} catch( const Kiwi::Exception& e )
 		{
@@ -69,11 +88,17 @@ namespace Kiwi
 	Scene::~Scene()
 	{
 
+		//the render thread may still be drawing meshes owned by the entities
+		SAFE_DELETE( m_renderThread );
+		SAFE_DELETE( m_nullBackend );
+
 		m_renderer = 0;
 
+#ifndef KIWI_HEADLESS
 		m_shaderContainer.DestroyAll();
 
 		SAFE_DELETE( m_sceneLoader );
+#endif
 		SAFE_DELETE( m_terrain );
 
 	}
@@ -81,24 +106,46 @@ namespace Kiwi
 	void Scene::Update()
 	{
 
+		KIWI_PROFILE_ZONE( "Scene::Update" );
+
+#ifndef KIWI_HEADLESS
 		if( m_sceneLoader != 0 )
 		{
 			m_sceneLoader->OnUpdate();
 		}
+#endif
 
 		if( m_isActive )
 		{
+			//entities destroyed this frame may still be referenced by the snapshot being drawn
+			if( m_renderThread != 0 && m_entityManager.HasPendingDestroy() )
+			{
+				KIWI_PROFILE_ZONE( "Scene::WaitForRender" );
+				m_renderThread->Wait();
+			}
+
 			//if( m_playerEntity ) m_playerEntity->Update();
 			m_entityManager.Update();
+
+			//propagate all transform changes made this frame through the hierarchy in a single pass
+			m_transformStore.UpdateHierarchy();
+
+			//then notify the transform change listeners, once per changed transform
+			m_transformStore.DispatchChanges();
 		}
 
 		this->_OnUpdate();
 
+		//global events posted this frame, from any thread
+		this->DispatchGlobalEvents();
+
 	}
 
 	void Scene::FixedUpdate()
 	{
 
+		KIWI_PROFILE_ZONE( "Scene::FixedUpdate" );
+
 		if( m_isActive )
 		{
 			//if( m_playerEntity ) m_playerEntity->FixedUpdate();
@@ -113,17 +160,121 @@ namespace Kiwi
 	void Scene::_Render()
 	{
 
+		KIWI_PROFILE_ZONE( "Scene::_Render" );
+
 		if( m_isActive )
 		{
 			std::lock_guard<std::recursive_mutex> guard( m_sceneMutex );
 
-			assert( m_renderer != 0 );
-			assert( m_engine != 0 );
+			this->_PreRender();
+			this->_GenerateRenderQueue();
+			this->_CaptureRenderSnapshot();
+			this->_Submit();
+		}
+
+	}
+
+	void Scene::_SaveFixedState()
+	{
+
+		std::lock_guard<std::recursive_mutex> guard( m_sceneMutex );
+
+		m_transformStore.SaveFixedState();
+
+	}
+
+	void Scene::_PreRender()
+	{
+
+		if( m_isActive )
+		{
+			std::lock_guard<std::recursive_mutex> guard( m_sceneMutex );
 
 			this->_OnPreRender();
+		}
+
+	}
+
+	void Scene::_GenerateRenderQueue()
+	{
+
+		if( m_isActive )
+		{
+			std::lock_guard<std::recursive_mutex> guard( m_sceneMutex );
 
 			m_entityManager.ClearRenderQueue();
-			Kiwi::RenderQueue* renderQueue = m_entityManager.GenerateRenderQueue();
+			m_entityManager.GenerateRenderQueue();
+		}
+
+	}
+
+	void Scene::_CaptureRenderSnapshot()
+	{
+
+		if( m_isActive && m_renderThread != 0 )
+		{
+			std::lock_guard<std::recursive_mutex> guard( m_sceneMutex );
+
+			Kiwi::RenderQueue* renderQueue = m_entityManager.GetRenderQueue();
+			Kiwi::RenderSnapshot& snapshot = m_renderThread->GetCaptureSnapshot();
+
+			snapshot.Begin( this, m_renderFrame++, m_engine->GetGameTimer()->GetInterpolationAlpha() );
+
+#ifndef KIWI_HEADLESS
+			//viewport cameras first, the first camera is the one transparent meshes are sorted against
+			Kiwi::RenderTargetList rtList = m_renderTargetManager.GetRenderTargetList();
+			for( auto itr = rtList.targets.begin(); itr != rtList.targets.end(); itr++ )
+			{
+				for( unsigned int i = 0; i < (*itr)->GetViewportCount(); i++ )
+				{
+					snapshot.CaptureViewport( *itr, (*itr)->GetViewport( i ), renderQueue->GetDefaultRenderGroupID() );
+				}
+			}
+#endif
+
+			for( auto itr = m_cameras.begin(); itr != m_cameras.end(); itr++ )
+			{
+				if( (*itr)->IsActive() && !(*itr)->IsShutdown() )
+				{
+					snapshot.CaptureCamera( *itr );
+				}
+			}
+
+			snapshot.CaptureQueue( *renderQueue );
+		}
+
+	}
+
+	void Scene::_Submit()
+	{
+
+		if( m_isActive && m_renderThread != 0 )
+		{
+			std::lock_guard<std::recursive_mutex> guard( m_sceneMutex );
+
+			//meshes the capture had to skip are reported here, on the main thread
+			Kiwi::Console* console = m_engine->GetConsole();
+			const std::vector<std::wstring>& captureErrors = m_renderThread->GetCaptureSnapshot().GetCaptureErrors();
+			for( unsigned int i = 0; i < captureErrors.size() && console != 0; i++ )
+			{
+				console->PrintDebug( captureErrors[i] );
+			}
+
+			//the render thread draws the snapshot while the next frame is simulated
+			m_renderThread->Submit();
+
+			this->_OnPostRender();
+
+		} else if( m_isActive )
+		{
+			std::lock_guard<std::recursive_mutex> guard( m_sceneMutex );
+
+			assert( m_engine != 0 );
+
+#ifndef KIWI_HEADLESS
+			assert( m_renderer != 0 );
+
+			Kiwi::RenderQueue* renderQueue = m_entityManager.GetRenderQueue();
 
 			//get a list of all render targets, sorted by lowest to highest priority (back to front), and render them all
 			Kiwi::RenderTargetList rtList = m_renderTargetManager.GetRenderTargetList();
@@ -136,6 +287,7 @@ namespace Kiwi
 			}
 
 			m_renderer->Present();
+#endif
 
 			this->_OnPostRender();
 		}
@@ -157,18 +309,83 @@ namespace Kiwi
 
 		m_console = console;
 
+#ifndef KIWI_HEADLESS
 		if( m_console && this->GetRenderWindow() )
 		{
 			Kiwi::Vector2d dim( this->GetRenderWindow()->GetClientSize().x - 40, (int)((double)this->GetRenderWindow()->GetClientSize().y / 2.16) );
 			Kiwi::Vector3d pos( 0.0, ((double)this->GetRenderWindow()->GetClientSize().y / 2.0) - ((dim.y / 2) + 20.0), 10000.0 );
 			m_console->InitializeInterface( *this, L"Lato_20pt", dim, pos );
 		}
+#endif
+
+	}
+
+	void Scene::SetRenderThreadEnabled( bool enable, Kiwi::IRenderBackend* backend )
+	{
+
+		std::lock_guard<std::recursive_mutex> guard( m_sceneMutex );
+
+		//stopping finishes the frame that is being drawn
+		SAFE_DELETE( m_renderThread );
+
+		if( !enable ) return;
+
+		if( backend == 0 )
+		{
+#ifndef KIWI_HEADLESS
+			backend = m_renderer;
+#endif
+			if( backend == 0 )
+			{
+				if( m_nullBackend == 0 )
+				{
+					m_nullBackend = new Kiwi::NullRenderBackend();
+				}
+				backend = m_nullBackend;
+			}
+		}
+
+		m_renderThread = new Kiwi::RenderThread( backend );
+
+	}
+
+	void Scene::WaitForRender()
+	{
+
+		if( m_renderThread != 0 )
+		{
+			m_renderThread->Wait();
+		}
+
+	}
+
+	void Scene::_RegisterCamera( Kiwi::Camera* camera )
+	{
+
+		std::lock_guard<std::recursive_mutex> guard( m_sceneMutex );
+
+		m_cameras.push_back( camera );
+
+	}
+
+	void Scene::_UnregisterCamera( Kiwi::Camera* camera )
+	{
+
+		//called while the entity manager destroys its entities, which can be during the scene's destruction
+		auto itr = std::find( m_cameras.begin(), m_cameras.end(), camera );
+		if( itr != m_cameras.end() )
+		{
+			m_cameras.erase( itr );
+		}
 
 	}
 
 	void Scene::Shutdown()
 	{
 
+		//stop drawing before the entities are shut down
+		this->SetRenderThreadEnabled( false );
+
 		this->_OnShutdown();
 
 		m_entityManager.ShutdownAll();
@@ -219,6 +436,7 @@ namespace Kiwi
 
 	}
 
+#ifndef KIWI_HEADLESS
 	void Scene::AddShader( Kiwi::IShader* shader )
 	{
 
@@ -229,6 +447,7 @@ namespace Kiwi
 		}
 
 	}
+#endif
 
 	Kiwi::Entity* Scene::CreateEntity( std::wstring name )
 	{
@@ -293,12 +512,16 @@ namespace Kiwi
 	Kiwi::RenderWindow* Scene::GetRenderWindow()
 	{
 		
+#ifndef KIWI_HEADLESS
 		if( m_renderer == 0 )
 		{
 			return 0;
 		}
 
 		return m_renderer->GetRenderWindow();
+#else
+		return 0;
+#endif
 
 	}
 
@@ -309,6 +532,20 @@ namespace Kiwi
 
 	}
 
+	Kiwi::Entity* Scene::FindEntityWithName( Kiwi::StringId name )
+	{
+
+		return m_entityManager.FindWithName( name );
+
+	}
+
+	Kiwi::Entity* Scene::FindEntity( Kiwi::EntityHandle handle )
+	{
+
+		return m_entityManager.GetEntity( handle );
+
+	}
+
 	std::vector<Kiwi::Entity*> Scene::FindEntitiesWithTag( std::wstring tag )
 	{
 
@@ -316,11 +553,20 @@ namespace Kiwi
 
 	}
 
+	std::vector<Kiwi::Entity*> Scene::FindEntitiesWithTag( Kiwi::StringId tag )
+	{
+
+		return m_entityManager.FindAllWithTag( tag );
+
+	}
+
+#ifndef KIWI_HEADLESS
 	Kiwi::RenderTarget* Scene::FindRenderTargetWithName( std::wstring name )
 	{
 
 		return m_renderTargetManager.FindRenderTargetWithName( name );
 
 	}
+#endif
 
 };
\ No newline at end of file
@@ -2,17 +2,21 @@
 #define _KIWI_SCENE_H_
 
 #include "EntityManager.h"
+#include "TransformStore.h"
 #include "IThreadSafe.h"
 #include "Assert.h"
 #include "AssetManager.h"
 #include "Vector4.h"
 #include "IFrameEventListener.h"
 #include "ComponentContainer.h"
+#include "Platform.h"
 
-#include "Events\IGlobalEventBroadcaster.h"
+#include "Events/IGlobalEventBroadcaster.h"
 
+#ifndef KIWI_HEADLESS
 #include "../Graphics/RenderTargetManager.h"
 #include "../Graphics/IShader.h"
+#endif
 
 #include <string>
 #include <vector>
@@ -32,12 +36,16 @@ namespace Kiwi
 	class PhysicsSystem;
 	class RenderWindow;
 	class Console;
+	class RenderThread;
+	class IRenderBackend;
+	class NullRenderBackend;
 
 	class Scene :
 		public Kiwi::IThreadSafe,
 		public Kiwi::IGlobalEventBroadcaster
 	{
 	friend class SceneManager;
+	friend class Camera;
 
 	protected:
 
@@ -49,7 +57,18 @@ namespace Kiwi
 
 		Kiwi::PhysicsSystem* m_physicsSystem;
 
+#ifndef KIWI_HEADLESS
 		Kiwi::RenderTargetManager m_renderTargetManager;
+#endif
+
+		//cameras in the scene, registered by the cameras themselves. declared before the entity manager so the
+		//cameras can unregister while the entity manager destroys them
+		std::vector<Kiwi::Camera*> m_cameras;
+
+		//stores the data of every transform in the scene. must be declared before the entity manager
+		//so that it outlives the entities (and their transforms)
+		Kiwi::TransformStore m_transformStore;
+
 		Kiwi::EntityManager m_entityManager;
 		Kiwi::AssetManager m_assetManager;
 
@@ -58,8 +77,10 @@ namespace Kiwi
 		//stores the player's entity for easy retrieval
 		Kiwi::Entity* m_playerEntity;
 
+#ifndef KIWI_HEADLESS
 		//contains all of the scene's shaders, sorted by name
 		Kiwi::ComponentContainer<std::wstring, Kiwi::IShader> m_shaderContainer;
+#endif
 
 		Kiwi::Console* m_console;
 
@@ -71,6 +92,15 @@ namespace Kiwi
 
 		std::recursive_mutex m_sceneMutex;
 
+		//draws the scene one frame behind the simulation while render thread mode is enabled, 0 otherwise
+		Kiwi::RenderThread* m_renderThread;
+
+		//backend used in render thread mode when the scene has no renderer of its own
+		Kiwi::NullRenderBackend* m_nullBackend;
+
+		//index of the next captured render snapshot
+		unsigned long long m_renderFrame;
+
 		bool m_shutdown;
 		bool m_isActive;
 
@@ -79,8 +109,23 @@ namespace Kiwi
 		/*renders the back buffer*/
 		void _Render();
 
+		/*the stages of _Render, they can be run as separate frame tasks. _GenerateRenderQueue and _CaptureRenderSnapshot
+		only read the scene and can run on a worker thread, the others call into game code and the renderer
+		in render thread mode _CaptureRenderSnapshot copies the render queue into a snapshot and _Submit hands it to the
+		render thread instead of rendering*/
+		void _PreRender();
+		void _GenerateRenderQueue();
+		void _CaptureRenderSnapshot();
+		void _Submit();
+
 		void _AttachConsole( Kiwi::Console* console );
 
+		/*stores the current transform state as the previous state used for render interpolation, called before each fixed update*/
+		void _SaveFixedState();
+
+		void _RegisterCamera( Kiwi::Camera* camera );
+		void _UnregisterCamera( Kiwi::Camera* camera );
+
 		virtual void _OnUpdate() {}
 		virtual void _OnFixedUpdate() {}
 		virtual void _OnShutdown() {}
@@ -101,7 +146,9 @@ namespace Kiwi
 
 		virtual void AddEntity( Kiwi::Entity* entity );
 		virtual void AddAsset( Kiwi::IAsset* asset );
+#ifndef KIWI_HEADLESS
 		virtual void AddShader( Kiwi::IShader* shader );
+#endif
 
 		Kiwi::Entity* CreateEntity( std::wstring name );
 
@@ -116,6 +163,16 @@ namespace Kiwi
 
 		void SetActive( bool isActive ) { m_isActive = isActive; }
 
+		/*enables or disables render thread mode. while enabled, each frame's render queue is captured into a RenderSnapshot
+		which 'backend' draws on a dedicated thread while the simulation runs the next frame
+		if no backend is given the scene's renderer is used, or a NullRenderBackend if the scene has no renderer
+		the scene waits for the render thread before destroying entities. meshes hand buffers they replace to the render thread,
+		which deletes them once they can no longer be drawn*/
+		void SetRenderThreadEnabled( bool enable, Kiwi::IRenderBackend* backend = 0 );
+
+		/*blocks until the render thread has finished drawing the last submitted frame*/
+		void WaitForRender();
+
 		std::wstring GetName()const { return m_name; }
 
 		Kiwi::EngineRoot* GetEngine()const { return m_engine; }
@@ -127,16 +184,40 @@ namespace Kiwi
 		const Kiwi::Vector4& GetAmbientLight()const { return m_ambientLight; }
 
 		Kiwi::Entity* GetPlayerEntity()const { return m_playerEntity; }
+		Kiwi::EntityManager* GetEntityManager() { return &m_entityManager; }
+
+		/*returns the entities in the scene that have all of the given component types (see EntityManager::Query)*/
+		template<class... ComponentClasses>
+		Kiwi::EntityQuery<ComponentClasses...> Query()
+		{
+			std::lock_guard<std::recursive_mutex> guard( m_sceneMutex );
+			return m_entityManager.Query<ComponentClasses...>();
+		}
 
 		Kiwi::PhysicsSystem* GetPhysicsSystem()const { return m_physicsSystem; }
 
+		Kiwi::TransformStore& GetTransformStore() { return m_transformStore; }
+
+		/*returns the render thread, or 0 if render thread mode is disabled*/
+		Kiwi::RenderThread* GetRenderThread()const { return m_renderThread; }
+		bool IsRenderThreadEnabled()const { return m_renderThread != 0; }
+
+		const std::vector<Kiwi::Camera*>& GetCameras()const { return m_cameras; }
+
 		bool IsShutdown()const { return m_shutdown; }
 		bool IsActive()const { return m_isActive; }
 
 		virtual Kiwi::Entity* FindEntityWithName( std::wstring name );
+		Kiwi::Entity* FindEntityWithName( Kiwi::StringId name );
+
+		/*returns the entity the handle refers to, or 0 if it has since been destroyed*/
+		Kiwi::Entity* FindEntity( Kiwi::EntityHandle handle );
 		virtual std::vector<Kiwi::Entity*> FindEntitiesWithTag( std::wstring tag );
+		std::vector<Kiwi::Entity*> FindEntitiesWithTag( Kiwi::StringId tag );
 
+#ifndef KIWI_HEADLESS
 		Kiwi::RenderTarget* FindRenderTargetWithName( std::wstring name );
+#endif
 
 		template<class TerrainType>
 		TerrainType GetTerrain()const
@@ -150,11 +231,13 @@ namespace Kiwi
 			return dynamic_cast<AssetType*>(m_assetManager.FindAsset( name ));
 		}
 
+#ifndef KIWI_HEADLESS
 		template<>
 		Kiwi::IShader* FindAsset<Kiwi::IShader>( std::wstring name )
 		{
 			return m_shaderContainer.Find( name );
 		}
+#endif
 
 	};
 
@@ -5,6 +5,7 @@
 #include "IAsset.h"
 #include "EngineRoot.h"
 #include "Console.h"
+#include "Profiler.h"
 
 #include "../Graphics/D3DAssetLoader.h"
 #include "../Graphics/Texture.h"
@@ -111,6 +112,8 @@ namespace Kiwi
 	Kiwi::Texture* SceneLoader::_LoadTexture( TextureDesc* textureDesc )
 	{
 
+		KIWI_PROFILE_ZONE( "SceneLoader::_LoadTexture" );
+
 		assert( m_scene != 0 && m_scene->GetRenderer() != 0 && m_scene->GetRenderer()->GetDevice() != 0 );
 		if( textureDesc == 0 || m_scene == 0 || m_scene->GetRenderer() == 0 || m_scene->GetRenderer()->GetDevice() == 0 )
 		{
@@ -189,6 +192,8 @@ namespace Kiwi
 	Kiwi::StaticMeshAsset* SceneLoader::_LoadStaticMesh( StaticMeshDesc* meshDesc )
 	{
 
+		KIWI_PROFILE_ZONE( "SceneLoader::_LoadStaticMesh" );
+
 		assert( m_scene != 0 && m_scene->GetRenderer() != 0 && m_scene->GetRenderer()->GetDevice() != 0 );
 		if( meshDesc == 0 || m_scene == 0 || m_scene->GetRenderer() == 0 || m_scene->GetRenderer()->GetDevice() == 0 )
 		{
@@ -262,9 +267,9 @@ namespace Kiwi
 					texName += L"/Ambient";
 
 					//check if the texture is already loaded and in the scene
-					m_scene->m_mutex->lock();
+					m_scene->m_mutex.lock();
 					ambientMap = m_scene->FindAsset<Kiwi::Texture>( texName );
-					m_scene->m_mutex->unlock();
+					m_scene->m_mutex.unlock();
 
 					if( ambientMap == 0 )
 					{
@@ -315,9 +320,9 @@ namespace Kiwi
 					texName += L"/Diffuse";
 
 					//check if the texture is already loaded and in the scene
-					m_scene->m_mutex->lock();
+					m_scene->m_mutex.lock();
 					diffuseMap = m_scene->FindAsset<Kiwi::Texture>( texName );
-					m_scene->m_mutex->unlock();
+					m_scene->m_mutex.unlock();
 
 					if( diffuseMap == 0 )
 					{
@@ -368,9 +373,9 @@ namespace Kiwi
 					texName += L"/Specular";
 
 					//check if the texture is already loaded and in the scene
-					m_scene->m_mutex->lock();
+					m_scene->m_mutex.lock();
 					specularMap = m_scene->FindAsset<Kiwi::Texture>( texName );
-					m_scene->m_mutex->unlock();
+					m_scene->m_mutex.unlock();
 
 					if( specularMap == 0 )
 					{
@@ -421,9 +426,9 @@ namespace Kiwi
 					texName += L"/Bump";
 
 					//check if the texture is already loaded and in the scene
-					m_scene->m_mutex->lock();
+					m_scene->m_mutex.lock();
 					bumpMap = m_scene->FindAsset<Kiwi::Texture>( texName );
-					m_scene->m_mutex->unlock();
+					m_scene->m_mutex.unlock();
 
 					if( bumpMap == 0 )
 					{
@@ -468,7 +473,7 @@ namespace Kiwi
 			SAFE_DELETE( objMesh );
 
 			//the subsets, vertices, and materials are loaded and created, now create the mesh
-			std::unique_lock<std::mutex> sLock( *m_scene->m_mutex );
+			std::unique_lock<std::mutex> sLock( m_scene->m_mutex );
 			Kiwi::Renderer* renderer = m_scene->GetRenderer();
 			sLock.unlock();
 
@@ -498,6 +503,8 @@ namespace Kiwi
 	Kiwi::Font* SceneLoader::_LoadFont( FontDesc* fontDesc )
 	{
 
+		KIWI_PROFILE_ZONE( "SceneLoader::_LoadFont" );
+
 		assert( m_scene != 0 && m_scene->GetRenderer() != 0 && m_scene->GetRenderer()->GetDevice() != 0 );
 		if( fontDesc == 0 || m_scene == 0 )
 		{
@@ -805,7 +812,7 @@ namespace Kiwi
 
 			if( engine != 0 )
 			{
-				if( maxThreads == 0 ) maxThreads = UINT_MAX;
+				if( maxThreads == 0 ) maxThreads = engine->GetJobSystem()->GetWorkerCount();
 
 				m_maxThreadCount = maxThreads;
 				m_isLoading = true;
@@ -837,6 +844,8 @@ namespace Kiwi
 	void SceneLoader::OnUpdate()
 	{
 
+		KIWI_PROFILE_ZONE( "SceneLoader::OnUpdate" );
+
 		if( m_isLoading )
 		{
 			Kiwi::EngineRoot* engine = m_scene->GetEngine();
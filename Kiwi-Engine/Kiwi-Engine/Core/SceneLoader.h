@@ -132,7 +132,9 @@ namespace Kiwi
 
 		//void LoadFromFile( std::wstring filename );
 
-		void Start( unsigned int maxThreads = 40 );
+		/*starts loading the queued assets as background jobs, with at most 'maxThreads' loads running at once
+		if maxThreads is 0, one load is run per worker thread of the engine's job system*/
+		void Start( unsigned int maxThreads = 0 );
 
 		//gets the total number of bytes that have been queued for loading
 		unsigned long GetBytesTotal()const { return m_totalSizeInBytes; }
@@ -3,11 +3,14 @@
 #include "SceneManager.h"
 #include "Scene.h"
 #include "EngineRoot.h"
+#include "FrameGraph.h"
 
+#ifndef KIWI_HEADLESS
 //#include "../Graphics/GraphicsCore.h"
 #include "../Graphics/Renderer.h"
 #include "../Graphics/RenderWindow.h"
 #include "../Graphics/RenderTarget.h"
+#endif
 
 namespace Kiwi
 {
@@ -61,6 +64,45 @@ namespace Kiwi
 
 	}
 
+	void SceneManager::AddRenderTasks( Kiwi::FrameGraph& graph )
+	{
+
+		for( auto it = m_scenes.begin(); it != m_scenes.end(); it++ )
+		{
+			Kiwi::Scene* scene = it->second;
+			graph.AddTask( "Scene::PreRender", [scene]() { scene->_PreRender(); }, {}, { scene }, true );
+		}
+
+		for( auto it = m_scenes.begin(); it != m_scenes.end(); it++ )
+		{
+			Kiwi::Scene* scene = it->second;
+			graph.AddTask( "Scene::GenerateRenderQueue", [scene]() { scene->_GenerateRenderQueue(); }, { scene }, { scene->m_entityManager.GetRenderQueue() } );
+
+			//in render thread mode the queue is copied into the capture snapshot, also off the main thread
+			if( scene->m_renderThread != 0 )
+			{
+				graph.AddTask( "Scene::CaptureRenderSnapshot", [scene]() { scene->_CaptureRenderSnapshot(); }, { scene, scene->m_entityManager.GetRenderQueue() }, { scene->m_renderThread } );
+			}
+		}
+
+		for( auto it = m_scenes.begin(); it != m_scenes.end(); it++ )
+		{
+			Kiwi::Scene* scene = it->second;
+			graph.AddTask( "Scene::Submit", [scene]() { scene->_Submit(); }, { scene->m_entityManager.GetRenderQueue() }, { scene, scene->GetRenderer() }, true );
+		}
+
+	}
+
+	void SceneManager::SaveFixedState()
+	{
+
+		for( auto it = m_scenes.begin(); it != m_scenes.end(); it++ )
+		{
+			it->second->_SaveFixedState();
+		}
+
+	}
+
 	void SceneManager::AddScene( Kiwi::Scene* scene )
 	{
 
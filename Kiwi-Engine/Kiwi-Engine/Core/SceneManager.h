@@ -14,10 +14,12 @@ namespace Kiwi
 	class RenderTarget;
 	class EngineRoot;
 	class GraphicsCore;
+	class FrameGraph;
 
 	class SceneManager:
 		public Kiwi::IFrameEventListener
 	{
+	friend class EngineRoot;
 	protected:
 
 		Kiwi::EngineRoot* m_engine;
@@ -40,6 +42,14 @@ namespace Kiwi
 
 		void Render();
 
+		/*adds the render stages of every scene to the frame graph. the render queues are generated on worker threads
+		while the main thread runs the pre-render hooks and submits of the other scenes
+		scenes in render thread mode capture a render snapshot on a worker thread and submit it to their render thread*/
+		void AddRenderTasks( Kiwi::FrameGraph& graph );
+
+		/*saves the pre-fixed-update transform state of every scene for render interpolation*/
+		void SaveFixedState();
+
 		void AddScene( Kiwi::Scene* scene );
 
 		Kiwi::Scene* FindSceneWithName( std::wstring name );
@@ -0,0 +1,95 @@
+#include "StringId.h"
+
+namespace Kiwi
+{
+
+	const Kiwi::StringId StringTable::EMPTY;
+	const Kiwi::StringId StringTable::INVALID;
+
+	//the table is created on first use so it can be used during static initialization
+	std::unordered_map<std::wstring, Kiwi::StringId>& StringTable::_GetIDMap()
+	{
+
+		static std::unordered_map<std::wstring, Kiwi::StringId> idMap( { { L"", EMPTY } } );
+		return idMap;
+
+	}
+
+	std::vector<std::wstring>& StringTable::_GetStrings()
+	{
+
+		static std::vector<std::wstring> strings( 1, L"" );
+		return strings;
+
+	}
+
+	std::mutex& StringTable::_GetMutex()
+	{
+
+		static std::mutex tableMutex;
+		return tableMutex;
+
+	}
+
+	Kiwi::StringId StringTable::Intern( const std::wstring& string )
+	{
+
+		std::lock_guard<std::mutex> guard( _GetMutex() );
+
+		std::unordered_map<std::wstring, Kiwi::StringId>& idMap = _GetIDMap();
+		auto itr = idMap.find( string );
+		if( itr != idMap.end() )
+		{
+			return itr->second;
+		}
+
+		std::vector<std::wstring>& strings = _GetStrings();
+		Kiwi::StringId id = (Kiwi::StringId)strings.size();
+		strings.push_back( string );
+		idMap.insert( std::make_pair( string, id ) );
+
+		return id;
+
+	}
+
+	Kiwi::StringId StringTable::Find( const std::wstring& string )
+	{
+
+		std::lock_guard<std::mutex> guard( _GetMutex() );
+
+		std::unordered_map<std::wstring, Kiwi::StringId>& idMap = _GetIDMap();
+		auto itr = idMap.find( string );
+		if( itr != idMap.end() )
+		{
+			return itr->second;
+		}
+
+		return INVALID;
+
+	}
+
+	std::wstring StringTable::GetString( Kiwi::StringId id )
+	{
+
+		std::lock_guard<std::mutex> guard( _GetMutex() );
+
+		std::vector<std::wstring>& strings = _GetStrings();
+		if( id < strings.size() )
+		{
+			return strings[id];
+		}
+
+		return L"";
+
+	}
+
+	unsigned int StringTable::GetCount()
+	{
+
+		std::lock_guard<std::mutex> guard( _GetMutex() );
+
+		return (unsigned int)_GetStrings().size();
+
+	}
+
+}
\ No newline at end of file
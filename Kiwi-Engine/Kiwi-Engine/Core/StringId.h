@@ -0,0 +1,54 @@
+#ifndef _KIWI_STRINGID_H_
+#define _KIWI_STRINGID_H_
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+
+namespace Kiwi
+{
+
+	/*32 bit identifier of a string stored in the global string table
+	two strings are equal if and only if their IDs are equal, so IDs can be compared and hashed
+	instead of the strings themselves*/
+	typedef unsigned int StringId;
+
+	/*global table of interned strings. strings are never removed, so only intern strings
+	that are reused (names, tags, render groups, shader names)*/
+	class StringTable
+	{
+	public:
+
+		//ID of the empty string, always present in the table
+		static const Kiwi::StringId EMPTY = 0;
+
+		//returned by Find when the string has never been interned
+		static const Kiwi::StringId INVALID = 0xFFFFFFFF;
+
+	private:
+
+		static std::unordered_map<std::wstring, Kiwi::StringId>& _GetIDMap();
+		static std::vector<std::wstring>& _GetStrings();
+		static std::mutex& _GetMutex();
+
+	public:
+
+		/*returns the ID of the string, adding it to the table if it is not already present*/
+		static Kiwi::StringId Intern( const std::wstring& string );
+
+		/*returns the ID of the string if it has been interned, or INVALID otherwise
+		does not add the string to the table*/
+		static Kiwi::StringId Find( const std::wstring& string );
+
+		/*returns the string belonging to the ID, or an empty string if the ID is invalid*/
+		static std::wstring GetString( Kiwi::StringId id );
+
+		/*returns the number of strings in the table*/
+		static unsigned int GetCount();
+
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include "TagTable.h"
+#include "Exception.h"
+
+namespace Kiwi
+{
+
+	const unsigned int TagTable::INVALID_TAG;
+
+	Kiwi::StringId TagTable::Tags[KIWI_MAX_TAGS];
+	std::atomic<unsigned int> TagTable::TagCount( 0 );
+	std::mutex TagTable::TagMutex;
+
+	unsigned int TagTable::Register( Kiwi::StringId tag )
+	{
+
+		unsigned int tagIndex = Find( tag );
+		if( tagIndex != INVALID_TAG )
+		{
+			return tagIndex;
+		}
+
+		std::lock_guard<std::mutex> guard( TagMutex );
+
+		//check again in case another thread registered the tag first
+		unsigned int count = TagCount.load( std::memory_order_acquire );
+		for( unsigned int i = 0; i < count; i++ )
+		{
+			if( Tags[i] == tag )
+			{
+				return i;
+			}
+		}
+
+		if( count >= KIWI_MAX_TAGS )
+		{
+			throw Kiwi::Exception( L"TagTable::Register", L"Cannot register tag '" + Kiwi::StringTable::GetString( tag ) + L"': the tag table is full" );
+		}
+
+		Tags[count] = tag;
+		TagCount.store( count + 1, std::memory_order_release );
+
+		return count;
+
+	}
+
+	unsigned int TagTable::Find( Kiwi::StringId tag )
+	{
+
+		//tags are never removed, so the first 'count' entries can be read without locking
+		unsigned int count = TagCount.load( std::memory_order_acquire );
+		for( unsigned int i = 0; i < count; i++ )
+		{
+			if( Tags[i] == tag )
+			{
+				return i;
+			}
+		}
+
+		return INVALID_TAG;
+
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef _KIWI_TAGTABLE_H_
+#define _KIWI_TAGTABLE_H_
+
+#include "StringId.h"
+
+#include <atomic>
+#include <mutex>
+
+//maximum number of distinct tags that can be used
+#define KIWI_MAX_TAGS 64
+
+namespace Kiwi
+{
+
+	/*bitmask with one bit per registered tag*/
+	typedef unsigned long long TagMask;
+
+	/*global table of tags. each tag string is assigned one of KIWI_MAX_TAGS bits the first time it is used,
+	so the tags of an object can be stored as a single TagMask and tag checks become a bitwise AND*/
+	class TagTable
+	{
+	public:
+
+		//returned by Find when the string has never been registered as a tag
+		static const unsigned int INVALID_TAG = 0xFFFFFFFF;
+
+	private:
+
+		static Kiwi::StringId Tags[KIWI_MAX_TAGS];
+		static std::atomic<unsigned int> TagCount;
+		static std::mutex TagMutex;
+
+	public:
+
+		/*returns the index of the tag, registering it if needed
+		throws if the tag is new and the table is full*/
+		static unsigned int Register( Kiwi::StringId tag );
+
+		/*returns the index of the tag, or INVALID_TAG if it has never been registered*/
+		static unsigned int Find( Kiwi::StringId tag );
+
+		/*returns the bit belonging to the tag, registering it if needed*/
+		static Kiwi::TagMask GetMask( Kiwi::StringId tag ) { return (Kiwi::TagMask)1 << Register( tag ); }
+		static Kiwi::TagMask GetMask( const std::wstring& tag ) { return GetMask( Kiwi::StringTable::Intern( tag ) ); }
+
+		/*returns the string ID of the tag with the given index*/
+		static Kiwi::StringId GetTag( unsigned int tagIndex ) { return (tagIndex < TagCount.load( std::memory_order_acquire )) ? Tags[tagIndex] : Kiwi::StringTable::INVALID; }
+
+		static unsigned int GetCount() { return TagCount.load( std::memory_order_acquire ); }
+
+	};
+
+}
+
+#endif
\ No newline at end of file
@@ -3,29 +3,53 @@
 
 #include "Exception.h"
 #include "IThreadParam.h"
+#include "JobSystem.h"
 
 #include <thread>
 #include <future>
 #include <unordered_map>
+#include <functional>
 
 namespace Kiwi
 {
 
 	enum ThreadStatus { THREAD_INVALID, THREAD_READY, THREAD_DEFERRED, THREAD_TIMEOUT, THREAD_UNKNOWN };
 
+	/*runs functions as background jobs of a job system instead of starting a thread for each of them
+	the 'threads' are identified by an ID and their return values are collected through futures*/
 	template<typename ThreadReturnType = void>
 	class ThreadManager
 	{
 	protected:
 
+		Kiwi::JobSystem& m_jobSystem;
+
 		//map of futures, key value = threadID, value = thread future
 		std::unordered_map<unsigned int, std::shared_future<ThreadReturnType>> m_futures;
 
 		unsigned int m_threadID;
 
+	protected:
+
+		unsigned int _Spawn( std::function<ThreadReturnType()> function )
+		{
+
+			//the packaged task stores the return value or the exception in the future
+			std::shared_ptr<std::packaged_task<ThreadReturnType()>> task( new std::packaged_task<ThreadReturnType()>( function ) );
+
+			m_threadID += 1;
+			m_futures[m_threadID] = task->get_future().share();
+
+			m_jobSystem.Schedule( [task]() { (*task)(); }, Kiwi::JOB_BACKGROUND );
+
+			return m_threadID;
+
+		}
+
 	public:
 
-		ThreadManager()
+		ThreadManager( Kiwi::JobSystem& jobSystem ):
+			m_jobSystem( jobSystem )
 		{
 			m_threadID = 1;
 		}
@@ -42,10 +66,7 @@ namespace Kiwi
 		unsigned int SpawnThread( ThreadReturnType (*threadFunction)(void) )
 		{
 
-			m_threadID += 1;
-			m_futures[m_threadID] = std::async( std::launch::async, threadFunction );
-
-			return m_threadID;
+			return this->_Spawn( threadFunction );
 
 		}
 
@@ -55,10 +76,7 @@ namespace Kiwi
 		unsigned int SpawnThread( ThreadReturnType ( *threadFunction )(ThreadParameterType), ThreadParameterType parameter )
 		{
 
-			m_threadID += 1;
-			m_futures[m_threadID] = std::async( std::launch::async, threadFunction, parameter );
-
-			return m_threadID;
+			return this->_Spawn( std::bind( threadFunction, parameter ) );
 
 		}
 
@@ -68,10 +86,7 @@ namespace Kiwi
 		unsigned int SpawnThread( FunctionClass* fClass, ThreadReturnType ( FunctionClass::*threadFunction )(void) )
 		{
 
-			m_threadID += 1;
-			m_futures[m_threadID] = std::async( std::launch::async, threadFunction, fClass );
-
-			return m_threadID;
+			return this->_Spawn( std::bind( threadFunction, fClass ) );
 
 		}
 
@@ -81,10 +96,7 @@ namespace Kiwi
 		unsigned int SpawnThread( FunctionClass* fClass, ThreadReturnType ( FunctionClass::*threadFunction )(ThreadParameterType), ThreadParameterType parameter )
 		{
 
-			m_threadID += 1;
-			m_futures[m_threadID] = std::async( std::launch::async, threadFunction, fClass, parameter );
-			//MessageBox( NULL, Kiwi::ToWString( m_threadID ).c_str(), L"A", MB_OK );
-			return m_threadID;
+			return this->_Spawn( std::bind( threadFunction, fClass, parameter ) );
 
 		}
 
@@ -122,7 +134,7 @@ namespace Kiwi
 		}
 
 		/*calls get() on the thread's future
-		if the thread has not finished this function will block until the thread finishes
+		if the thread has not finished this function will block until the thread finishes, running queued jobs while it waits
 		if the thread threw an exception this function will re-throw it
 		returns the value returned by the function
 		if threadID is invalid it will throw*/
@@ -143,6 +155,14 @@ namespace Kiwi
 					m_threadID = 0;
 				}
 
+				while( future.wait_for( std::chrono::milliseconds( 0 ) ) != std::future_status::ready )
+				{
+					if( !m_jobSystem.RunPendingJob() )
+					{
+						future.wait_for( std::chrono::milliseconds( 1 ) );
+					}
+				}
+
 				/*gets the value returned by the thread. if the thread is not finished, blocks until it is done
 				if the thread threw an exception, this will re-throw it*/
 				return future.get();
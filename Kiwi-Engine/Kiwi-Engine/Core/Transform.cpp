@@ -1,23 +1,84 @@
 #include "Transform.h"
 #include "Math.h"
 #include "Entity.h"
+#include "Scene.h"
 
 #include "../Physics/Rigidbody.h"
 
+#include <cmath>
+
 namespace Kiwi
 {
 
 	Transform::Transform()
 	{
 
-		m_scale = Kiwi::Vector3d( 1.0, 1.0, 1.0 );
+		m_store = &Kiwi::TransformStore::Detached();
+		m_handle = m_store->Create( this );
+		m_lockYaw = m_lockPitch = m_lockRoll = false;
+		m_rigidbody = 0;
+		m_immediateEvents = false;
+
+	}
+
+	Transform::Transform( Kiwi::TransformStore& store )
+	{
+
+		m_store = &store;
+		m_handle = m_store->Create( this );
 		m_lockYaw = m_lockPitch = m_lockRoll = false;
 		m_rigidbody = 0;
+		m_immediateEvents = false;
 
 	}
 
 	Transform::~Transform()
 	{
+
+		if( m_store != 0 )
+		{
+			m_store->Destroy( m_handle );
+			m_store = 0;
+		}
+
+	}
+
+	void Transform::_OnAttached()
+	{
+
+		//move the transform's data into the store owned by the entity's scene
+		if( m_entity != 0 && m_entity->GetScene() != 0 )
+		{
+			this->_SetStore( m_entity->GetScene()->GetTransformStore() );
+		}
+
+		if( m_entity != 0 )
+		{
+			this->_UpdateParent();
+
+			//moving to a new store dropped the links to the child transforms, relink them
+			const Kiwi::EntityMap& children = m_entity->GetChildren();
+			for( auto itr = children.begin(); itr != children.end(); itr++ )
+			{
+				Kiwi::Transform* childTransform = itr->second->FindComponent<Kiwi::Transform>();
+				if( childTransform != 0 && childTransform != this )
+				{
+					childTransform->_UpdateParent();
+				}
+			}
+		}
+
+	}
+
+	void Transform::_SetStore( Kiwi::TransformStore& store )
+	{
+
+		if( m_store != &store )
+		{
+			m_handle = store.MoveFrom( *m_store, m_handle );
+			m_store = &store;
+		}
+
 	}
 
 	void Transform::_TranslateChildren( const Kiwi::Vector3d translation )
@@ -32,43 +93,51 @@ namespace Kiwi
 
 	}
 
-	void Transform::_UpdateGlobalPosition()
+	void Transform::_BroadcastChange( const Kiwi::TransformChange& change )
 	{
 
-		if( m_entity != 0 && m_entity->GetParent() != 0 && m_entity->GetParent()->GetType() == m_entity->GetType() )
+		//transforms in immediate mode already sent an event for each change
+		if( m_immediateEvents || this->GetListenerCount() == 0 ) return;
+
+		if( change.flags & Kiwi::TransformChange::POSITION )
 		{
-			Kiwi::Transform* parentTransform = m_entity->GetParent()->FindComponent<Kiwi::Transform>();
-			if( parentTransform != 0 )
-			{
-				m_globalPosition = m_position + parentTransform->GetGlobalPosition();
+			this->BroadcastTransformEvent( Kiwi::TransformEvent( this, Kiwi::TransformEvent::TRANSFORM_TRANSLATION, this->_Position() - change.startPosition, change.startPosition ) );
+		}
 
-			} else
-			{
-				m_globalPosition = m_position;
-			}
+		if( change.flags & Kiwi::TransformChange::ROTATION )
+		{
+			Kiwi::Quaternion diff = this->_Rotation().Cross( change.startRotation.Inverse() ).Normalized();
+			this->BroadcastTransformEvent( Kiwi::TransformEvent( this, Kiwi::TransformEvent::TRANSFORM_ROTATION, 0.0, this, diff, change.startRotation ) );
+		}
 
-		} else
+	}
+
+	Kiwi::Transform* Transform::_FindParentTransform()const
+	{
+
+		if( m_entity != 0 && m_entity->GetParent() != 0 && m_entity->GetParent()->GetType() == m_entity->GetType() )
 		{
-			m_globalPosition = m_position;
+			return m_entity->GetParent()->FindComponent<Kiwi::Transform>();
 		}
 
+		return 0;
+
 	}
 
-	void Transform::_UpdateChildTransforms()
+	void Transform::_UpdateParent()
 	{
 
-		if( m_entity != 0 && m_entity->HasChild() )
+		//transforms in different stores (e.g. an entity that is not in the parent's scene yet) are not linked
+		Kiwi::TransformStore::Handle parentHandle = Kiwi::TransformStore::INVALID_HANDLE;
+		Kiwi::Transform* parentTransform = this->_FindParentTransform();
+		if( parentTransform != 0 && parentTransform != this && parentTransform->m_store == m_store )
 		{
-			Kiwi::EntityMap children = m_entity->GetChildren();
+			parentHandle = parentTransform->m_handle;
+		}
 
-			for( auto itr = children.begin(); itr != children.end(); itr++ )
-			{
-				Kiwi::Transform* trans = itr->second->FindComponent<Kiwi::Transform>();
-				if( trans != 0 )
-				{
-					trans->Update();
-				}
-			}
+		if( m_store->GetParent( m_handle ) != parentHandle )
+		{
+			m_store->SetParent( m_handle, parentHandle );
 		}
 
 	}
@@ -76,51 +145,38 @@ namespace Kiwi
 	void Transform::Update()
 	{
 
-		this->_UpdateGlobalPosition();
+		//the global values are recomputed by the scene's transform store, only the parent link is kept in sync here
+		this->_UpdateParent();
 
 	}
 
 	void Transform::Translate( double x, double y, double z )
 	{
 
-		Kiwi::Vector3 translation( x, y, z );
-		Kiwi::TransformEvent transEvent( this, Kiwi::TransformEvent::TRANSFORM_TRANSLATION, translation, m_position );
-
-		m_position += translation;
-		this->_UpdateGlobalPosition();
-		this->_UpdateChildTransforms();
-
-		//this->_TranslateChildren( translation );
-
-		this->BroadcastTransformEvent( transEvent );
+		this->Translate( Kiwi::Vector3d( x, y, z ) );
 
 	}
 
 	void Transform::Translate( const Kiwi::Vector3& translation )
 	{
 
-		Kiwi::TransformEvent transEvent( this, Kiwi::TransformEvent::TRANSFORM_TRANSLATION, translation, m_position );
-
-		m_position += translation;
-		this->_UpdateGlobalPosition();
-		this->_UpdateChildTransforms();
-		//this->_TranslateChildren( translation );
-
-		this->BroadcastTransformEvent( transEvent );
+		this->Translate( Kiwi::Vector3d( translation ) );
 
 	}
 
 	void Transform::Translate( const Kiwi::Vector3d& translation )
 	{
 
-		Kiwi::TransformEvent transEvent( this, Kiwi::TransformEvent::TRANSFORM_TRANSLATION, translation, m_position );
+		Kiwi::Vector3d oldPosition = this->_Position();
 
-		m_position += translation;
-		this->_UpdateGlobalPosition();
-		this->_UpdateChildTransforms();
+		this->_RecordChange( Kiwi::TransformChange::POSITION );
+		this->_Position() += translation;
 		//this->_TranslateChildren( translation );
 
-		this->BroadcastTransformEvent( transEvent );
+		if( m_immediateEvents )
+		{
+			this->BroadcastTransformEvent( Kiwi::TransformEvent( this, Kiwi::TransformEvent::TRANSFORM_TRANSLATION, translation, oldPosition ) );
+		}
 
 	}
 
@@ -134,32 +190,23 @@ namespace Kiwi
 	void Transform::SetPosition( const Kiwi::Vector3d& newPosition )
 	{
 
-		Kiwi::Vector3d translation = newPosition - m_position;
-
-		Kiwi::TransformEvent transEvent( this, Kiwi::TransformEvent::TRANSFORM_TRANSLATION, translation, m_position );
+		Kiwi::Vector3d oldPosition = this->_Position();
 
-		m_position = newPosition;
-		this->_UpdateGlobalPosition();
-		this->_UpdateChildTransforms();
+		this->_RecordChange( Kiwi::TransformChange::POSITION );
+		this->_Position() = newPosition;
 		//this->_TranslateChildren( translation );
 
-		this->BroadcastTransformEvent( transEvent );
+		if( m_immediateEvents )
+		{
+			this->BroadcastTransformEvent( Kiwi::TransformEvent( this, Kiwi::TransformEvent::TRANSFORM_TRANSLATION, newPosition - oldPosition, oldPosition ) );
+		}
 
 	}
 
 	void Transform::SetPosition( const Kiwi::Transform& transform )
 	{
 
-		Kiwi::Vector3d translation = transform.GetPosition() - m_position;
-
-		Kiwi::TransformEvent transEvent( this, Kiwi::TransformEvent::TRANSFORM_TRANSLATION, translation, m_position );
-
-		m_position = transform.GetPosition();
-		this->_UpdateGlobalPosition();
-		this->_UpdateChildTransforms();
-		//this->_TranslateChildren( translation );
-
-		this->BroadcastTransformEvent( transEvent );
+		this->SetPosition( transform.GetPosition() );
 
 	}
 
@@ -173,27 +220,24 @@ namespace Kiwi
 	void Transform::SetGlobalPosition( const Kiwi::Vector3d& position )
 	{
 
-		m_globalPosition = position;
+		this->_RecordChange( Kiwi::TransformChange::POSITION );
 
-		if( m_entity != 0 && m_entity->GetParent() != 0 )
+		Kiwi::Transform* parentTransform = this->_FindParentTransform();
+		if( parentTransform != 0 && parentTransform != this && parentTransform->m_store == m_store )
 		{
-			Kiwi::Transform* parentTransform = m_entity->GetParent()->FindComponent<Kiwi::Transform>();
-			if( parentTransform != 0 )
-			{
-				m_position = m_globalPosition - parentTransform->GetGlobalPosition();
+			//undo the parent's translation, rotation and scale
+			const Kiwi::Vector3d& parentScale = parentTransform->GetGlobalScale();
+			Kiwi::Vector3d local = parentTransform->GetGlobalRotation().Inverse().RotatePoint( position - parentTransform->GetGlobalPosition() );
 
-			} else
-			{
-				m_position = m_globalPosition;
-			}
+			this->_Position().Set( (parentScale.x != 0.0) ? local.x / parentScale.x : 0.0,
+								   (parentScale.y != 0.0) ? local.y / parentScale.y : 0.0,
+								   (parentScale.z != 0.0) ? local.z / parentScale.z : 0.0 );
 
 		} else
 		{
-			m_position = m_globalPosition;
+			this->_Position() = position;
 		}
 
-		this->_UpdateChildTransforms();
-
 	}
 
 	void Transform::AttachTransform( Kiwi::Transform* transform )
@@ -248,28 +292,35 @@ namespace Kiwi
 	void Transform::Rotate(const Kiwi::Quaternion& rotation)
 	{
 
-		Kiwi::TransformEvent rotEvent( this, Kiwi::TransformEvent::TRANSFORM_ROTATION, 0.0, this, rotation, m_rotation );
+		Kiwi::Quaternion oldRotation = this->_Rotation();
 
 		//multiply the current rotation with the new rotation to get the final rotation
-		m_rotation = rotation.Cross(m_rotation).Normalized();
+		this->_RecordChange( Kiwi::TransformChange::ROTATION );
+		this->_Rotation() = rotation.Cross(this->_Rotation()).Normalized();
 
-		this->BroadcastTransformEvent( rotEvent );
+		if( m_immediateEvents )
+		{
+			this->BroadcastTransformEvent( Kiwi::TransformEvent( this, Kiwi::TransformEvent::TRANSFORM_ROTATION, 0.0, this, rotation, oldRotation ) );
+		}
 
 		//if an axis is locked, we need to rotate that axis back to its fixed rotation value
 		if(m_lockRoll)
 		{
 
-			Kiwi::Vector3 eulerAngles = m_rotation.GetEulerAngles();
+			Kiwi::Vector3 eulerAngles = this->_Rotation().GetEulerAngles();
 
 			if(eulerAngles.z != m_lockPosition.z)
 			{
 				Kiwi::Quaternion zRot(this->GetForward(),-(eulerAngles.z - m_lockPosition.z)); 
 
-				Kiwi::TransformEvent rotEvent( this, Kiwi::TransformEvent::TRANSFORM_ROTATION, -(eulerAngles.z - m_lockPosition.z), this, zRot, m_rotation );
+				Kiwi::TransformEvent rotEvent( this, Kiwi::TransformEvent::TRANSFORM_ROTATION, -(eulerAngles.z - m_lockPosition.z), this, zRot, this->_Rotation() );
 
-				m_rotation = zRot.Cross(m_rotation).Normalized();
+				this->_Rotation() = zRot.Cross(this->_Rotation()).Normalized();
 
-				this->BroadcastTransformEvent( rotEvent );
+				if( m_immediateEvents )
+				{
+					this->BroadcastTransformEvent( rotEvent );
+				}
 			}
 
 		}
@@ -277,17 +328,20 @@ namespace Kiwi
 		if(m_lockPitch)
 		{
 
-			Kiwi::Vector3 eulerAngles = m_rotation.GetEulerAngles();
+			Kiwi::Vector3 eulerAngles = this->_Rotation().GetEulerAngles();
 
 			if(eulerAngles.x != m_lockPosition.x)
 			{
 				Kiwi::Quaternion xRot(this->GetRight(),-(eulerAngles.x - m_lockPosition.x)); 
 
-				Kiwi::TransformEvent rotEvent( this, Kiwi::TransformEvent::TRANSFORM_ROTATION, -(eulerAngles.x - m_lockPosition.x), this, xRot, m_rotation );
+				Kiwi::TransformEvent rotEvent( this, Kiwi::TransformEvent::TRANSFORM_ROTATION, -(eulerAngles.x - m_lockPosition.x), this, xRot, this->_Rotation() );
 
-				m_rotation = xRot.Cross(m_rotation).Normalized();
+				this->_Rotation() = xRot.Cross(this->_Rotation()).Normalized();
 
-				this->BroadcastTransformEvent( rotEvent );
+				if( m_immediateEvents )
+				{
+					this->BroadcastTransformEvent( rotEvent );
+				}
 			}
 
 		}
@@ -295,17 +349,20 @@ namespace Kiwi
 		if(m_lockYaw)
 		{
 
-			Kiwi::Vector3 eulerAngles = m_rotation.GetEulerAngles();
+			Kiwi::Vector3 eulerAngles = this->_Rotation().GetEulerAngles();
 
 			if(eulerAngles.y != m_lockPosition.y)
 			{
 				Kiwi::Quaternion yRot(this->GetUp(),-(eulerAngles.y - m_lockPosition.y));
 
-				Kiwi::TransformEvent rotEvent( this, Kiwi::TransformEvent::TRANSFORM_ROTATION, -(eulerAngles.y - m_lockPosition.y), this, yRot, m_rotation );
+				Kiwi::TransformEvent rotEvent( this, Kiwi::TransformEvent::TRANSFORM_ROTATION, -(eulerAngles.y - m_lockPosition.y), this, yRot, this->_Rotation() );
 
-				m_rotation = yRot.Cross(m_rotation).Normalized();
+				this->_Rotation() = yRot.Cross(this->_Rotation()).Normalized();
 
-				this->BroadcastTransformEvent( rotEvent );
+				if( m_immediateEvents )
+				{
+					this->BroadcastTransformEvent( rotEvent );
+				}
 			}
 
 		}
@@ -320,7 +377,7 @@ namespace Kiwi
 
 			} else
 			{
-				(*itr)->RotateAround( m_position, rotation );
+				(*itr)->RotateAround( this->_Position(), rotation );
 			}
 		}
 
@@ -335,7 +392,7 @@ namespace Kiwi
 		Quaternion qr = rotation.Cross( vq );
 		qr = qr.Cross( rotation.Conjugate() );
 
-		Kiwi::Vector3d newPos = m_position;
+		Kiwi::Vector3d newPos = this->_Position();
 		newPos += Kiwi::Vector3d( qr.x, qr.y, qr.z );
 		this->SetPosition( newPos );
 
@@ -350,7 +407,7 @@ namespace Kiwi
 		Quaternion qr = rotation.Cross( vq );
 		qr = qr.Cross( rotation.Conjugate() );
 
-		Kiwi::Vector3d newPos = m_position;
+		Kiwi::Vector3d newPos = this->_Position();
 		newPos += Kiwi::Vector3d( qr.x, qr.y, qr.z );
 		this->SetPosition( newPos );
 
@@ -365,13 +422,17 @@ namespace Kiwi
 		where:  inverse(q1) = conjugate(q1) / abs(q1)
 		and:  conjugate( quaternion(re, i, j, k) ) = quaternion(re, -i, -j, -k)
 		*/
-		Kiwi::Quaternion diff = newRotation.Cross( m_rotation.Inverse() ).Normalized();
+		Kiwi::Quaternion diff = newRotation.Cross( this->_Rotation().Inverse() ).Normalized();
 
-		Kiwi::TransformEvent rotEvent( this, Kiwi::TransformEvent::TRANSFORM_ROTATION, 0.0, this, diff, m_rotation );
+		Kiwi::Quaternion oldRotation = this->_Rotation();
 
-		m_rotation = newRotation;
+		this->_RecordChange( Kiwi::TransformChange::ROTATION );
+		this->_Rotation() = newRotation;
 
-		this->BroadcastTransformEvent( rotEvent );
+		if( m_immediateEvents )
+		{
+			this->BroadcastTransformEvent( Kiwi::TransformEvent( this, Kiwi::TransformEvent::TRANSFORM_ROTATION, 0.0, this, diff, oldRotation ) );
+		}
 
 		//rotate child entities around this transform by the difference
 		auto itr = m_childTransforms.begin();
@@ -399,9 +460,9 @@ namespace Kiwi
 	void Transform::RotateTowards(const Kiwi::Vector3d& target, const Kiwi::Vector3d& up, double maxRotation)
 	{
 
-		if(m_position == target) return;
+		if(this->_Position() == target) return;
 
-		Kiwi::Vector3d forwardDifference = (target - m_position).Normalized();
+		Kiwi::Vector3d forwardDifference = (target - this->_Position()).Normalized();
 		Kiwi::Vector3d forward = Kiwi::Vector3d::forward();
 
 		Kiwi::Vector3d rotationAxis = forward.Cross( forwardDifference ).Normalized();
@@ -422,7 +483,8 @@ namespace Kiwi
 		double rotationAngle = std::acos( dot );
 
 		Kiwi::Quaternion rotation( rotationAxis, rotationAngle );
-		m_rotation = rotation;
+		this->_RecordChange( Kiwi::TransformChange::ROTATION );
+		this->_Rotation() = rotation;
 
 		double zAngle = Kiwi::Vector3d::right().Dot( this->GetRight() );
 		if( zAngle != 0.0 )
@@ -430,7 +492,7 @@ namespace Kiwi
 			this->Rotate( this->GetForward(), -zAngle );
 		}
 
-		/*Kiwi::Vector3 eulerAngles = m_rotation.GetEulerAngles();
+		/*Kiwi::Vector3 eulerAngles = this->_Rotation().GetEulerAngles();
 
 		if(eulerAngles.z != 0.0)
 		{
@@ -438,7 +500,7 @@ namespace Kiwi
 		}*/
 
 		//calculate the vector between the current position and the target
-		//Kiwi::Vector3d vectorBetween = (target - m_position).Normalized();
+		//Kiwi::Vector3d vectorBetween = (target - this->_Position()).Normalized();
 
 		//Kiwi::Vector3d forward = this->GetForward();
 		//Kiwi::Vector3d up = this->GetUp();
@@ -473,7 +535,7 @@ namespace Kiwi
 
 		////now the quaternion is facing the target, but it may be rotated around the z-axis
 		////need to rotate around the z-axis to the desired up direction
-		//Kiwi::Vector3 eulerAngles = m_rotation.GetEulerAngles();
+		//Kiwi::Vector3 eulerAngles = this->_Rotation().GetEulerAngles();
 
 		//if(eulerAngles.z != 0.0)
 		//{
@@ -493,10 +555,10 @@ namespace Kiwi
 	{
 
 
-		if(m_position == target) return;
+		if(this->_Position() == target) return;
 
 		//calculate the vector between the current position and the target
-		Kiwi::Vector3 vectorBetween(target.x - m_position.x, target.y - m_position.y, target.z - m_position.z);
+		Kiwi::Vector3 vectorBetween(target.x - this->_Position().x, target.y - this->_Position().y, target.z - this->_Position().z);
 		vectorBetween = vectorBetween.Normalized();
 
 		Kiwi::Vector3d forward = this->GetForward().Scaled(-1.0);
@@ -530,7 +592,7 @@ namespace Kiwi
 
 		//now the quaternion is facing the target, but it may be rotated around the z-axis
 		//need to rotate around the z-axis to the desired up direction
-		Kiwi::Vector3 eulerAngles = m_rotation.GetEulerAngles();
+		Kiwi::Vector3 eulerAngles = this->_Rotation().GetEulerAngles();
 
 		if(eulerAngles.z != 0.0)
 		{
@@ -583,11 +645,12 @@ namespace Kiwi
 				m_lockPitch = true;
 				m_lockPosition.x = radians;
 
-				Kiwi::Vector3 eulerAngles = m_rotation.GetEulerAngles();
+				Kiwi::Vector3 eulerAngles = this->_Rotation().GetEulerAngles();
 				if(eulerAngles.x != m_lockPosition.x)
 				{
 					Kiwi::Quaternion xRot( this->GetRight(), -(eulerAngles.x - m_lockPosition.x) );
-					m_rotation = xRot.Cross(m_rotation);
+					this->_RecordChange( Kiwi::TransformChange::ROTATION );
+					this->_Rotation() = xRot.Cross(this->_Rotation());
 				}
 
 				break;
@@ -597,11 +660,12 @@ namespace Kiwi
 				m_lockYaw = true;
 				m_lockPosition.y = radians;
 
-				Kiwi::Vector3 eulerAngles = m_rotation.GetEulerAngles();
+				Kiwi::Vector3 eulerAngles = this->_Rotation().GetEulerAngles();
 				if(eulerAngles.y != m_lockPosition.y)
 				{
 					Kiwi::Quaternion yRot( this->GetUp(), -(eulerAngles.y - m_lockPosition.y) );
-					m_rotation = yRot.Cross(m_rotation);
+					this->_RecordChange( Kiwi::TransformChange::ROTATION );
+					this->_Rotation() = yRot.Cross(this->_Rotation());
 				}
 
 				break;
@@ -611,11 +675,12 @@ namespace Kiwi
 				m_lockRoll = true;
 				m_lockPosition.z = radians;
 
-				Kiwi::Vector3 eulerAngles = m_rotation.GetEulerAngles();
+				Kiwi::Vector3 eulerAngles = this->_Rotation().GetEulerAngles();
 				if(eulerAngles.z != m_lockPosition.z)
 				{
 					Kiwi::Quaternion zRot( this->GetForward(), -(eulerAngles.z - m_lockPosition.z) );
-					m_rotation = zRot.Cross(m_rotation);
+					this->_RecordChange( Kiwi::TransformChange::ROTATION );
+					this->_Rotation() = zRot.Cross(this->_Rotation());
 				}
 
 				break;
@@ -629,7 +694,7 @@ namespace Kiwi
 	double Transform::GetDistance(Kiwi::Transform* targetTransform)
 	{
 
-		return std::sqrtf( this->GetSquareDistance(targetTransform) );
+		return std::sqrt( this->GetSquareDistance(targetTransform) );
 
 	}
 
@@ -637,7 +702,7 @@ namespace Kiwi
 	double Transform::GetDistance( const Kiwi::Vector3d& target )
 	{
 
-		return std::sqrtf( this->GetSquareDistance( target ) );
+		return std::sqrt( this->GetSquareDistance( target ) );
 
 	}
 
@@ -650,9 +715,9 @@ namespace Kiwi
 			return 0.0f;
 		}
 
-		return ( std::powf( (targetTransform->GetGlobalPosition().x - m_globalPosition.x), 2) +
-				 std::powf( (targetTransform->GetGlobalPosition().y - m_globalPosition.y), 2) +
-				 std::powf( (targetTransform->GetGlobalPosition().z - m_globalPosition.z), 2) );
+		return ( std::pow( (targetTransform->GetGlobalPosition().x - this->_GlobalPosition().x), 2) +
+				 std::pow( (targetTransform->GetGlobalPosition().y - this->_GlobalPosition().y), 2) +
+				 std::pow( (targetTransform->GetGlobalPosition().z - this->_GlobalPosition().z), 2) );
 
 	}
 
@@ -660,39 +725,25 @@ namespace Kiwi
 	double Transform::GetSquareDistance( const Kiwi::Vector3d& target )
 	{
 
-		return ( std::pow( (target.x - m_globalPosition.x), 2 ) +
-				 std::pow( (target.y - m_globalPosition.y), 2 ) +
-				 std::pow( (target.z - m_globalPosition.z), 2 ) );
-
-	}
-
-	Kiwi::Matrix4 Transform::GetWorldMatrix()
-	{
-
-		Kiwi::Matrix4 translate = Kiwi::Matrix4::Translation(m_globalPosition);
-		Kiwi::Matrix4 scale = Kiwi::Matrix4::Scaling(m_scale);
-		Kiwi::Matrix4 rotate = m_rotation.ToRotationMatrix();
-		
-		/* using row-major matrices so to get proper scaling when rotating need to use scale*rotate*translate
-		if using column major matrices, need to use rotate*scale*translate */
-		Kiwi::Matrix4 world = (scale * rotate) * translate;
-		return world;
+		return ( std::pow( (target.x - this->_GlobalPosition().x), 2 ) +
+				 std::pow( (target.y - this->_GlobalPosition().y), 2 ) +
+				 std::pow( (target.z - this->_GlobalPosition().z), 2 ) );
 
 	}
 
 	Kiwi::Vector3d Transform::GetForward()const 
 	{ 
-		return m_rotation.RotatePoint(Kiwi::Vector3d::forward()).Normalized(); 
+		return this->_Rotation().RotatePoint(Kiwi::Vector3d::forward()).Normalized(); 
 	}
 
 	Kiwi::Vector3d Transform::GetUp()const 
 	{ 
-		return m_rotation.RotatePoint(Kiwi::Vector3d::up()).Normalized();
+		return this->_Rotation().RotatePoint(Kiwi::Vector3d::up()).Normalized();
 	}
 
 	Kiwi::Vector3d Transform::GetRight()const 
 	{ 
-		return m_rotation.RotatePoint(Kiwi::Vector3d::right()).Normalized();
+		return this->_Rotation().RotatePoint(Kiwi::Vector3d::right()).Normalized();
 	}
 
 };
\ No newline at end of file
@@ -7,8 +7,10 @@
 #include "Vector3d.h"
 #include "Quaternion.h"
 #include "Matrix4.h"
+#include "TransformStore.h"
+#include "MemoryPool.h"
 
-#include "Events\TransformEventBroadcaster.h"
+#include "Events/TransformEventBroadcaster.h"
 
 #include <vector>
 #include <list>
@@ -25,16 +27,16 @@ namespace Kiwi
 		public Kiwi::Component,
 		public Kiwi::TransformEventBroadcaster
 	{
+	friend class TransformStore;
 	protected:
 
 		Kiwi::Rigidbody* m_rigidbody;
 
-		Kiwi::Quaternion m_rotation;
-
-		Kiwi::Vector3d m_position; //local position, relative to the parent, if there is no parent this is the same as the global position
-		Kiwi::Vector3d m_globalPosition;
-
-		Kiwi::Vector3d m_scale;
+		/*the position, rotation and scale live in the scene's transform store
+		the local values are relative to the parent transform, if there is no parent they are the same as the global values
+		the global values and the world matrix are cached in the store and recomputed once per frame for transforms that changed*/
+		Kiwi::TransformStore* m_store;
+		Kiwi::TransformStore::Handle m_handle;
 
 		//stores which axis' are locked
 		bool m_lockYaw, m_lockPitch, m_lockRoll;
@@ -43,15 +45,49 @@ namespace Kiwi
 
 		std::list<Kiwi::Transform*> m_childTransforms;
 
+		/*if true a TransformEvent is broadcast for every change as it happens, otherwise the changes
+		are coalesced and sent once per frame when the transform store dispatches its change list*/
+		bool m_immediateEvents;
+
 	protected:
 
+		virtual void _OnAttached();
+
+		/*moves the transform's data into a different transform store*/
+		void _SetStore( Kiwi::TransformStore& store );
+
+		/*the non-const accessors are for writing, call _RecordChange before changing a value*/
+		Kiwi::Vector3d& _Position() { return m_store->Position( m_handle ); }
+		Kiwi::Quaternion& _Rotation() { return m_store->Rotation( m_handle ); }
+		Kiwi::Vector3d& _Scale() { return m_store->Scale( m_handle ); }
+
+		const Kiwi::Vector3d& _Position()const { return m_store->Position( m_handle ); }
+		const Kiwi::Quaternion& _Rotation()const { return m_store->Rotation( m_handle ); }
+		const Kiwi::Vector3d& _Scale()const { return m_store->Scale( m_handle ); }
+
+		/*returns the cached global position, updating the store's hierarchy first if anything is dirty*/
+		const Kiwi::Vector3d& _GlobalPosition()const { m_store->Resolve(); return m_store->GlobalPosition( m_handle ); }
+
+		/*adds the transform to the store's change list for this frame, call before changing a local value*/
+		void _RecordChange( unsigned char flags ) { m_store->RecordChange( m_handle, flags ); }
+
+		/*sends one coalesced TransformEvent per kind of change to this transform's listeners*/
+		void _BroadcastChange( const Kiwi::TransformChange& change );
+
 		void _TranslateChildren( const Kiwi::Vector3d translation );
-		void _UpdateGlobalPosition();
-		void _UpdateChildTransforms();
+
+		/*returns the transform of the parent entity, if it is of the same type as this transform's entity*/
+		Kiwi::Transform* _FindParentTransform()const;
+
+		/*links this transform to the parent entity's transform in the transform store*/
+		void _UpdateParent();
 
 	public:
 
+		KIWI_DECLARE_POOLED( Transform )
+
 		Transform();
+		Transform( Kiwi::TransformStore& store );
 		~Transform();
 
 		void Update();
@@ -70,11 +106,16 @@ namespace Kiwi
 		void SetGlobalPosition( double x, double y, double z );
 		void SetGlobalPosition( const Kiwi::Vector3d& position );
 
-		void SetHeight(float height) { m_position.y = height; }
+		void SetHeight(float height) { this->_RecordChange( Kiwi::TransformChange::POSITION ); this->_Position().y = height; }
 
-		void SetScale( double scale ) { m_scale.Set( scale, scale, scale ); }
-		void SetScale(const Kiwi::Vector3& scale) { m_scale = scale; }
-		void SetScale( const Kiwi::Vector3d& scale ) { m_scale = scale; }
+		void SetScale( double scale ) { this->_RecordChange( Kiwi::TransformChange::SCALE ); this->_Scale().Set( scale, scale, scale ); }
+		void SetScale(const Kiwi::Vector3& scale) { this->_RecordChange( Kiwi::TransformChange::SCALE ); this->_Scale() = scale; }
+		void SetScale( const Kiwi::Vector3d& scale ) { this->_RecordChange( Kiwi::TransformChange::SCALE ); this->_Scale() = scale; }
+
+		/*enables or disables sending a TransformEvent to the transform's listeners for every change as it happens
+		by default the listeners receive at most one translation and one rotation event per frame*/
+		void SetImmediateEvents( bool immediate ) { m_immediateEvents = immediate; }
+		bool GetImmediateEvents()const { return m_immediateEvents; }
 
 		void AttachTransform( Kiwi::Transform* transform );
 		void DetachTransform( Kiwi::Transform* transform );
@@ -117,12 +158,32 @@ namespace Kiwi
 		/*returns the square of the distance between this transform and the target vector*/
 		double GetSquareDistance(const Kiwi::Vector3d& target);
 
-		const Kiwi::Vector3d& GetGlobalPosition()const { return m_globalPosition; }
-		const Kiwi::Vector3d& GetPosition()const { return m_position; }
-		const Kiwi::Quaternion& GetRotation()const { return m_rotation; }
-		const Kiwi::Vector3d& GetScale()const { return m_scale; }
+		const Kiwi::Vector3d& GetGlobalPosition()const { return this->_GlobalPosition(); }
+		const Kiwi::Vector3d& GetPosition()const { return this->_Position(); }
+		const Kiwi::Quaternion& GetRotation()const { return this->_Rotation(); }
+		const Kiwi::Vector3d& GetScale()const { return this->_Scale(); }
+
+		/*global rotation and scale, combined with those of all parent transforms*/
+		const Kiwi::Quaternion& GetGlobalRotation()const { m_store->Resolve(); return m_store->GlobalRotation( m_handle ); }
+		const Kiwi::Vector3d& GetGlobalScale()const { m_store->Resolve(); return m_store->GlobalScale( m_handle ); }
+
+		/*returns the cached local matrix (scale * rotation * translation)*/
+		const Kiwi::Matrix4& GetLocalMatrix()const { m_store->Resolve(); return m_store->LocalMatrix( m_handle ); }
+
+		Kiwi::TransformStore::Handle GetHandle()const { return m_handle; }
+		Kiwi::TransformStore* GetStore()const { return m_store; }
+
+		/*returns the cached world matrix (the local matrix combined with the parent's world matrix)*/
+		const Kiwi::Matrix4& GetWorldMatrix()const { m_store->Resolve(); return m_store->WorldMatrix( m_handle ); }
+
+		/*world state blended between the state before the last fixed update (alpha = 0) and the current state (alpha = 1)
+		pass GameTimer::GetInterpolationAlpha to render fixed update motion smoothly*/
+		Kiwi::Vector3d GetInterpolatedPosition( double alpha )const { m_store->Resolve(); return m_store->InterpolatedPosition( m_handle, alpha ); }
+		Kiwi::Quaternion GetInterpolatedRotation( double alpha )const { m_store->Resolve(); return m_store->InterpolatedRotation( m_handle, alpha ); }
+		Kiwi::Matrix4 GetInterpolatedWorldMatrix( double alpha )const { m_store->Resolve(); return m_store->InterpolatedWorldMatrix( m_handle, alpha ); }
 
-		Kiwi::Matrix4 GetWorldMatrix();
+		/*renders the transform at its current state until the next fixed update instead of blending, call after teleporting*/
+		void SnapInterpolation() { m_store->SnapFixedState( m_handle ); }
 
 		Kiwi::Vector3d GetForward()const;
 		Kiwi::Vector3d GetUp()const;
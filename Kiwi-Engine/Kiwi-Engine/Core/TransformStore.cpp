@@ -0,0 +1,549 @@
+#include "TransformStore.h"
+#include "Utilities.h"
+#include "Exception.h"
+#include "Transform.h"
+
+#include <algorithm>
+
+namespace Kiwi
+{
+
+	const TransformStore::Handle TransformStore::INVALID_HANDLE;
+
+	TransformStore::TransformStore()
+	{
+
+		m_concurrentWrites = false;
+		m_appendLock.clear();
+
+	}
+
+	TransformStore::~TransformStore()
+	{
+
+		Kiwi::FreeMemory( m_positions );
+		Kiwi::FreeMemory( m_globalPositions );
+		Kiwi::FreeMemory( m_rotations );
+		Kiwi::FreeMemory( m_globalRotations );
+		Kiwi::FreeMemory( m_scales );
+		Kiwi::FreeMemory( m_globalScales );
+		Kiwi::FreeMemory( m_localMatrices );
+		Kiwi::FreeMemory( m_worldMatrices );
+		Kiwi::FreeMemory( m_dirtyFlags );
+		Kiwi::FreeMemory( m_previousPositions );
+		Kiwi::FreeMemory( m_previousRotations );
+		Kiwi::FreeMemory( m_previousScales );
+		Kiwi::FreeMemory( m_hasPrevious );
+		Kiwi::FreeMemory( m_owners );
+		Kiwi::FreeMemory( m_denseToHandle );
+		Kiwi::FreeMemory( m_parents );
+		Kiwi::FreeMemory( m_firstChildren );
+		Kiwi::FreeMemory( m_nextSiblings );
+		Kiwi::FreeMemory( m_prevSiblings );
+		Kiwi::FreeMemory( m_handleToDense );
+		Kiwi::FreeMemory( m_freeHandles );
+		Kiwi::FreeMemory( m_dirtyHandles );
+		Kiwi::FreeMemory( m_propagationQueue );
+		Kiwi::FreeMemory( m_changeIndices );
+		Kiwi::FreeMemory( m_changeFlags );
+		Kiwi::FreeMemory( m_changes );
+		Kiwi::FreeMemory( m_dispatchChanges );
+
+	}
+
+	void TransformStore::Reserve( unsigned int capacity )
+	{
+
+		m_positions.reserve( capacity );
+		m_globalPositions.reserve( capacity );
+		m_rotations.reserve( capacity );
+		m_globalRotations.reserve( capacity );
+		m_scales.reserve( capacity );
+		m_globalScales.reserve( capacity );
+		m_localMatrices.reserve( capacity );
+		m_worldMatrices.reserve( capacity );
+		m_dirtyFlags.reserve( capacity );
+		m_previousPositions.reserve( capacity );
+		m_previousRotations.reserve( capacity );
+		m_previousScales.reserve( capacity );
+		m_hasPrevious.reserve( capacity );
+		m_owners.reserve( capacity );
+		m_denseToHandle.reserve( capacity );
+		m_parents.reserve( capacity );
+		m_firstChildren.reserve( capacity );
+		m_nextSiblings.reserve( capacity );
+		m_prevSiblings.reserve( capacity );
+		m_changeIndices.reserve( capacity );
+		m_changeFlags.reserve( capacity );
+		m_handleToDense.reserve( capacity );
+
+	}
+
+	TransformStore::Handle TransformStore::Create( Kiwi::Transform* owner )
+	{
+
+		Handle handle = INVALID_HANDLE;
+		if( m_freeHandles.size() > 0 )
+		{
+			handle = m_freeHandles.back();
+			m_freeHandles.pop_back();
+
+		} else
+		{
+			handle = (Handle)m_handleToDense.size();
+			m_handleToDense.push_back( INVALID_HANDLE );
+		}
+
+		m_handleToDense[handle] = (unsigned int)m_owners.size();
+
+		m_positions.push_back( Kiwi::Vector3d( 0.0, 0.0, 0.0 ) );
+		m_globalPositions.push_back( Kiwi::Vector3d( 0.0, 0.0, 0.0 ) );
+		m_rotations.push_back( Kiwi::Quaternion::Identity() );
+		m_globalRotations.push_back( Kiwi::Quaternion::Identity() );
+		m_scales.push_back( Kiwi::Vector3d( 1.0, 1.0, 1.0 ) );
+		m_globalScales.push_back( Kiwi::Vector3d( 1.0, 1.0, 1.0 ) );
+		m_localMatrices.push_back( Kiwi::Matrix4() );
+		m_worldMatrices.push_back( Kiwi::Matrix4() );
+		m_dirtyFlags.push_back( 0 );
+		m_previousPositions.push_back( Kiwi::Vector3d( 0.0, 0.0, 0.0 ) );
+		m_previousRotations.push_back( Kiwi::Quaternion::Identity() );
+		m_previousScales.push_back( Kiwi::Vector3d( 1.0, 1.0, 1.0 ) );
+		m_hasPrevious.push_back( 0 );
+		m_owners.push_back( owner );
+		m_denseToHandle.push_back( handle );
+		m_parents.push_back( INVALID_HANDLE );
+		m_firstChildren.push_back( INVALID_HANDLE );
+		m_nextSiblings.push_back( INVALID_HANDLE );
+		m_prevSiblings.push_back( INVALID_HANDLE );
+		m_changeIndices.push_back( INVALID_HANDLE );
+		m_changeFlags.push_back( 0 );
+
+		//the matrices are built by the next hierarchy update
+		this->_SetDirty( m_handleToDense[handle], DIRTY_LOCAL | DIRTY_WORLD );
+
+		return handle;
+
+	}
+
+	void TransformStore::Destroy( Handle handle )
+	{
+
+		if( !this->IsValid( handle ) ) return;
+
+		this->_Unlink( handle );
+
+		//the children become roots
+		Handle child = this->GetFirstChild( handle );
+		while( child != INVALID_HANDLE )
+		{
+			unsigned int childIndex = m_handleToDense[child];
+			Handle next = m_nextSiblings[childIndex];
+
+			m_parents[childIndex] = INVALID_HANDLE;
+			m_nextSiblings[childIndex] = INVALID_HANDLE;
+			m_prevSiblings[childIndex] = INVALID_HANDLE;
+			this->_SetDirty( childIndex, DIRTY_WORLD );
+
+			child = next;
+		}
+
+		unsigned int index = m_handleToDense[handle];
+		unsigned int last = (unsigned int)m_owners.size() - 1;
+
+		//keep the entry in the change list so indices stay valid, but mark it as destroyed
+		if( m_changeIndices[index] != INVALID_HANDLE )
+		{
+			m_changes[m_changeIndices[index]].transform = 0;
+			m_changes[m_changeIndices[index]].handle = INVALID_HANDLE;
+		}
+
+		if( index != last )
+		{
+			//move the last element into the freed slot to keep the arrays packed
+			m_positions[index] = m_positions[last];
+			m_globalPositions[index] = m_globalPositions[last];
+			m_rotations[index] = m_rotations[last];
+			m_globalRotations[index] = m_globalRotations[last];
+			m_scales[index] = m_scales[last];
+			m_globalScales[index] = m_globalScales[last];
+			m_localMatrices[index] = m_localMatrices[last];
+			m_worldMatrices[index] = m_worldMatrices[last];
+			m_dirtyFlags[index] = m_dirtyFlags[last];
+			m_previousPositions[index] = m_previousPositions[last];
+			m_previousRotations[index] = m_previousRotations[last];
+			m_previousScales[index] = m_previousScales[last];
+			m_hasPrevious[index] = m_hasPrevious[last];
+			m_owners[index] = m_owners[last];
+			m_denseToHandle[index] = m_denseToHandle[last];
+			m_parents[index] = m_parents[last];
+			m_firstChildren[index] = m_firstChildren[last];
+			m_nextSiblings[index] = m_nextSiblings[last];
+			m_prevSiblings[index] = m_prevSiblings[last];
+			m_changeIndices[index] = m_changeIndices[last];
+			m_changeFlags[index] = m_changeFlags[last];
+
+			m_handleToDense[m_denseToHandle[index]] = index;
+		}
+
+		m_positions.pop_back();
+		m_globalPositions.pop_back();
+		m_rotations.pop_back();
+		m_globalRotations.pop_back();
+		m_scales.pop_back();
+		m_globalScales.pop_back();
+		m_localMatrices.pop_back();
+		m_worldMatrices.pop_back();
+		m_dirtyFlags.pop_back();
+		m_previousPositions.pop_back();
+		m_previousRotations.pop_back();
+		m_previousScales.pop_back();
+		m_hasPrevious.pop_back();
+		m_owners.pop_back();
+		m_denseToHandle.pop_back();
+		m_parents.pop_back();
+		m_firstChildren.pop_back();
+		m_nextSiblings.pop_back();
+		m_prevSiblings.pop_back();
+		m_changeIndices.pop_back();
+		m_changeFlags.pop_back();
+
+		m_handleToDense[handle] = INVALID_HANDLE;
+		m_freeHandles.push_back( handle );
+
+	}
+
+	TransformStore::Handle TransformStore::MoveFrom( Kiwi::TransformStore& source, Handle handle )
+	{
+
+		if( &source == this || !source.IsValid( handle ) )
+		{
+			return handle;
+		}
+
+		unsigned int sourceIndex = source.m_handleToDense[handle];
+
+		//only the local data is moved, the hierarchy links refer to handles in the source store
+		//and the new slot starts out as a dirty root
+		Handle newHandle = this->Create( source.m_owners[sourceIndex] );
+		this->Position( newHandle ) = source.m_positions[sourceIndex];
+		this->Rotation( newHandle ) = source.m_rotations[sourceIndex];
+		this->Scale( newHandle ) = source.m_scales[sourceIndex];
+
+		source.Destroy( handle );
+
+		return newHandle;
+
+	}
+
+	void TransformStore::_SetDirty( unsigned int index, unsigned char flags )
+	{
+
+		if( m_dirtyFlags[index] == 0 )
+		{
+			this->_LockAppend();
+			m_dirtyHandles.push_back( m_denseToHandle[index] );
+			this->_UnlockAppend();
+		}
+		m_dirtyFlags[index] |= flags;
+
+	}
+
+	void TransformStore::RecordChange( Handle handle, unsigned char flags )
+	{
+
+		unsigned int index = m_handleToDense[handle];
+
+		//only the first change of the frame touches the shared list
+		if( m_changeIndices[index] == INVALID_HANDLE )
+		{
+			Kiwi::TransformChange change;
+			change.transform = m_owners[index];
+			change.handle = handle;
+			change.flags = 0;
+			change.startPosition = m_positions[index];
+			change.startRotation = m_rotations[index];
+			change.startScale = m_scales[index];
+
+			this->_LockAppend();
+			m_changeIndices[index] = (unsigned int)m_changes.size();
+			m_changes.push_back( change );
+			this->_UnlockAppend();
+		}
+
+		m_changeFlags[index] |= flags;
+
+		this->_SetDirty( index, DIRTY_LOCAL | DIRTY_WORLD );
+
+	}
+
+	void TransformStore::DispatchChanges()
+	{
+
+		if( m_changes.size() == 0 ) return;
+
+		//swap the list out first so that changes made by listeners go into the next frame's list
+		m_dispatchChanges.swap( m_changes );
+		m_changes.clear();
+		for( unsigned int i = 0; i < m_dispatchChanges.size(); i++ )
+		{
+			if( m_dispatchChanges[i].handle != INVALID_HANDLE )
+			{
+				unsigned int index = m_handleToDense[m_dispatchChanges[i].handle];
+				m_dispatchChanges[i].flags = m_changeFlags[index];
+				m_changeFlags[index] = 0;
+				m_changeIndices[index] = INVALID_HANDLE;
+			}
+		}
+
+		this->BroadcastTransformChangeEvent( Kiwi::TransformChangeEvent( this, m_dispatchChanges ) );
+
+		for( unsigned int i = 0; i < m_dispatchChanges.size(); i++ )
+		{
+			if( m_dispatchChanges[i].transform != 0 )
+			{
+				m_dispatchChanges[i].transform->_BroadcastChange( m_dispatchChanges[i] );
+			}
+		}
+
+		m_dispatchChanges.clear();
+
+	}
+
+	void TransformStore::SortChanges()
+	{
+
+		std::sort( m_changes.begin(), m_changes.end(), []( const Kiwi::TransformChange& c1, const Kiwi::TransformChange& c2 ) { return c1.handle < c2.handle; } );
+
+		for( unsigned int i = 0; i < m_changes.size(); i++ )
+		{
+			if( m_changes[i].handle != INVALID_HANDLE )
+			{
+				m_changeIndices[m_handleToDense[m_changes[i].handle]] = i;
+			}
+		}
+
+	}
+
+	void TransformStore::_Unlink( Handle handle )
+	{
+
+		unsigned int index = m_handleToDense[handle];
+		Handle parent = m_parents[index];
+		if( parent == INVALID_HANDLE ) return;
+
+		Handle prev = m_prevSiblings[index];
+		Handle next = m_nextSiblings[index];
+
+		if( prev != INVALID_HANDLE )
+		{
+			m_nextSiblings[m_handleToDense[prev]] = next;
+
+		} else
+		{
+			m_firstChildren[m_handleToDense[parent]] = next;
+		}
+
+		if( next != INVALID_HANDLE )
+		{
+			m_prevSiblings[m_handleToDense[next]] = prev;
+		}
+
+		m_parents[index] = INVALID_HANDLE;
+		m_nextSiblings[index] = INVALID_HANDLE;
+		m_prevSiblings[index] = INVALID_HANDLE;
+
+	}
+
+	void TransformStore::SetParent( Handle handle, Handle parent )
+	{
+
+		if( !this->IsValid( handle ) )
+		{
+			throw Kiwi::Exception( L"TransformStore::SetParent", L"Invalid transform handle" );
+		}
+
+		if( parent != INVALID_HANDLE && !this->IsValid( parent ) )
+		{
+			throw Kiwi::Exception( L"TransformStore::SetParent", L"Invalid parent handle" );
+		}
+
+		if( this->GetParent( handle ) == parent ) return;
+
+		//make sure the new parent is not a descendant of the transform
+		for( Handle ancestor = parent; ancestor != INVALID_HANDLE; ancestor = this->GetParent( ancestor ) )
+		{
+			if( ancestor == handle )
+			{
+				throw Kiwi::Exception( L"TransformStore::SetParent", L"A transform cannot be parented to one of its own descendants" );
+			}
+		}
+
+		this->_Unlink( handle );
+
+		unsigned int index = m_handleToDense[handle];
+
+		if( parent != INVALID_HANDLE )
+		{
+			unsigned int parentIndex = m_handleToDense[parent];
+			Handle first = m_firstChildren[parentIndex];
+
+			m_parents[index] = parent;
+			m_nextSiblings[index] = first;
+			if( first != INVALID_HANDLE )
+			{
+				m_prevSiblings[m_handleToDense[first]] = handle;
+			}
+			m_firstChildren[parentIndex] = handle;
+		}
+
+		this->_SetDirty( index, DIRTY_WORLD );
+
+	}
+
+	void TransformStore::_ComputeWorld( unsigned int index )
+	{
+
+		if( m_dirtyFlags[index] & DIRTY_LOCAL )
+		{
+			/* using row-major matrices so to get proper scaling when rotating need to use scale*rotate*translate
+			if using column major matrices, need to use rotate*scale*translate */
+			Kiwi::Quaternion rotation = m_rotations[index];
+			m_localMatrices[index] = (Kiwi::Matrix4::Scaling( m_scales[index] ) * rotation.ToRotationMatrix()) * Kiwi::Matrix4::Translation( m_positions[index] );
+		}
+
+		Handle parent = m_parents[index];
+		if( parent == INVALID_HANDLE )
+		{
+			m_worldMatrices[index] = m_localMatrices[index];
+			m_globalPositions[index] = m_positions[index];
+			m_globalRotations[index] = m_rotations[index];
+			m_globalScales[index] = m_scales[index];
+
+		} else
+		{
+			unsigned int parentIndex = m_handleToDense[parent];
+			const Kiwi::Vector3d& parentScale = m_globalScales[parentIndex];
+			const Kiwi::Vector3d& localPosition = m_positions[index];
+			const Kiwi::Vector3d& localScale = m_scales[index];
+
+			//the local transform is applied first, then the parent's world transform
+			m_worldMatrices[index] = m_localMatrices[index] * m_worldMatrices[parentIndex];
+
+			Kiwi::Vector3d scaledPosition( localPosition.x * parentScale.x, localPosition.y * parentScale.y, localPosition.z * parentScale.z );
+			m_globalPositions[index] = m_globalPositions[parentIndex] + Kiwi::Vector3d( m_globalRotations[parentIndex].RotatePoint( scaledPosition ) );
+			m_globalRotations[index] = m_globalRotations[parentIndex].Cross( m_rotations[index] ).Normalized();
+			m_globalScales[index].Set( localScale.x * parentScale.x, localScale.y * parentScale.y, localScale.z * parentScale.z );
+		}
+
+	}
+
+	void TransformStore::UpdateHierarchy()
+	{
+
+		//index based, the list is not modified during the pass
+		for( unsigned int i = 0; i < m_dirtyHandles.size(); i++ )
+		{
+			Handle root = m_dirtyHandles[i];
+
+			//the slot was destroyed, or already updated as part of a dirty ancestor's subtree
+			if( !this->IsValid( root ) || m_dirtyFlags[m_handleToDense[root]] == 0 ) continue;
+
+			//if an ancestor is dirty its pass will include this slot
+			bool ancestorDirty = false;
+			for( Handle ancestor = this->GetParent( root ); ancestor != INVALID_HANDLE; ancestor = this->GetParent( ancestor ) )
+			{
+				if( m_dirtyFlags[m_handleToDense[ancestor]] != 0 )
+				{
+					ancestorDirty = true;
+					break;
+				}
+			}
+			if( ancestorDirty ) continue;
+
+			//breadth first, so each parent's world data is ready before its children are visited
+			m_propagationQueue.clear();
+			m_propagationQueue.push_back( root );
+			for( unsigned int q = 0; q < m_propagationQueue.size(); q++ )
+			{
+				unsigned int index = m_handleToDense[m_propagationQueue[q]];
+
+				this->_ComputeWorld( index );
+				m_dirtyFlags[index] = 0;
+
+				for( Handle child = m_firstChildren[index]; child != INVALID_HANDLE; child = m_nextSiblings[m_handleToDense[child]] )
+				{
+					m_propagationQueue.push_back( child );
+				}
+			}
+		}
+
+		m_dirtyHandles.clear();
+
+	}
+
+	void TransformStore::SaveFixedState()
+	{
+
+		this->Resolve();
+
+		//straight copies of the dense world arrays
+		m_previousPositions = m_globalPositions;
+		m_previousRotations = m_globalRotations;
+		m_previousScales = m_globalScales;
+		std::fill( m_hasPrevious.begin(), m_hasPrevious.end(), (unsigned char)1 );
+
+	}
+
+	Kiwi::Vector3d TransformStore::InterpolatedPosition( Handle handle, double alpha )const
+	{
+
+		unsigned int index = m_handleToDense[handle];
+		if( m_hasPrevious[index] == 0 )
+		{
+			return m_globalPositions[index];
+		}
+
+		return Kiwi::Vector3d::Lerp( m_previousPositions[index], m_globalPositions[index], alpha );
+
+	}
+
+	Kiwi::Quaternion TransformStore::InterpolatedRotation( Handle handle, double alpha )const
+	{
+
+		unsigned int index = m_handleToDense[handle];
+		if( m_hasPrevious[index] == 0 )
+		{
+			return m_globalRotations[index];
+		}
+
+		return Kiwi::Quaternion::Nlerp( m_previousRotations[index], m_globalRotations[index], alpha );
+
+	}
+
+	Kiwi::Matrix4 TransformStore::InterpolatedWorldMatrix( Handle handle, double alpha )const
+	{
+
+		unsigned int index = m_handleToDense[handle];
+		if( m_hasPrevious[index] == 0 )
+		{
+			return m_worldMatrices[index];
+		}
+
+		Kiwi::Vector3d scale = Kiwi::Vector3d::Lerp( m_previousScales[index], m_globalScales[index], alpha );
+		Kiwi::Quaternion rotation = Kiwi::Quaternion::Nlerp( m_previousRotations[index], m_globalRotations[index], alpha );
+		Kiwi::Vector3d position = Kiwi::Vector3d::Lerp( m_previousPositions[index], m_globalPositions[index], alpha );
+
+		//built from the blended world values the same way _ComputeWorld builds a local matrix (scale * rotate * translate)
+		return (Kiwi::Matrix4::Scaling( scale ) * rotation.ToRotationMatrix()) * Kiwi::Matrix4::Translation( position );
+
+	}
+
+	Kiwi::TransformStore& TransformStore::Detached()
+	{
+
+		static Kiwi::TransformStore detachedStore;
+		return detachedStore;
+
+	}
+
+}
@@ -0,0 +1,221 @@
+#ifndef _KIWI_TRANSFORMSTORE_H_
+#define _KIWI_TRANSFORMSTORE_H_
+
+#include "Vector3d.h"
+#include "Quaternion.h"
+#include "Matrix4.h"
+
+#include "Events/TransformChangeEventBroadcaster.h"
+
+#include <vector>
+#include <atomic>
+
+namespace Kiwi
+{
+
+	class Transform;
+
+	/*stores the hot data of every transform in a scene (position, rotation, scale) in contiguous
+	structure-of-arrays form. Transforms hold a handle into the store instead of owning the data.
+	the dense arrays are kept packed (destroyed slots are filled by swapping in the last element)
+	so that passes over all transforms walk memory linearly
+
+	the store also keeps the transform hierarchy (parent/child links between handles) and caches each
+	transform's local and world matrix. changing a local value only marks the slot dirty, UpdateHierarchy
+	then recomputes the world data of every dirty slot and its descendants in one breadth-first pass
+
+	changes are also recorded into a per-frame change list (one entry per transform) which DispatchChanges
+	sends to the store's change listeners and, coalesced, to each transform's own listeners
+
+	SaveFixedState keeps a copy of the world position, rotation and scale as they were before the last fixed update
+	so the renderer can blend between the previous and current fixed state (see GameTimer::GetInterpolationAlpha)*/
+	class TransformStore :
+		public Kiwi::TransformChangeEventBroadcaster
+	{
+	public:
+
+		typedef unsigned int Handle;
+
+		static const Handle INVALID_HANDLE = 0xFFFFFFFF;
+
+		enum DIRTY_FLAGS { DIRTY_LOCAL = 1, DIRTY_WORLD = 2 };
+
+	protected:
+
+		//dense arrays, all indexed by the same dense index
+		std::vector<Kiwi::Vector3d> m_positions; //local positions
+		std::vector<Kiwi::Vector3d> m_globalPositions;
+		std::vector<Kiwi::Quaternion> m_rotations;
+		std::vector<Kiwi::Quaternion> m_globalRotations;
+		std::vector<Kiwi::Vector3d> m_scales;
+		std::vector<Kiwi::Vector3d> m_globalScales;
+		std::vector<Kiwi::Matrix4> m_localMatrices;
+		std::vector<Kiwi::Matrix4> m_worldMatrices;
+		std::vector<unsigned char> m_dirtyFlags;
+
+		//world state saved by SaveFixedState, and whether it has been saved since the slot was created or snapped
+		std::vector<Kiwi::Vector3d> m_previousPositions;
+		std::vector<Kiwi::Quaternion> m_previousRotations;
+		std::vector<Kiwi::Vector3d> m_previousScales;
+		std::vector<unsigned char> m_hasPrevious;
+
+		std::vector<Kiwi::Transform*> m_owners;
+		std::vector<Handle> m_denseToHandle;
+
+		//hierarchy links, stored as handles so they survive the dense arrays being repacked
+		std::vector<Handle> m_parents;
+		std::vector<Handle> m_firstChildren;
+		std::vector<Handle> m_nextSiblings;
+		std::vector<Handle> m_prevSiblings;
+
+		//sparse array mapping a handle to its current dense index
+		std::vector<unsigned int> m_handleToDense;
+
+		//handles that have been destroyed and can be reused
+		std::vector<Handle> m_freeHandles;
+
+		//handles that were marked dirty since the last UpdateHierarchy (a slot is only listed once while it stays dirty)
+		std::vector<Handle> m_dirtyHandles;
+
+		//scratch queue for the breadth-first propagation pass, kept to avoid reallocating each frame
+		std::vector<Handle> m_propagationQueue;
+
+		//index of each slot's entry in m_changes, or INVALID_HANDLE if it has not changed this frame (dense)
+		std::vector<unsigned int> m_changeIndices;
+
+		//TransformChange::CHANGE_FLAGS accumulated by each slot since the last dispatch (dense)
+		//kept per slot so changing an already recorded transform does not touch the shared change list
+		std::vector<unsigned char> m_changeFlags;
+
+		//transforms changed since the last dispatch, and the list being dispatched
+		Kiwi::TransformChangeList m_changes;
+		Kiwi::TransformChangeList m_dispatchChanges;
+
+		/*set while transforms are changed from several threads at once (see SetConcurrentWrites)
+		appends to the dirty and change lists are then guarded by a spin lock*/
+		bool m_concurrentWrites;
+		std::atomic_flag m_appendLock;
+
+	protected:
+
+		void _LockAppend() { if( m_concurrentWrites ) { while( m_appendLock.test_and_set( std::memory_order_acquire ) ) {} } }
+		void _UnlockAppend() { if( m_concurrentWrites ) m_appendLock.clear( std::memory_order_release ); }
+
+		void _SetDirty( unsigned int index, unsigned char flags );
+
+		/*recomputes the world data of the slot from its local data and its parent's world data*/
+		void _ComputeWorld( unsigned int index );
+
+		void _Unlink( Handle handle );
+
+	public:
+
+		TransformStore();
+		~TransformStore();
+
+		/*reserves space for the given number of transforms*/
+		void Reserve( unsigned int capacity );
+
+		/*allocates a new slot, initialized to the identity transform, and returns its handle*/
+		Handle Create( Kiwi::Transform* owner );
+
+		/*frees the slot belonging to the handle. the handle must not be used afterwards*/
+		void Destroy( Handle handle );
+
+		/*copies the data belonging to 'handle' in 'source' into a new slot in this store, and destroys the source slot
+		returns the handle of the new slot*/
+		Handle MoveFrom( Kiwi::TransformStore& source, Handle handle );
+
+		bool IsValid( Handle handle )const { return handle < m_handleToDense.size() && m_handleToDense[handle] != INVALID_HANDLE; }
+
+		/*marks the local position, rotation or scale of the slot as changed
+		the world data of the slot and its descendants is recomputed by the next UpdateHierarchy*/
+		void MarkDirty( Handle handle ) { this->_SetDirty( m_handleToDense[handle], DIRTY_LOCAL | DIRTY_WORLD ); }
+
+		/*records the slot in this frame's change list and marks it dirty
+		must be called before the local values are modified so the starting values can be saved
+		'flags' is a combination of TransformChange::CHANGE_FLAGS*/
+		void RecordChange( Handle handle, unsigned char flags );
+
+		/*sends the changes recorded since the last dispatch to the change listeners and clears the list
+		changes made by the listeners are recorded for the next dispatch*/
+		void DispatchChanges();
+
+		/*sorts the pending change list by handle, so its order does not depend on which thread recorded a change first*/
+		void SortChanges();
+
+		/*the pending change list. the flags of each entry are filled in by DispatchChanges*/
+		const Kiwi::TransformChangeList& GetChanges()const { return m_changes; }
+
+		/*allows different threads to change different transforms at the same time, used by the parallel entity update
+		while enabled, creating/destroying slots and changing parents are not allowed, and Resolve does nothing
+		so reads of world data return the values of the last hierarchy update*/
+		void SetConcurrentWrites( bool concurrent ) { m_concurrentWrites = concurrent; }
+		bool GetConcurrentWrites()const { return m_concurrentWrites; }
+
+		/*makes 'parent' the parent of the slot (INVALID_HANDLE to make it a root). both handles must belong to this store*/
+		void SetParent( Handle handle, Handle parent );
+
+		Handle GetParent( Handle handle )const { return m_parents[m_handleToDense[handle]]; }
+		Handle GetFirstChild( Handle handle )const { return m_firstChildren[m_handleToDense[handle]]; }
+		Handle GetNextSibling( Handle handle )const { return m_nextSiblings[m_handleToDense[handle]]; }
+
+		/*recomputes the world data of all dirty slots and their descendants, once per slot, breadth first*/
+		void UpdateHierarchy();
+
+		/*brings the cached world data up to date if anything has changed since the last update
+		called before reading world data outside of the per-frame pass*/
+		void Resolve() { if( !m_concurrentWrites && m_dirtyHandles.size() > 0 ) this->UpdateHierarchy(); }
+
+		bool IsDirty()const { return m_dirtyHandles.size() > 0; }
+
+		/*returns the number of slots waiting for the next UpdateHierarchy*/
+		unsigned int GetDirtyCount()const { return (unsigned int)m_dirtyHandles.size(); }
+
+		Kiwi::Vector3d& Position( Handle handle ) { return m_positions[m_handleToDense[handle]]; }
+		Kiwi::Quaternion& Rotation( Handle handle ) { return m_rotations[m_handleToDense[handle]]; }
+		Kiwi::Vector3d& Scale( Handle handle ) { return m_scales[m_handleToDense[handle]]; }
+
+		const Kiwi::Vector3d& Position( Handle handle )const { return m_positions[m_handleToDense[handle]]; }
+		const Kiwi::Quaternion& Rotation( Handle handle )const { return m_rotations[m_handleToDense[handle]]; }
+		const Kiwi::Vector3d& Scale( Handle handle )const { return m_scales[m_handleToDense[handle]]; }
+
+		/*cached world data, only valid after UpdateHierarchy/Resolve*/
+		const Kiwi::Vector3d& GlobalPosition( Handle handle )const { return m_globalPositions[m_handleToDense[handle]]; }
+		const Kiwi::Quaternion& GlobalRotation( Handle handle )const { return m_globalRotations[m_handleToDense[handle]]; }
+		const Kiwi::Vector3d& GlobalScale( Handle handle )const { return m_globalScales[m_handleToDense[handle]]; }
+		const Kiwi::Matrix4& LocalMatrix( Handle handle )const { return m_localMatrices[m_handleToDense[handle]]; }
+		const Kiwi::Matrix4& WorldMatrix( Handle handle )const { return m_worldMatrices[m_handleToDense[handle]]; }
+
+		/*saves the current world position, rotation and scale of every slot as the previous fixed state
+		called before each fixed update*/
+		void SaveFixedState();
+
+		/*makes the slot render at its current state until the next SaveFixedState, used after teleporting a transform*/
+		void SnapFixedState( Handle handle ) { m_hasPrevious[m_handleToDense[handle]] = 0; }
+
+		/*blends the saved and the current world state, 'alpha' is between 0 (previous) and 1 (current)
+		slots without a saved state return the current state. the matrix is rebuilt from the blended world values
+		so shear from non-uniform scale under a rotated parent is not reproduced*/
+		Kiwi::Vector3d InterpolatedPosition( Handle handle, double alpha )const;
+		Kiwi::Quaternion InterpolatedRotation( Handle handle, double alpha )const;
+		Kiwi::Matrix4 InterpolatedWorldMatrix( Handle handle, double alpha )const;
+
+		/*returns the number of live transforms (the length of the dense arrays)*/
+		unsigned int GetCount()const { return (unsigned int)m_owners.size(); }
+
+		/*direct access to the dense arrays, for systems that stream over every transform*/
+		Kiwi::Vector3d* GetPositions() { return m_positions.data(); }
+		Kiwi::Vector3d* GetGlobalPositions() { return m_globalPositions.data(); }
+		Kiwi::Quaternion* GetRotations() { return m_rotations.data(); }
+		Kiwi::Vector3d* GetScales() { return m_scales.data(); }
+		Kiwi::Matrix4* GetWorldMatrices() { return m_worldMatrices.data(); }
+		Kiwi::Transform** GetOwners() { return m_owners.data(); }
+
+		/*returns the transform store used by transforms that are not attached to an entity in a scene*/
+		static Kiwi::TransformStore& Detached();
+
+	};
+}
+
+#endif
@@ -1,13 +1,24 @@
 #include "Utilities.h"
 #include "Math.h"
 
+#ifndef KIWI_HEADLESS
 #include "../Graphics/DirectX.h"
 
 #include <Windows.h>
+#else
+#include <iostream>
+#include <locale>
+#include <codecvt>
+#endif
+
+#ifdef __unix__
+#include <unistd.h>
+#endif
 
 namespace Kiwi
 {
 
+#ifndef KIWI_HEADLESS
 	std::wstring s2ws(const std::string& s1)
 	{
 		int size_needed = MultiByteToWideChar(CP_UTF8, 0, &s1[0], (int)s1.size(), NULL, 0);
@@ -24,42 +35,80 @@ namespace Kiwi
 		return wstr;
 	}
 
-	double Lerp( double lower, double upper, double t )
+	std::string ws2s(const std::wstring& ws)
 	{
-		Kiwi::clamp( t, 0.0, 1.0 );
-		return lower + t * (upper - lower);
+		int size_needed = WideCharToMultiByte(CP_UTF8, 0, &ws[0], (int)ws.size(), NULL, 0, NULL, NULL);
+		std::string str( size_needed, 0 );
+		WideCharToMultiByte(CP_UTF8, 0, &ws[0], (int)ws.size(), &str[0], size_needed, NULL, NULL);
+		return str;
 	}
 
-	double CosineInterpolate( double lower, double upper, double t )
+	void ShowError( const std::wstring& caption, const std::wstring& message )
+	{
+		MessageBox( NULL, message.c_str(), caption.c_str(), MB_OK );
+	}
+#else
+	std::wstring s2ws(const std::string& s1)
 	{
+		std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
+		return converter.from_bytes( s1 );
+	}
 
-		double ft = t * KIWI_PI;
-		double f = (1 - cos( ft )) * 0.5;
+	std::wstring c2ws(const char cString[], int length)
+	{
+		std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
+		return converter.from_bytes( cString, cString + length );
+	}
 
-		return lower * (1 - f) + upper * f;
+	std::string ws2s(const std::wstring& ws)
+	{
+		std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
+		return converter.to_bytes( ws );
+	}
 
+	void ShowError( const std::wstring& caption, const std::wstring& message )
+	{
+		std::wcerr << caption << L": " << message << std::endl;
 	}
+#endif
 
-	std::wstring HRToHexString( HRESULT hr )
+	double Lerp( double lower, double upper, double t )
 	{
+		Kiwi::clamp( t, 0.0, 1.0 );
+		return lower + t * (upper - lower);
+	}
 
-		std::wstringstream wStr;
+	double CosineInterpolate( double lower, double upper, double t )
+	{
 
-		wStr << std::hex << hr;
+		double ft = t * KIWI_PI;
+		double f = (1 - cos( ft )) * 0.5;
 
-		return wStr.str();
+		return lower * (1 - f) + upper * f;
 
 	}
 
 	MemInfo GetSysMemInfo()
 	{
 
+		MemInfo info = MemInfo();
+
+#ifdef KIWI_HEADLESS
+#ifdef __unix__
+		//only the physical memory is known portably
+		unsigned long long pageSize = (unsigned long long)sysconf( _SC_PAGESIZE );
+		info.totalPhysical = (unsigned long long)sysconf( _SC_PHYS_PAGES ) * pageSize;
+		info.availablePhysical = (unsigned long long)sysconf( _SC_AVPHYS_PAGES ) * pageSize;
+		if( info.totalPhysical > 0 )
+		{
+			info.percentInUse = (unsigned long)(100 - (info.availablePhysical * 100) / info.totalPhysical);
+		}
+#endif
+#else
 		MEMORYSTATUSEX statex;
 		statex.dwLength = sizeof( statex );
 		GlobalMemoryStatusEx( &statex );
 
-		MemInfo info;
-
 		info.percentInUse = statex.dwMemoryLoad;
 		info.totalPhysical = statex.ullTotalPhys;
 		info.totalPaging = statex.ullTotalPageFile;
@@ -67,10 +116,23 @@ namespace Kiwi
 		info.availablePhysical = statex.ullAvailPhys;
 		info.availablePaging = statex.ullAvailPageFile;
 		info.availableVirtual = statex.ullAvailVirtual;
+#endif
 
 		return info;
 	}
 
+#ifndef KIWI_HEADLESS
+	std::wstring HRToHexString( HRESULT hr )
+	{
+
+		std::wstringstream wStr;
+
+		wStr << std::hex << hr;
+
+		return wStr.str();
+
+	}
+
 	//takes the hresult error from a D3D call and converts it to a string representation
 	std::wstring GetD3DErrorString(HRESULT hr)
 	{
@@ -309,5 +371,6 @@ namespace Kiwi
 		return error;
 
 	}
+#endif
 
 };
\ No newline at end of file
@@ -1,10 +1,15 @@
 #ifndef _KIWI_UTILITIES_H_
 #define _KIWI_UTILITIES_H_
 
+#include "Platform.h"
+
 #include <string>
 #include <sstream>
 #include <math.h>
+
+#ifndef KIWI_HEADLESS
 #include <Windows.h>
+#endif
 
 #define SAFE_RELEASE(p) { if(p){ (p)->Release(); (p) = 0; } }
 #define SAFE_DELETE(p) { if(p){ delete (p); (p) = 0; } }
@@ -15,11 +20,26 @@ namespace Kiwi
 	std::wstring s2ws(const std::string& s1);
 	std::wstring c2ws(const char cString[], int length);
 
+	/*converts a wide string to UTF-8*/
+	std::string ws2s(const std::wstring& ws);
+
+	/*returns the path in the form the standard file streams take: the wide path on Windows, UTF-8 everywhere else*/
+#ifdef _WIN32
+	inline const std::wstring& ToNativePath( const std::wstring& path ) { return path; }
+#else
+	inline std::string ToNativePath( const std::wstring& path ) { return Kiwi::ws2s( path ); }
+#endif
+
+	/*shows an error message box, or writes the message to stderr in headless builds*/
+	void ShowError( const std::wstring& caption, const std::wstring& message );
+
+#ifndef KIWI_HEADLESS
 	//takes the hresult error from a D3D call and converts it to a string representation
 	std::wstring GetD3DErrorString(HRESULT hr);
 
 	/*returns a string containing the hex representation of the hresult*/
 	std::wstring HRToHexString( HRESULT hr );
+#endif
 
 	double Lerp( double lower, double upper, double percent );
 	double CosineInterpolate( double lower, double upper, double percent );
@@ -2,6 +2,7 @@
 #include "Vector3d.h"
 
 #include <sstream>
+#include <cmath>
 
 namespace Kiwi
 {
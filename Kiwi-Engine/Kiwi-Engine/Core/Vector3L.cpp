@@ -1,6 +1,7 @@
 #include "Vector3L.h"
 
 #include <sstream>
+#include <cmath>
 
 namespace Kiwi
 {
@@ -40,7 +41,7 @@ namespace Kiwi
 	long long Vector3L::Magnitude()const
 	{
 
-		return (long long)std::sqrtl( (long double)(x*x + y*y + z*z) );
+		return (long long)std::sqrt( (long double)(x*x + y*y + z*z) );
 
 	}
 
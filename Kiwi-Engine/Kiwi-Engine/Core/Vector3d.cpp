@@ -1,6 +1,7 @@
 #include "Vector3d.h"
 
 #include <sstream>
+#include <cmath>
 
 namespace Kiwi
 {
@@ -58,7 +59,7 @@ namespace Kiwi
 	double Vector3d::Magnitude()const
 	{
 
-		return (double)std::sqrtl( (long double)(x*x + y*y + z*z) );
+		return (double)std::sqrt( (long double)(x*x + y*y + z*z) );
 
 	}
 
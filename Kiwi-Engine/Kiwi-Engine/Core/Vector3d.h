@@ -5,6 +5,7 @@
 #include "Vector3L.h"
 
 #include <string>
+#include <cmath>
 
 namespace Kiwi
 {
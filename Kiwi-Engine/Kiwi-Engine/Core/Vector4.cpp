@@ -1,6 +1,7 @@
 #include "Vector4.h"
 
 #include <sstream>
+#include <cmath>
 
 namespace Kiwi
 {
@@ -1,8 +1,8 @@
 #include "BlendState.h"
 #include "DirectX.h"
 
-#include "..\Core\Utilities.h"
-#include "..\Core\Exception.h"
+#include "../Core/Utilities.h"
+#include "../Core/Exception.h"
 
 namespace Kiwi
 {
@@ -1,7 +1,7 @@
 #ifndef _KIWI_BLENDSTATE_H_
 #define _KIWI_BLENDSTATE_H_
 
-#include "..\Core\Vector4.h"
+#include "../Core/Vector4.h"
 
 #include <string>
 
@@ -1,11 +1,15 @@
 #include "Camera.h"
 #include "Viewport.h"
-#include "RenderWindow.h"
 
 #include "../Core/Math.h"
 #include "../Core/Transform.h"
 #include "../Core/Exception.h"
 #include "../Core/Scene.h"
+#include "../Core/Platform.h"
+
+#ifndef KIWI_HEADLESS
+#include "RenderWindow.h"
+#endif
 
 namespace Kiwi
 {
@@ -14,7 +18,7 @@ namespace Kiwi
 		Kiwi::Entity(name, scene)
 	{
 
-		assert( m_scene != 0 && m_scene->GetRenderWindow() != 0);
+		assert( m_scene != 0 );
 
 		m_fov = 0.785398f; //PI / 4
 		m_aspectRatio = 1.777777f; //16:9
@@ -23,7 +27,7 @@ namespace Kiwi
 
 		m_projMatrix = Kiwi::Matrix4::Projection( m_fov, m_aspectRatio, m_nearClipDistance, m_farClipDistance );
 
-		Kiwi::Vector2 windowSize = m_scene->GetRenderWindow()->GetClientSize();
+		Kiwi::Vector2 windowSize = this->_GetTargetSize();
 
 		m_orthoMatrix = Kiwi::Matrix4::Orthographic( windowSize.x, windowSize.y, m_nearClipDistance, m_farClipDistance );
 
@@ -39,13 +43,15 @@ namespace Kiwi
 
 		this->_CalculateViewMatrix();
 
+		m_scene->_RegisterCamera( this );
+
 	}
 
 	Camera::Camera( std::wstring name, Kiwi::Scene& scene, float FOV, float aspectRatio, float nearClip, float farClip ):
 		Kiwi::Entity( name, scene )
 	{
 
-		assert( m_scene != 0 && m_scene->GetRenderWindow() != 0 );
+		assert( m_scene != 0 );
 
 		m_fov = FOV;
 		m_aspectRatio = aspectRatio;
@@ -54,7 +60,7 @@ namespace Kiwi
 
 		m_projMatrix = Kiwi::Matrix4::Projection( m_fov, m_aspectRatio, m_nearClipDistance, m_farClipDistance );
 
-		Kiwi::Vector2 windowSize = m_scene->GetRenderWindow()->GetClientSize();
+		Kiwi::Vector2 windowSize = this->_GetTargetSize();
 
 		m_orthoMatrix = Kiwi::Matrix4::Orthographic( windowSize.x, windowSize.y, m_nearClipDistance, m_farClipDistance );
 
@@ -70,36 +76,74 @@ namespace Kiwi
 
 		this->_CalculateViewMatrix();
 
+		m_scene->_RegisterCamera( this );
+
+	}
+
+	Kiwi::Vector2 Camera::_GetTargetSize()
+	{
+
+#ifndef KIWI_HEADLESS
+		assert( m_scene->GetRenderWindow() != 0 );
+
+		return m_scene->GetRenderWindow()->GetClientSize();
+#else
+		//headless scenes have no window, use a 720p target to match the default aspect ratio
+		return Kiwi::Vector2( 1280.0f, 720.0f );
+#endif
+
 	}
 
 	void Camera::_CalculateViewMatrix()
 	{
 
-		//get the local x-y-z axis for the camera
-		Kiwi::Vector3d front = m_transform->GetForward();
-		Kiwi::Vector3d up = m_transform->GetUp();
-		Kiwi::Vector3d right = m_transform->GetRight();
+		Camera::_BuildViewMatrix( m_viewMatrix, m_transform->GetPosition(), m_transform->GetRotation() );
+
+	}
 
-		Kiwi::Vector3d pos = m_transform->GetPosition();
+	void Camera::_BuildViewMatrix( Kiwi::Matrix4& viewMatrix, const Kiwi::Vector3d& pos, const Kiwi::Quaternion& rotation )
+	{
+
+		//get the local x-y-z axis for the camera
+		Kiwi::Vector3d front = rotation.RotatePoint( Kiwi::Vector3d::forward() ).Normalized();
+		Kiwi::Vector3d up = rotation.RotatePoint( Kiwi::Vector3d::up() ).Normalized();
+		Kiwi::Vector3d right = rotation.RotatePoint( Kiwi::Vector3d::right() ).Normalized();
 
 		//recalculate the view matrix
-		m_viewMatrix.d1 = -right.Dot( pos );
-		m_viewMatrix.d2 = -up.Dot( pos );
-		m_viewMatrix.d3 = -front.Dot( pos );
+		viewMatrix.d1 = -right.Dot( pos );
+		viewMatrix.d2 = -up.Dot( pos );
+		viewMatrix.d3 = -front.Dot( pos );
+
+		viewMatrix.a1 = right.x;
+		viewMatrix.a2 = up.x;
+		viewMatrix.a3 = front.x;
+
+		viewMatrix.b1 = right.y;
+		viewMatrix.b2 = up.y;
+		viewMatrix.b3 = front.y;
+
+		viewMatrix.c1 = right.z;
+		viewMatrix.c2 = up.z;
+		viewMatrix.c3 = front.z;
+
+		viewMatrix.d4 = 1.0f;
 
-		m_viewMatrix.a1 = right.x;
-		m_viewMatrix.a2 = up.x;
-		m_viewMatrix.a3 = front.x;
+	}
+
+	Kiwi::Matrix4 Camera::GetInterpolatedViewMatrix( double alpha )const
+	{
+
+		Kiwi::Matrix4 viewMatrix = m_viewMatrix;
+		Camera::_BuildViewMatrix( viewMatrix, m_transform->GetInterpolatedPosition( alpha ), m_transform->GetInterpolatedRotation( alpha ) );
 
-		m_viewMatrix.b1 = right.y;
-		m_viewMatrix.b2 = up.y;
-		m_viewMatrix.b3 = front.y;
+		return viewMatrix;
 
-		m_viewMatrix.c1 = right.z;
-		m_viewMatrix.c2 = up.z;
-		m_viewMatrix.c3 = front.z;
+	}
+
+	Camera::~Camera()
+	{
 
-		m_viewMatrix.d4 = 1.0f;
+		m_scene->_UnregisterCamera( this );
 
 	}
 
@@ -36,11 +36,17 @@ namespace Kiwi
 
 		void _CalculateViewMatrix();
 
+		/*builds a view matrix looking from 'position' with the given rotation*/
+		static void _BuildViewMatrix( Kiwi::Matrix4& viewMatrix, const Kiwi::Vector3d& position, const Kiwi::Quaternion& rotation );
+
+		/*returns the size of the window the camera renders to*/
+		Kiwi::Vector2 _GetTargetSize();
+
 	public:
 
 		Camera( std::wstring name, Kiwi::Scene& scene);
 		Camera( std::wstring name, Kiwi::Scene& scene, float FOV, float aspectRatio, float nearClip, float farClip );
-		virtual ~Camera() {}
+		virtual ~Camera();
 
 		virtual void SetViewport(Kiwi::Viewport* viewport);
 
@@ -56,6 +62,10 @@ namespace Kiwi
 		float GetFOV()const { return m_fov; }
 
 		Kiwi::Matrix4 GetViewMatrix()const { return m_viewMatrix; }
+
+		/*returns the view matrix of the camera's transform blended between the previous and current fixed state
+		(see Transform::GetInterpolatedPosition)*/
+		Kiwi::Matrix4 GetInterpolatedViewMatrix( double alpha )const;
 		Kiwi::Matrix4 GetViewMatrix2D()const { return m_viewMatrix2D; }
 		Kiwi::Matrix4 GetProjectionMatrix()const { return m_projMatrix; }
 		Kiwi::Matrix4 GetOrthoMatrix()const { return m_orthoMatrix; }
@@ -3,10 +3,10 @@
 #include "Mesh.h"
 #include "Material.h"
 
-#include "..\Core\Utilities.h"
-#include "..\Core\Logger.h"
-#include "..\Core\Transform.h"
-#include "..\Core\Exception.h"
+#include "../Core/Utilities.h"
+#include "../Core/Logger.h"
+#include "../Core/Transform.h"
+#include "../Core/Exception.h"
 
 namespace Kiwi
 {
@@ -3,8 +3,8 @@
 
 #include "Mesh.h"
 
-#include "..\Core\Vector3.h"
-#include "..\Core\IAsset.h"
+#include "../Core/Vector3.h"
+#include "../Core/IAsset.h"
 
 #include <string>
 #include <vector>
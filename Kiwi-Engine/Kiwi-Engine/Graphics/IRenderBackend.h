@@ -0,0 +1,23 @@
+#ifndef _KIWI_IRENDERBACKEND_H_
+#define _KIWI_IRENDERBACKEND_H_
+
+namespace Kiwi
+{
+
+	class RenderSnapshot;
+
+	/*draws the render snapshots of a scene that renders on a render thread (see Scene::SetRenderThreadEnabled)
+	Render is called on the render thread while the simulation runs the next frame, so it must only read
+	the snapshot and the GPU data of the meshes it refers to, never the live scene*/
+	class IRenderBackend
+	{
+	public:
+
+		virtual ~IRenderBackend() {}
+
+		virtual void Render( const Kiwi::RenderSnapshot& snapshot ) = 0;
+
+	};
+};
+
+#endif
\ No newline at end of file
@@ -19,6 +19,7 @@ namespace Kiwi
 		m_inputLayout = 0;
 
 		m_shaderName = shaderName;
+		m_shaderNameID = Kiwi::StringTable::Intern( shaderName );
 		m_vertexShaderFile = vertexShaderFile;
 		m_pixelShaderFile = pixelShaderFile;
 
@@ -3,6 +3,9 @@
 
 #include "DirectX.h"
 #include "Mesh.h"
+#include "RenderSnapshot.h"
+
+#include "../Core/StringId.h"
 
 #include <string>
 #include <vector>
@@ -21,6 +24,7 @@ namespace Kiwi
 	protected:
 
 		std::wstring m_shaderName;
+		Kiwi::StringId m_shaderNameID;
 
 		//shader objects
 		ID3D11VertexShader* m_vertexShader;
@@ -51,7 +55,15 @@ namespace Kiwi
 		/*sets parameters that are updated for each entity*/
 		virtual void SetObjectParameters( Kiwi::Scene* scene, Kiwi::RenderTarget* renderTarget, Kiwi::Mesh::Submesh* submesh ) {}
 
+		/*versions used when drawing a render snapshot on the render thread (see Scene::SetRenderThreadEnabled), while the
+		simulation runs the next frame. they must only read the camera and item they are given, never the scene, its entities
+		or their meshes. a shader that needs more per object data should have it added to RenderSnapshot::Item
+		by default they set nothing, the versions above read the live scene and can't be used from the render thread*/
+		virtual void SetFrameParameters( const Kiwi::RenderSnapshot& snapshot, const Kiwi::RenderSnapshot::CameraState& camera ) {}
+		virtual void SetObjectParameters( const Kiwi::RenderSnapshot& snapshot, Kiwi::RenderTarget* renderTarget, const Kiwi::RenderSnapshot::Item& item ) {}
+
 		std::wstring GetName()const { return m_shaderName; }
+		Kiwi::StringId GetNameID()const { return m_shaderNameID; }
 
 	};
 }
@@ -21,6 +21,8 @@ namespace Kiwi
 
 		m_mesh = 0;
 		m_shaderEffect = 0;
+		m_shader = Kiwi::StringTable::EMPTY;
+		m_renderGroup = Kiwi::StringTable::EMPTY;
 
 	}
 
@@ -39,6 +41,8 @@ namespace Kiwi
 
 		m_mesh = 0;
 		m_shaderEffect = 0;
+		m_shader = Kiwi::StringTable::EMPTY;
+		m_renderGroup = Kiwi::StringTable::EMPTY;
 
 	}
 
@@ -58,6 +62,8 @@ namespace Kiwi
 
 		m_mesh = 0;
 		m_shaderEffect = 0;
+		m_shader = Kiwi::StringTable::EMPTY;
+		m_renderGroup = Kiwi::StringTable::EMPTY;
 
 	}
 
@@ -4,6 +4,7 @@
 #include "Color.h"
 
 #include "../Core/Component.h"
+#include "../Core/StringId.h"
 
 namespace Kiwi
 {
@@ -21,8 +22,8 @@ namespace Kiwi
 
 		Kiwi::IShaderEffect* m_shaderEffect;
 
-		std::wstring m_shader;
-		std::wstring m_renderGroup;
+		Kiwi::StringId m_shader;
+		Kiwi::StringId m_renderGroup;
 
 		Kiwi::Texture* m_diffuseMap; //main texture
 		Kiwi::Texture* m_bumpMap;
@@ -68,8 +69,10 @@ namespace Kiwi
 		the transparency value for the material*/
 		void SetTransparency( float transparency ) { m_diffuseColor.alpha = transparency; }
 
-		void SetShader( std::wstring shader ) { m_shader = shader; }
-		void SetRenderGroup( std::wstring renderGroup ) { m_renderGroup = renderGroup; }
+		void SetShader( Kiwi::StringId shader ) { m_shader = shader; }
+		void SetShader( std::wstring shader ) { m_shader = Kiwi::StringTable::Intern( shader ); }
+		void SetRenderGroup( Kiwi::StringId renderGroup ) { m_renderGroup = renderGroup; }
+		void SetRenderGroup( std::wstring renderGroup ) { m_renderGroup = Kiwi::StringTable::Intern( renderGroup ); }
 
 		bool IsTextured()const { return m_diffuseMap != 0; }
 		bool HasTransparency()const;
@@ -77,8 +80,10 @@ namespace Kiwi
 		float GetReflectivity()const { return m_reflectivity; }
 		float GetOpticalDensity()const { return m_opticalDensity; }
 		int GetIllumination()const { return m_illum; }
-		std::wstring GetShader()const { return m_shader; }
-		std::wstring GetRenderGroup()const { return m_renderGroup; }
+		std::wstring GetShader()const { return Kiwi::StringTable::GetString( m_shader ); }
+		std::wstring GetRenderGroup()const { return Kiwi::StringTable::GetString( m_renderGroup ); }
+		Kiwi::StringId GetShaderID()const { return m_shader; }
+		Kiwi::StringId GetRenderGroupID()const { return m_renderGroup; }
 
 		/*returns one of the material's textures, depending on the value of 'textureType'
 		possible values are: Diffuse, Ambient, Bump, or Specular*/
@@ -6,6 +6,10 @@
 #include "../Core/Utilities.h"
 #include "../Core/Exception.h"
 
+#ifndef KIWI_HEADLESS
+#include "RenderThread.h"
+#endif
+
 namespace Kiwi
 {
 
@@ -14,15 +18,18 @@ namespace Kiwi
 	{
 
 		m_renderer = 0;
+#ifndef KIWI_HEADLESS
 		m_indexBuffer = 0;
 		m_vertexBuffer = 0;
+#endif
 		m_hasTransparency = false;
 		m_isTextured = false;
 		m_usingPerVertexColor = false;
 		m_isInstanced = false;
 		m_instanceCount = 0;
 		m_instanceCapacity = 0;
-		m_renderGroup = L"";
+		m_renderGroup = Kiwi::StringTable::EMPTY;
+		m_submeshShader = Kiwi::StringTable::EMPTY;
 		m_primitiveTopology = Kiwi::PrimitiveTopology::TRIANGLE_LIST;
 
 	}
@@ -33,15 +40,18 @@ namespace Kiwi
 	{
 
 		m_renderer = 0;
+#ifndef KIWI_HEADLESS
 		m_indexBuffer = 0;
 		m_vertexBuffer = 0;
+#endif
 		m_hasTransparency = false;
 		m_isTextured = false;
 		m_usingPerVertexColor = false;
 		m_isInstanced = false;
 		m_instanceCount = 0;
 		m_instanceCapacity = 0;
-		m_renderGroup = L"";
+		m_renderGroup = Kiwi::StringTable::EMPTY;
+		m_submeshShader = Kiwi::StringTable::EMPTY;
 		m_primitiveTopology = Kiwi::PrimitiveTopology::TRIANGLE_LIST;
 
 	}
@@ -56,15 +66,18 @@ namespace Kiwi
 		}
 
 		m_renderer = 0;
+#ifndef KIWI_HEADLESS
 		m_indexBuffer = 0;
 		m_vertexBuffer = 0;
+#endif
 		m_hasTransparency = false;
 		m_isTextured = false;
 		m_usingPerVertexColor = false;
 		m_isInstanced = false;
 		m_instanceCount = 0;
 		m_instanceCapacity = 0;
-		m_renderGroup = L"";
+		m_renderGroup = Kiwi::StringTable::EMPTY;
+		m_submeshShader = Kiwi::StringTable::EMPTY;
 		m_primitiveTopology = Kiwi::PrimitiveTopology::TRIANGLE_LIST;
 
 		m_vertices.reserve( vertices.size() );
@@ -87,15 +100,18 @@ namespace Kiwi
 		}
 
 		m_renderer = 0;
+#ifndef KIWI_HEADLESS
 		m_indexBuffer = 0;
 		m_vertexBuffer = 0;
+#endif
 		m_hasTransparency = false;
 		m_isTextured = false;
 		m_usingPerVertexColor = false;
 		m_isInstanced = false;
 		m_instanceCount = 0;
 		m_instanceCapacity = 0;
-		m_renderGroup = L"";
+		m_renderGroup = Kiwi::StringTable::EMPTY;
+		m_submeshShader = Kiwi::StringTable::EMPTY;
 		m_primitiveTopology = Kiwi::PrimitiveTopology::TRIANGLE_LIST;
 
 		m_vertices.reserve( vertices.size() );
@@ -117,8 +133,7 @@ namespace Kiwi
 		Kiwi::FreeMemory( m_uvs );
 		Kiwi::FreeMemory( m_colors );
 
-		SAFE_DELETE( m_indexBuffer );
-		SAFE_DELETE( m_vertexBuffer );
+		this->ClearBuffers();
 
 	}
 
@@ -143,14 +158,24 @@ namespace Kiwi
 
 				} else
 				{
-					SAFE_DELETE( m_indexBuffer );
-					SAFE_DELETE( m_vertexBuffer );
+					this->ClearBuffers();
 				}
 			}
 		}
 
 	}
 
+	void Mesh::_OnDetached()
+	{
+
+		this->ClearBuffers();
+
+		//the buffers are rebuilt if the mesh is attached again
+		m_renderer = 0;
+
+	}
+
+#ifndef KIWI_HEADLESS
 	bool Mesh::_RebuildBuffers( std::vector<Vertex>& bufferVertices, std::vector<unsigned long>& bufferIndices )
 	{
 
@@ -174,6 +199,7 @@ namespace Kiwi
 		return false;
 
 	}
+#endif
 
 	unsigned int Mesh::_CreateSubmesh( const Kiwi::Material& material, unsigned long startIndex, unsigned long endIndex )
 	{
@@ -181,7 +207,7 @@ namespace Kiwi
 		Submesh defaultMesh;
 		defaultMesh.material = material;
 		defaultMesh.material.SetMesh( this );
-		if( material.GetShader().size() == 0 )
+		if( material.GetShaderID() == Kiwi::StringTable::EMPTY )
 		{
 			defaultMesh.material.SetShader( m_submeshShader );
 		}
@@ -219,8 +245,24 @@ namespace Kiwi
 	void Mesh::ClearBuffers()
 	{
 
-		SAFE_DELETE( m_indexBuffer );
-		SAFE_DELETE( m_vertexBuffer );
+#ifndef KIWI_HEADLESS
+		//in render thread mode the frame being drawn may still use the buffers, the render thread deletes them
+		//once it is done with them
+		Kiwi::Scene* scene = (m_entity != 0) ? m_entity->GetScene() : 0;
+		Kiwi::RenderThread* renderThread = (scene != 0) ? scene->GetRenderThread() : 0;
+		if( renderThread != 0 )
+		{
+			renderThread->ReleaseBuffer( m_indexBuffer );
+			renderThread->ReleaseBuffer( m_vertexBuffer );
+			m_indexBuffer = 0;
+			m_vertexBuffer = 0;
+
+		} else
+		{
+			SAFE_DELETE( m_indexBuffer );
+			SAFE_DELETE( m_vertexBuffer );
+		}
+#endif
 
 	}
 
@@ -234,14 +276,14 @@ namespace Kiwi
 		Kiwi::FreeMemory( m_colors );
 		Kiwi::FreeMemory( m_submeshes );
 
-		SAFE_DELETE( m_indexBuffer );
-		SAFE_DELETE( m_vertexBuffer );
+		this->ClearBuffers();
 
 		m_isTextured = false;
 		m_hasTransparency = false;
 
 	}
 
+#ifndef KIWI_HEADLESS
 	void Mesh::Bind( Kiwi::Renderer& renderer )
 	{
 
@@ -259,6 +301,7 @@ namespace Kiwi
 		}
 
 	}
+#endif
 
 	/*tests for intersection between a ray and the individual triangles in this mesh
 	the vertices of the closest intersection are returned in 'closest'*/
@@ -405,7 +448,7 @@ namespace Kiwi
 
 	}
 
-	void Mesh::SetShader( std::wstring shaderName )
+	void Mesh::SetShader( Kiwi::StringId shaderName )
 	{
 
 		m_submeshShader = shaderName;
@@ -432,6 +475,7 @@ namespace Kiwi
 		{
 			m_usingPerVertexColor = (m_colors.size() > 0) ? true : false;
 
+#ifndef KIWI_HEADLESS
 			//generate the vertices to send to the GPU
 			std::vector<Vertex> bufferVertices;
 			for( unsigned int i = 0; i < m_vertices.size(); i++ )
@@ -455,6 +499,7 @@ namespace Kiwi
 
 				bufferVertices.push_back( v );
 			}
+#endif
 
 			//if the index array is empty, automatically generate the default one
 			if( m_indices.size() == 0 )
@@ -465,12 +510,14 @@ namespace Kiwi
 				}
 			}
 
+#ifndef KIWI_HEADLESS
 			//fill the index buffer
 			std::vector<unsigned long> bufferIndices;
 			for( unsigned int i = 0; i < m_indices.size(); i++ )
 			{
 				bufferIndices.push_back( m_indices[i] );
 			}
+#endif
 
 			//if there are no submeshes set, create a new one that contains the entire mesh
 			if( m_submeshes.size() == 0 || m_submeshes[0].endIndex == 0 )
@@ -479,10 +526,12 @@ namespace Kiwi
 				this->_CreateSubmesh( Kiwi::Material(), 0, (unsigned long)m_vertices.size() - 1 );
 			}
 
+#ifndef KIWI_HEADLESS
 			this->_RebuildBuffers( bufferVertices, bufferIndices );
 
 			Kiwi::FreeMemory( bufferVertices );
 			Kiwi::FreeMemory( bufferIndices );
+#endif
 
 		} else
 		{//there are no vertices, so empty the mesh buffers and submesh list
@@ -516,7 +565,7 @@ namespace Kiwi
 				{
 					m_isTextured = true;
 				}
-				if( itr->material.GetShader().size() == 0 )
+				if( itr->material.GetShaderID() == Kiwi::StringTable::EMPTY )
 				{
 					itr->material.SetShader( m_submeshShader );
 				}
@@ -537,7 +586,7 @@ namespace Kiwi
 		{
 			m_hasTransparency = true;
 		}
-		if( submesh.material.GetShader().size() == 0 )
+		if( submesh.material.GetShaderID() == Kiwi::StringTable::EMPTY )
 		{
 			submesh.material.SetShader( m_submeshShader );
 		}
@@ -569,14 +618,22 @@ namespace Kiwi
 	Kiwi::IBuffer* Mesh::GetVertexBuffer()
 	{
 
+#ifndef KIWI_HEADLESS
 		return m_vertexBuffer;
+#else
+		return 0;
+#endif
 
 	}
 
 	Kiwi::IBuffer* Mesh::GetIndexBuffer()
 	{
 
+#ifndef KIWI_HEADLESS
 		return m_indexBuffer;
+#else
+		return 0;
+#endif
 
 	}
 
@@ -1,17 +1,23 @@
 #ifndef _KIWI_MESH_H_
 #define _KIWI_MESH_H_
 
-#include "DirectX.h"
 #include "Material.h"
+
+#include "../Core/Platform.h"
+
+#ifndef KIWI_HEADLESS
+#include "DirectX.h"
 #include "VertexBuffer.h"
 #include "IndexBuffer.h"
 #include "Renderer.h"
+#endif
 
 #include "../Core/Component.h"
 #include "../Core/Math.h"
 #include "../Core/IAsset.h"
 #include "../Core/Vector2d.h"
 #include "../Core/Vector3d.h"
+#include "../Core/MemoryPool.h"
 
 #include <vector>
 #include <string>
@@ -20,6 +26,20 @@ namespace Kiwi
 {
 
 	class StaticMeshAsset;
+	class Renderer;
+	class IBuffer;
+
+#ifdef KIWI_HEADLESS
+	//headless builds have no Renderer.h, the values match the d3d11 topologies
+	enum PrimitiveTopology
+	{
+		POINT_LIST = 1,
+		LINE_LIST = 2,
+		LINE_STRIP = 3,
+		TRIANGLE_LIST = 4,
+		TRIANGLE_STRIP = 5
+	};
+#endif
 
 	class Mesh :
 		public Kiwi::IAsset,
@@ -29,6 +49,7 @@ namespace Kiwi
 
 	public:
 
+#ifndef KIWI_HEADLESS
 		struct Vertex
 		{
 			Vertex()
@@ -52,6 +73,7 @@ namespace Kiwi
 			DirectX::XMFLOAT3 normal;
 			DirectX::XMFLOAT4 color;
 		};
+#endif
 
 		struct Triangle
 		{
@@ -91,8 +113,10 @@ namespace Kiwi
 
 		std::vector<Kiwi::Mesh::Submesh> m_submeshes;
 
+#ifndef KIWI_HEADLESS
 		Kiwi::VertexBuffer<Kiwi::Mesh::Vertex>* m_vertexBuffer;
 		Kiwi::IndexBuffer* m_indexBuffer;
+#endif
 
 		std::vector<Kiwi::Vector3d> m_vertices;
 		std::vector<Kiwi::Vector2d> m_uvs;
@@ -109,17 +133,25 @@ namespace Kiwi
 		long m_instanceCount;
 		long m_instanceCapacity;
 
-		std::wstring m_renderGroup;
-		std::wstring m_submeshShader; //if not empty, all created submeshes will use this shader by default
+		Kiwi::StringId m_renderGroup;
+		Kiwi::StringId m_submeshShader; //if not empty, all created submeshes will use this shader by default
 
 	protected:
 
 		void _OnAttached();
+
+		/*releases the buffers while the entity's scene is still known, in render thread mode the frame being drawn
+		may still use them*/
+		void _OnDetached();
+#ifndef KIWI_HEADLESS
 		bool _RebuildBuffers( std::vector<Vertex>& bufferVertices, std::vector<unsigned long>& bufferIndices );
+#endif
 		unsigned int _CreateSubmesh( const Kiwi::Material& material, unsigned long startIndex, unsigned long endIndex );
 
 	public:
 
+		KIWI_DECLARE_POOLED( Mesh )
+
 		Mesh();
 		Mesh( std::wstring name );
 		Mesh( std::vector<Kiwi::Vector3d>& vertices, std::vector<Kiwi::Vector2d>& uvs, std::vector<Kiwi::Vector3d>& normals );
@@ -136,7 +168,9 @@ namespace Kiwi
 		/*empties the vertex, normal, color, uv, and index arrays, as well as the vertex and index buffers*/
 		virtual void ClearAll();
 
+#ifndef KIWI_HEADLESS
 		virtual void Bind( Kiwi::Renderer& renderer );
+#endif
 
 		/*tests for intersection between a ray and the individual triangles in this mesh 
 		the vertices of the closest intersection are returned in 'closest'
@@ -151,7 +185,8 @@ namespace Kiwi
 
 		void SetMeshFile( std::wstring filename ) { m_assetFiles.push_back( filename ); }
 
-		void SetRenderGroup( std::wstring renderGroup ) { m_renderGroup = renderGroup; }
+		void SetRenderGroup( Kiwi::StringId renderGroup ) { m_renderGroup = renderGroup; }
+		void SetRenderGroup( std::wstring renderGroup ) { m_renderGroup = Kiwi::StringTable::Intern( renderGroup ); }
 
 		void SetPrimitiveTopology( Kiwi::PrimitiveTopology topology ) { m_primitiveTopology = topology; }
 
@@ -171,7 +206,8 @@ namespace Kiwi
 
 		//sets the target shader used to render all submesh materials
 		//all submeshes added in the future whos materials do not have a set shader will also use this shader by default
-		void SetShader( std::wstring shaderName );
+		void SetShader( Kiwi::StringId shaderName );
+		void SetShader( std::wstring shaderName ) { this->SetShader( Kiwi::StringTable::Intern( shaderName ) ); }
 
 		std::vector<Kiwi::Vector3d>& GetVertices() { return m_vertices; }
 		std::vector<Kiwi::Vector2d>& GetUVs() { return m_uvs; }
@@ -185,7 +221,8 @@ namespace Kiwi
 
 		unsigned int GetSubmeshCount()const { return (unsigned int)m_submeshes.size(); }
 
-		std::wstring GetRenderGroup()const { return m_renderGroup; }
+		std::wstring GetRenderGroup()const { return Kiwi::StringTable::GetString( m_renderGroup ); }
+		Kiwi::StringId GetRenderGroupID()const { return m_renderGroup; }
 
 		long GetInstanceCount()const { return m_instanceCount; }
 		long GetInstanceCapacity()const { return m_instanceCapacity; }
@@ -194,6 +231,7 @@ namespace Kiwi
 		bool HasTransparency()const { return m_hasTransparency; }
 		bool UsingPerVertexColor()const { return m_usingPerVertexColor; }
 
+		/*both return 0 in headless builds*/
 		Kiwi::IBuffer* GetVertexBuffer();
 		Kiwi::IBuffer* GetIndexBuffer();
 
@@ -0,0 +1,49 @@
+#include "NullRenderBackend.h"
+#include "RenderSnapshot.h"
+
+namespace Kiwi
+{
+
+	NullRenderBackend::NullRenderBackend()
+	{
+
+		m_framesRendered = 0;
+		m_lastFrame = 0;
+		m_lastDrawCount = 0;
+		m_lastCameraCount = 0;
+
+	}
+
+	void NullRenderBackend::Render( const Kiwi::RenderSnapshot& snapshot )
+	{
+
+		//count the draws a renderer would issue, one per item for each viewport showing the item's group
+		unsigned int drawCount = 0;
+		if( snapshot.GetViewportCount() == 0 )
+		{
+			drawCount = snapshot.GetItemCount();
+
+		} else
+		{
+			for( unsigned int i = 0; i < snapshot.GetViewportCount(); i++ )
+			{
+				const Kiwi::RenderSnapshot::ViewportState& viewport = snapshot.GetViewport( i );
+				for( unsigned int g = viewport.groupBegin; g < viewport.groupEnd; g++ )
+				{
+					const Kiwi::RenderSnapshot::Group* group = snapshot.FindGroup( snapshot.GetViewportGroup( g ) );
+					if( group )
+					{
+						drawCount += group->end[Kiwi::RenderSnapshot::PASS_COUNT - 1] - group->begin[0];
+					}
+				}
+			}
+		}
+
+		m_lastDrawCount = drawCount;
+		m_lastCameraCount = snapshot.GetCameraCount();
+		m_lastFrame = snapshot.GetFrame();
+		m_framesRendered++;
+
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef _KIWI_NULLRENDERBACKEND_H_
+#define _KIWI_NULLRENDERBACKEND_H_
+
+#include "IRenderBackend.h"
+
+#include <atomic>
+
+namespace Kiwi
+{
+
+	/*render backend that walks each snapshot like a renderer would but draws nothing
+	used by headless scenes in render thread mode, and to measure the simulation side of the render thread on its own*/
+	class NullRenderBackend :
+		public Kiwi::IRenderBackend
+	{
+	protected:
+
+		std::atomic<unsigned long long> m_framesRendered;
+		std::atomic<unsigned long long> m_lastFrame;
+		std::atomic<unsigned int> m_lastDrawCount;
+		std::atomic<unsigned int> m_lastCameraCount;
+
+	public:
+
+		NullRenderBackend();
+		virtual ~NullRenderBackend() {}
+
+		virtual void Render( const Kiwi::RenderSnapshot& snapshot );
+
+		/*number of snapshots rendered so far*/
+		unsigned long long GetFramesRendered()const { return m_framesRendered; }
+
+		/*frame index of the last rendered snapshot*/
+		unsigned long long GetLastFrame()const { return m_lastFrame; }
+
+		/*number of submeshes and cameras in the last rendered snapshot*/
+		unsigned int GetLastDrawCount()const { return m_lastDrawCount; }
+		unsigned int GetLastCameraCount()const { return m_lastCameraCount; }
+
+	};
+};
+
+#endif
\ No newline at end of file
@@ -37,7 +37,7 @@ namespace Kiwi
 		}
 		objPath = objFile.substr(0, pos + 1);		
 
-		std::wifstream inputFile(objFile.c_str());
+		std::wifstream inputFile(Kiwi::ToNativePath(objFile).c_str());
 		if(inputFile)
 		{
 
@@ -320,7 +320,7 @@ namespace Kiwi
 			//now go through the mtllib file and load the data for the materials
 			if(matlibFile != L"")
 			{
-				inputFile.open(matlibFile.c_str());
+				inputFile.open(Kiwi::ToNativePath(matlibFile).c_str());
 
 				if(inputFile)
 				{
@@ -2,8 +2,8 @@
 #include "DirectX.h"
 #include "Renderer.h"
 
-#include "..\Core\Utilities.h"
-#include "..\Core\Exception.h"
+#include "../Core/Utilities.h"
+#include "../Core/Exception.h"
 
 namespace Kiwi
 {
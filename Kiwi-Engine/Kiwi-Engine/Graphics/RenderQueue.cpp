@@ -1,10 +1,12 @@
 #include "RenderQueue.h"
+#include "Mesh.h"
 
 #include "../Core/Entity.h"
 #include "../Core/Scene.h"
 #include "../Core/EngineRoot.h"
 #include "../Core/Console.h"
 #include "../Core/EntityManager.h"
+#include "../Core/Profiler.h"
 
 namespace Kiwi
 {
@@ -13,7 +15,7 @@ namespace Kiwi
 		m_parentScene( &scene )
 	{
 
-		m_defaultRenderGroupName = L"default";
+		m_defaultRenderGroupName = Kiwi::StringTable::Intern( L"default" );
 		this->CreateRenderGroup( m_defaultRenderGroupName );
 
 	}
@@ -42,22 +44,24 @@ namespace Kiwi
 
 	}
 
-	void RenderQueue::Generate( Kiwi::EntityMap* entityMap )
+	void RenderQueue::Generate( const Kiwi::EntityList* entities )
 	{
 
-		if( entityMap )
+		KIWI_PROFILE_ZONE( "RenderQueue::Generate" );
+
+		if( entities )
 		{
-			for( auto entityItr = entityMap->begin(); entityItr != entityMap->end(); entityItr++ )
+			for( auto entityItr = entities->begin(); entityItr != entities->end(); entityItr++ )
 			{
-				Kiwi::Entity* entity = entityItr->second;
+				Kiwi::Entity* entity = *entityItr;
 				if( entity && entity->IsActive() && !entity->IsShutdown() )
 				{
 					//if there's a mesh attached to the entity, retrieve it
 					Kiwi::Mesh* entityMesh = entity->FindComponent<Kiwi::Mesh>();
 					if( entityMesh && entityMesh->IsActive() == true && entityMesh->IsShutdown() == false )
 					{
-						std::wstring rGroup = entityMesh->GetRenderGroup(); //get the render group the mesh belongs to
-						if( rGroup.compare( L"" ) == 0 )
+						Kiwi::StringId rGroup = entityMesh->GetRenderGroupID(); //get the render group the mesh belongs to
+						if( rGroup == Kiwi::StringTable::EMPTY )
 						{
 							Kiwi::RenderQueueGroup* defaultGroup = this->GetDefaultRenderGroup();
 							if( defaultGroup )
@@ -147,7 +151,7 @@ namespace Kiwi
 
 		if( mesh && mesh->GetEntity() )
 		{
-			std::wstring targetGroup = mesh->GetRenderGroup();
+			Kiwi::StringId targetGroup = mesh->GetRenderGroupID();
 
 			//renderable belongs to a custom render group
 			auto itr = m_renderGroups.find( targetGroup );
@@ -175,23 +179,23 @@ namespace Kiwi
 
 	}
 
-	Kiwi::RenderQueueGroup* RenderQueue::CreateRenderGroup( std::wstring groupName )
+	Kiwi::RenderQueueGroup* RenderQueue::CreateRenderGroup( Kiwi::StringId groupName )
 	{
 
 		if( this->GetRenderGroup( groupName ) )
 		{
-			m_parentScene->GetEngine()->GetConsole()->PrintDebug( L"Tried to create duplicate render group '" + groupName + L"'" );
+			m_parentScene->GetEngine()->GetConsole()->PrintDebug( L"Tried to create duplicate render group '" + Kiwi::StringTable::GetString( groupName ) + L"'" );
 			return 0;
 		}
 
-		Kiwi::RenderQueueGroup* group = new Kiwi::RenderQueueGroup( groupName );
+		Kiwi::RenderQueueGroup* group = new Kiwi::RenderQueueGroup( Kiwi::StringTable::GetString( groupName ) );
 		m_renderGroups[groupName] = group;
 
 		return group;
 
 	}
 
-	RenderQueueGroup* RenderQueue::GetRenderGroup( std::wstring groupName )
+	RenderQueueGroup* RenderQueue::GetRenderGroup( Kiwi::StringId groupName )
 	{
 
 		auto itr = m_renderGroups.find( groupName );
@@ -5,6 +5,8 @@
 
 #include "RenderQueueGroup.h"
 
+#include "../Core/StringId.h"
+
 #include <string>
 #include <unordered_map>
 
@@ -20,9 +22,9 @@ namespace Kiwi
 
 		Kiwi::Scene* m_parentScene;
 
-		std::unordered_map<std::wstring, Kiwi::RenderQueueGroup*> m_renderGroups;
+		std::unordered_map<Kiwi::StringId, Kiwi::RenderQueueGroup*> m_renderGroups;
 
-		std::wstring m_defaultRenderGroupName;
+		Kiwi::StringId m_defaultRenderGroupName;
 
 		unsigned int m_defaultPriority; //default priority to use for renderables that do not specify a priority
 
@@ -31,7 +33,7 @@ namespace Kiwi
 		RenderQueue( Kiwi::Scene& scene );
 		~RenderQueue();
 
-		virtual void Generate( Kiwi::EntityMap* entityMap );
+		virtual void Generate( const Kiwi::EntityList* entities );
 
 		//clears the render queue
 		virtual void Clear();
@@ -39,14 +41,20 @@ namespace Kiwi
 		//virtual void AddRenderable( Kiwi::Renderable* renderable, std::wstring renderGroup = L"" );
 		virtual void QueueMesh( Kiwi::Mesh* mesh );
 
-		virtual Kiwi::RenderQueueGroup* CreateRenderGroup( std::wstring groupName );
+		virtual Kiwi::RenderQueueGroup* CreateRenderGroup( Kiwi::StringId groupName );
+		Kiwi::RenderQueueGroup* CreateRenderGroup( std::wstring groupName ) { return this->CreateRenderGroup( Kiwi::StringTable::Intern( groupName ) ); }
 
-		void SetDefaultRenderGroupName( std::wstring name ) { m_defaultRenderGroupName = name; }
+		void SetDefaultRenderGroupName( Kiwi::StringId name ) { m_defaultRenderGroupName = name; }
+		void SetDefaultRenderGroupName( std::wstring name ) { m_defaultRenderGroupName = Kiwi::StringTable::Intern( name ); }
 		
-		RenderQueueGroup* GetRenderGroup( std::wstring groupName );
+		RenderQueueGroup* GetRenderGroup( Kiwi::StringId groupName );
+		RenderQueueGroup* GetRenderGroup( std::wstring groupName ) { return this->GetRenderGroup( Kiwi::StringTable::Find( groupName ) ); }
 		RenderQueueGroup* GetDefaultRenderGroup();
 
-		std::wstring GetDefaultRenderGroupName()const { return m_defaultRenderGroupName; }
+		std::wstring GetDefaultRenderGroupName()const { return Kiwi::StringTable::GetString( m_defaultRenderGroupName ); }
+		Kiwi::StringId GetDefaultRenderGroupID()const { return m_defaultRenderGroupName; }
+
+		const std::unordered_map<Kiwi::StringId, Kiwi::RenderQueueGroup*>& GetRenderGroups()const { return m_renderGroups; }
 
 		Kiwi::Scene* GetScene()const { return m_parentScene; }
 
@@ -2,6 +2,7 @@
 #define _KIWI_RENDERQUEUEGROUP_H_
 
 #include <vector>
+#include <string>
 
 namespace Kiwi
 {
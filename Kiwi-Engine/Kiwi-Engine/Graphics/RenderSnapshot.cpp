@@ -0,0 +1,275 @@
+#include "RenderSnapshot.h"
+#include "RenderQueue.h"
+#include "RenderQueueGroup.h"
+#include "Viewport.h"
+#include "Camera.h"
+#include "IBuffer.h"
+
+#include "../Core/Scene.h"
+#include "../Core/Entity.h"
+#include "../Core/Transform.h"
+#include "../Core/Utilities.h"
+
+#ifndef KIWI_HEADLESS
+#include "IShader.h"
+#endif
+
+#include <algorithm>
+
+namespace Kiwi
+{
+
+	RenderSnapshot::RenderSnapshot()
+	{
+
+		m_scene = 0;
+		m_frame = 0;
+		m_interpolationAlpha = 1.0;
+		m_lastShaderName = Kiwi::StringTable::EMPTY;
+		m_lastShader = 0;
+
+	}
+
+	void RenderSnapshot::Begin( Kiwi::Scene* scene, unsigned long long frame, double interpolationAlpha )
+	{
+
+		this->Clear();
+
+		m_scene = scene;
+		m_frame = frame;
+		m_interpolationAlpha = interpolationAlpha;
+
+	}
+
+	int RenderSnapshot::CaptureCamera( Kiwi::Camera* camera )
+	{
+
+		if( camera == 0 ) return -1;
+
+		for( unsigned int i = 0; i < m_cameras.size(); i++ )
+		{
+			if( m_cameras[i].camera == camera )
+			{
+				return (int)i;
+			}
+		}
+
+		CameraState state;
+		state.camera = camera;
+		state.view = camera->GetInterpolatedViewMatrix( m_interpolationAlpha );
+		state.view2D = camera->GetViewMatrix2D();
+		state.projection = camera->GetProjectionMatrix();
+		state.ortho = camera->GetOrthoMatrix();
+
+		Kiwi::Transform* transform = camera->FindComponent<Kiwi::Transform>();
+		state.position = (transform != 0) ? transform->GetInterpolatedPosition( m_interpolationAlpha ) : Kiwi::Vector3d();
+
+		m_cameras.push_back( state );
+
+		return (int)m_cameras.size() - 1;
+
+	}
+
+	void RenderSnapshot::CaptureViewport( Kiwi::RenderTarget* renderTarget, Kiwi::Viewport* viewport, Kiwi::StringId defaultGroup )
+	{
+
+		if( viewport == 0 ) return;
+
+		ViewportState state;
+		state.renderTarget = renderTarget;
+		state.viewport = viewport;
+		state.cameraIndex = this->CaptureCamera( viewport->GetCamera() );
+		state.groupBegin = (unsigned int)m_viewportGroups.size();
+
+		if( viewport->UsingDefaultRenderGroup() )
+		{
+			m_viewportGroups.push_back( defaultGroup );
+
+		} else
+		{
+			std::vector<Kiwi::StringId>& groups = viewport->GetRenderGroupList();
+			m_viewportGroups.insert( m_viewportGroups.end(), groups.begin(), groups.end() );
+		}
+
+		state.groupEnd = (unsigned int)m_viewportGroups.size();
+
+		m_viewports.push_back( state );
+
+	}
+
+	void RenderSnapshot::CaptureQueue( Kiwi::RenderQueue& renderQueue )
+	{
+
+		const std::unordered_map<Kiwi::StringId, Kiwi::RenderQueueGroup*>& groups = renderQueue.GetRenderGroups();
+		for( auto itr = groups.begin(); itr != groups.end(); itr++ )
+		{
+			Kiwi::RenderQueueGroup* queueGroup = itr->second;
+			if( queueGroup == 0 ) continue;
+
+			Group group;
+			group.name = itr->first;
+
+			group.begin[PASS_SOLID] = (unsigned int)m_items.size();
+			for( auto meshItr = queueGroup->BeginSolids(); meshItr != queueGroup->EndSolids(); meshItr++ )
+			{
+				this->_CaptureMesh( *meshItr );
+			}
+			group.end[PASS_SOLID] = (unsigned int)m_items.size();
+
+			group.begin[PASS_TRANSPARENT] = (unsigned int)m_items.size();
+			for( auto meshItr = queueGroup->BeginTransparents(); meshItr != queueGroup->EndTransparents(); meshItr++ )
+			{
+				this->_CaptureMesh( *meshItr );
+			}
+			group.end[PASS_TRANSPARENT] = (unsigned int)m_items.size();
+
+			group.begin[PASS_2D] = (unsigned int)m_items.size();
+			for( auto meshItr = queueGroup->Begin2D(); meshItr != queueGroup->End2D(); meshItr++ )
+			{
+				this->_CaptureMesh( *meshItr );
+			}
+			group.end[PASS_2D] = (unsigned int)m_items.size();
+
+			//sort transparents by distance to the camera, the world matrix holds the translation in its last row
+			if( m_cameras.size() > 0 )
+			{
+				Kiwi::Vector3d cameraPosition = m_cameras[0].position;
+				std::sort( m_items.begin() + group.begin[PASS_TRANSPARENT], m_items.begin() + group.end[PASS_TRANSPARENT], [&cameraPosition]( const Item& i1, const Item& i2 )
+				{
+					double d1 = Kiwi::Vector3d::SquareDistance( Kiwi::Vector3d( i1.world.d1, i1.world.d2, i1.world.d3 ), cameraPosition );
+					double d2 = Kiwi::Vector3d::SquareDistance( Kiwi::Vector3d( i2.world.d1, i2.world.d2, i2.world.d3 ), cameraPosition );
+					return d1 < d2;
+				} );
+			}
+
+			//2D meshes are sorted by depth
+			std::sort( m_items.begin() + group.begin[PASS_2D], m_items.begin() + group.end[PASS_2D], []( const Item& i1, const Item& i2 )
+			{
+				return i1.world.d3 < i2.world.d3;
+			} );
+
+			m_groups.push_back( group );
+		}
+
+	}
+
+	void RenderSnapshot::_CaptureMesh( Kiwi::Mesh* mesh )
+	{
+
+		if( mesh == 0 || mesh->GetEntity() == 0 ) return;
+
+		Kiwi::Transform* transform = mesh->GetEntity()->FindComponent<Kiwi::Transform>();
+		if( transform == 0 ) return;
+
+		Item item;
+		item.vertexBuffer = mesh->GetVertexBuffer();
+		item.indexBuffer = mesh->GetIndexBuffer();
+
+#ifndef KIWI_HEADLESS
+		if( item.vertexBuffer == 0 || item.indexBuffer == 0 )
+		{
+			m_captureErrors.push_back( L"Failed to bind mesh '" + mesh->GetName() + L"'" );
+			return;
+		}
+#endif
+
+		item.topology = mesh->GetPrimitiveTopology();
+		item.instanceCount = mesh->IsInstanced() ? mesh->GetInstanceCount() : 0;
+		item.world = transform->GetInterpolatedWorldMatrix( m_interpolationAlpha );
+		item.is2D = (mesh->GetEntity()->GetType() == Kiwi::Entity::ENTITY_2D);
+
+		for( unsigned int i = 0; i < mesh->GetSubmeshCount(); i++ )
+		{
+			Kiwi::Mesh::Submesh* submesh = mesh->GetSubmesh( i );
+			if( submesh == 0 ) continue;
+
+			item.shader = this->_FindShader( submesh->material );
+
+#ifndef KIWI_HEADLESS
+			if( item.shader == 0 )
+			{
+				m_captureErrors.push_back( L"Mesh " + mesh->GetName() + L" contains material with invalid shader" );
+				continue;
+			}
+#endif
+
+			item.submeshIndex = i;
+			item.startIndex = submesh->startIndex;
+			item.endIndex = submesh->endIndex;
+			item.material = submesh->material;
+
+			m_items.push_back( item );
+		}
+
+	}
+
+	Kiwi::IShader* RenderSnapshot::_FindShader( const Kiwi::Material& material )
+	{
+
+#ifndef KIWI_HEADLESS
+		static const Kiwi::StringId defaultShaderName = Kiwi::StringTable::Intern( L"default" );
+
+		Kiwi::StringId shaderName = material.GetShaderID();
+		if( shaderName == Kiwi::StringTable::EMPTY )
+		{
+			shaderName = defaultShaderName;
+		}
+
+		//the scene's shaders are read while the scene is locked for the capture, the render thread only gets the pointer
+		if( m_lastShader == 0 || shaderName != m_lastShaderName )
+		{
+			m_lastShader = m_scene->FindAsset<Kiwi::IShader>( Kiwi::StringTable::GetString( shaderName ) );
+			m_lastShaderName = shaderName;
+		}
+
+		return m_lastShader;
+#else
+		//headless builds have no shaders
+		return 0;
+#endif
+
+	}
+
+	void RenderSnapshot::Clear()
+	{
+
+		m_items.clear();
+		m_groups.clear();
+		m_cameras.clear();
+		m_viewports.clear();
+		m_viewportGroups.clear();
+		m_captureErrors.clear();
+
+		m_scene = 0;
+		m_lastShader = 0;
+
+	}
+
+	void RenderSnapshot::FreeReleasedBuffers()
+	{
+
+		for( unsigned int i = 0; i < m_releasedBuffers.size(); i++ )
+		{
+			SAFE_DELETE( m_releasedBuffers[i] );
+		}
+		m_releasedBuffers.clear();
+
+	}
+
+	const RenderSnapshot::Group* RenderSnapshot::FindGroup( Kiwi::StringId name )const
+	{
+
+		//scenes have few render groups, a linear search is faster than a map
+		for( unsigned int i = 0; i < m_groups.size(); i++ )
+		{
+			if( m_groups[i].name == name )
+			{
+				return &m_groups[i];
+			}
+		}
+
+		return 0;
+
+	}
+
+}
\ No newline at end of file
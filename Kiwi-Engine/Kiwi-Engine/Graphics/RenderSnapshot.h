@@ -0,0 +1,164 @@
+#ifndef _KIWI_RENDERSNAPSHOT_H_
+#define _KIWI_RENDERSNAPSHOT_H_
+
+#include "Mesh.h"
+#include "Material.h"
+
+#include "../Core/Matrix4.h"
+#include "../Core/Vector3d.h"
+#include "../Core/StringId.h"
+
+#include <vector>
+
+namespace Kiwi
+{
+
+	class Scene;
+	class Camera;
+	class Viewport;
+	class RenderTarget;
+	class RenderQueue;
+	class IShader;
+	class IBuffer;
+
+	/*compact copy of everything a frame needs to be drawn: the visible submeshes with their world matrix and material,
+	the cameras, and the viewports of the scene's render targets. a scene in render thread mode captures one
+	snapshot per frame, which the render thread draws while the simulation runs the next frame
+
+	items are stored render group by render group, and within a group as solids, then transparents, then 2D,
+	so a group's pass is the item range [begin[pass], end[pass]). the vectors are reused between captures
+	so a snapshot stops allocating once it has grown to the size of the scene
+
+	the shaders and the meshes' vertex and index buffers are referenced by pointer, everything else is copied, so drawing
+	a snapshot never reads the live scene. a mesh that replaces its buffers while they may still be drawn hands them to
+	the render thread (RenderThread::ReleaseBuffer), which keeps them in a snapshot and frees them once it has been drawn*/
+	class RenderSnapshot
+	{
+	public:
+
+		enum PASS { PASS_SOLID = 0, PASS_TRANSPARENT = 1, PASS_2D = 2, PASS_COUNT = 3 };
+
+		struct Item
+		{
+			Kiwi::IShader* shader; //shader of the material, resolved when the item is captured
+			Kiwi::IBuffer* vertexBuffer;
+			Kiwi::IBuffer* indexBuffer;
+			unsigned int submeshIndex;
+			unsigned long startIndex;
+			unsigned long endIndex;
+			long instanceCount; //0 if the mesh is not instanced
+			Kiwi::PrimitiveTopology topology;
+			Kiwi::Matrix4 world; //interpolated world matrix of the mesh's entity
+			Kiwi::Material material;
+			bool is2D; //true if the mesh's entity is a 2D entity
+		};
+
+		struct Group
+		{
+			Kiwi::StringId name;
+			unsigned int begin[PASS_COUNT];
+			unsigned int end[PASS_COUNT];
+		};
+
+		struct CameraState
+		{
+			Kiwi::Camera* camera;
+			Kiwi::Matrix4 view;
+			Kiwi::Matrix4 view2D;
+			Kiwi::Matrix4 projection;
+			Kiwi::Matrix4 ortho;
+			Kiwi::Vector3d position;
+		};
+
+		struct ViewportState
+		{
+			Kiwi::RenderTarget* renderTarget;
+			Kiwi::Viewport* viewport;
+			int cameraIndex; //-1 if the viewport has no camera
+			unsigned int groupBegin; //range of the viewport's render groups, see GetViewportGroup
+			unsigned int groupEnd;
+		};
+
+	protected:
+
+		Kiwi::Scene* m_scene;
+
+		unsigned long long m_frame;
+
+		double m_interpolationAlpha;
+
+		std::vector<Item> m_items;
+		std::vector<Group> m_groups;
+		std::vector<CameraState> m_cameras;
+		std::vector<ViewportState> m_viewports;
+		std::vector<Kiwi::StringId> m_viewportGroups;
+
+		//meshes that could not be captured, reported by the scene on the main thread
+		std::vector<std::wstring> m_captureErrors;
+
+		//buffers released while this snapshot was being captured or drawn, freed once it has been drawn
+		std::vector<Kiwi::IBuffer*> m_releasedBuffers;
+
+		//the last shader resolved, consecutive submeshes usually share their shader
+		Kiwi::StringId m_lastShaderName;
+		Kiwi::IShader* m_lastShader;
+
+	protected:
+
+		void _CaptureMesh( Kiwi::Mesh* mesh );
+
+		/*returns the shader named by the material, or 0 if the scene has no such shader*/
+		Kiwi::IShader* _FindShader( const Kiwi::Material& material );
+
+	public:
+
+		RenderSnapshot();
+
+		/*empties the snapshot and starts capturing frame 'frame' of 'scene'
+		transforms are captured blended by 'interpolationAlpha' (see GameTimer::GetInterpolationAlpha)*/
+		void Begin( Kiwi::Scene* scene, unsigned long long frame, double interpolationAlpha );
+
+		/*captures the camera's matrices, returns its index. cameras are only captured once per snapshot*/
+		int CaptureCamera( Kiwi::Camera* camera );
+
+		/*captures a viewport of a render target, along with its camera and the render groups it shows*/
+		void CaptureViewport( Kiwi::RenderTarget* renderTarget, Kiwi::Viewport* viewport, Kiwi::StringId defaultGroup );
+
+		/*captures every mesh of a generated render queue. transparent meshes are sorted by their distance to the
+		first captured camera and 2D meshes by depth, like RenderQueueGroup::Sort*/
+		void CaptureQueue( Kiwi::RenderQueue& renderQueue );
+
+		/*empties the snapshot, released buffers are kept until FreeReleasedBuffers is called*/
+		void Clear();
+
+		/*keeps the buffer until the snapshot has been drawn, see RenderThread::ReleaseBuffer*/
+		void ReleaseBuffer( Kiwi::IBuffer* buffer ) { m_releasedBuffers.push_back( buffer ); }
+
+		/*deletes the released buffers, called once nothing can draw them anymore*/
+		void FreeReleasedBuffers();
+
+		const Group* FindGroup( Kiwi::StringId name )const;
+
+		Kiwi::Scene* GetScene()const { return m_scene; }
+		unsigned long long GetFrame()const { return m_frame; }
+		double GetInterpolationAlpha()const { return m_interpolationAlpha; }
+
+		unsigned int GetItemCount()const { return (unsigned int)m_items.size(); }
+		const Item& GetItem( unsigned int index )const { return m_items[index]; }
+
+		unsigned int GetGroupCount()const { return (unsigned int)m_groups.size(); }
+		const Group& GetGroup( unsigned int index )const { return m_groups[index]; }
+
+		unsigned int GetCameraCount()const { return (unsigned int)m_cameras.size(); }
+		const CameraState& GetCamera( unsigned int index )const { return m_cameras[index]; }
+
+		unsigned int GetViewportCount()const { return (unsigned int)m_viewports.size(); }
+		const ViewportState& GetViewport( unsigned int index )const { return m_viewports[index]; }
+		Kiwi::StringId GetViewportGroup( unsigned int index )const { return m_viewportGroups[index]; }
+
+		const std::vector<std::wstring>& GetCaptureErrors()const { return m_captureErrors; }
+
+	};
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "RenderThread.h"
+#include "IRenderBackend.h"
+
+#include "IBuffer.h"
+
+#include "../Core/Exception.h"
+#include "../Core/Utilities.h"
+#include "../Core/Profiler.h"
+
+namespace Kiwi
+{
+
+	RenderThread::RenderThread( Kiwi::IRenderBackend* backend )
+	{
+
+		if( backend == 0 )
+		{
+			throw Kiwi::Exception( L"RenderThread", L"Invalid render backend" );
+		}
+
+		m_backend = backend;
+		m_captureIndex = 0;
+		m_pending = false;
+		m_stop = false;
+		m_framesSubmitted = 0;
+
+		m_thread = std::thread( &RenderThread::_Run, this );
+
+	}
+
+	RenderThread::~RenderThread()
+	{
+
+		this->Stop();
+
+	}
+
+	void RenderThread::_Run()
+	{
+
+		KIWI_PROFILE_THREAD( "Render" );
+
+		std::unique_lock<std::mutex> lock( m_mutex );
+
+		while( true )
+		{
+			m_submitted.wait( lock, [this]() { return m_pending || m_stop; } );
+
+			if( !m_pending )
+			{
+				//stopped with nothing left to draw
+				break;
+			}
+
+			//the capture index only changes in Submit, which waits for this snapshot first
+			Kiwi::RenderSnapshot& snapshot = m_snapshots[1 - m_captureIndex];
+
+			lock.unlock();
+
+			std::exception_ptr exception;
+			try
+			{
+				KIWI_PROFILE_ZONE( "RenderThread::Render" );
+				m_backend->Render( snapshot );
+
+			} catch( ... )
+			{
+				exception = std::current_exception();
+			}
+
+			//buffers released up to the snapshot's submission were drawn for the last time
+			snapshot.FreeReleasedBuffers();
+
+			lock.lock();
+
+			if( exception && !m_exception )
+			{
+				m_exception = exception;
+			}
+
+			m_pending = false;
+			m_finished.notify_all();
+		}
+
+	}
+
+	void RenderThread::_WaitForPending( std::unique_lock<std::mutex>& lock )
+	{
+
+		m_finished.wait( lock, [this]() { return !m_pending; } );
+
+		if( m_exception )
+		{
+			std::exception_ptr exception = m_exception;
+			m_exception = nullptr;
+			std::rethrow_exception( exception );
+		}
+
+	}
+
+	void RenderThread::Stop()
+	{
+
+		{
+			std::lock_guard<std::mutex> guard( m_mutex );
+			m_stop = true;
+		}
+		m_submitted.notify_all();
+
+		if( m_thread.joinable() )
+		{
+			m_thread.join();
+		}
+
+		//nothing is drawn anymore
+		m_snapshots[0].FreeReleasedBuffers();
+		m_snapshots[1].FreeReleasedBuffers();
+
+	}
+
+	void RenderThread::Submit()
+	{
+
+		std::unique_lock<std::mutex> lock( m_mutex );
+
+		if( m_stop ) return;
+
+		this->_WaitForPending( lock );
+
+		m_captureIndex = 1 - m_captureIndex;
+		m_pending = true;
+		m_framesSubmitted++;
+
+		lock.unlock();
+		m_submitted.notify_one();
+
+	}
+
+	void RenderThread::Wait()
+	{
+
+		std::unique_lock<std::mutex> lock( m_mutex );
+
+		this->_WaitForPending( lock );
+
+	}
+
+	void RenderThread::ReleaseBuffer( Kiwi::IBuffer* buffer )
+	{
+
+		if( buffer == 0 ) return;
+
+		std::lock_guard<std::mutex> guard( m_mutex );
+
+		if( m_stop )
+		{
+			//the thread has stopped, nothing can draw the buffer
+			SAFE_DELETE( buffer );
+			return;
+		}
+
+		m_snapshots[m_captureIndex].ReleaseBuffer( buffer );
+
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#ifndef _KIWI_RENDERTHREAD_H_
+#define _KIWI_RENDERTHREAD_H_
+
+#include "RenderSnapshot.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+namespace Kiwi
+{
+
+	class IRenderBackend;
+
+	/*draws render snapshots on a dedicated thread, one frame behind the simulation
+	the simulation captures frame N+1 into the capture snapshot while the thread draws frame N from the other one.
+	Submit hands the captured snapshot over, waiting first if the previous one is still being drawn*/
+	class RenderThread
+	{
+	protected:
+
+		Kiwi::IRenderBackend* m_backend;
+
+		//double buffer, m_snapshots[m_captureIndex] is written by the simulation and the other one is read by the thread
+		Kiwi::RenderSnapshot m_snapshots[2];
+		unsigned int m_captureIndex;
+
+		std::thread m_thread;
+
+		//guards m_pending, m_stop, m_exception, m_captureIndex and the capture snapshot's released buffers
+		std::mutex m_mutex;
+
+		//signalled when a snapshot is submitted or the thread is told to stop
+		std::condition_variable m_submitted;
+
+		//signalled when the thread has finished drawing a snapshot
+		std::condition_variable m_finished;
+
+		//true from Submit until the thread has drawn the submitted snapshot
+		bool m_pending;
+
+		bool m_stop;
+
+		//exception thrown by the backend, rethrown on the simulation thread by the next Submit or Wait
+		std::exception_ptr m_exception;
+
+		unsigned long long m_framesSubmitted;
+
+	protected:
+
+		void _Run();
+
+		/*waits for the pending snapshot, m_mutex must be held by 'lock'*/
+		void _WaitForPending( std::unique_lock<std::mutex>& lock );
+
+	public:
+
+		RenderThread( Kiwi::IRenderBackend* backend );
+		~RenderThread();
+
+		/*finishes the pending snapshot and joins the thread*/
+		void Stop();
+
+		/*the snapshot the simulation captures the next frame into*/
+		Kiwi::RenderSnapshot& GetCaptureSnapshot() { return m_snapshots[m_captureIndex]; }
+
+		/*hands the capture snapshot to the render thread and swaps buffers*/
+		void Submit();
+
+		/*blocks until the submitted snapshot has been drawn. call before destroying anything a snapshot refers to*/
+		void Wait();
+
+		/*takes ownership of a buffer that may still be drawn and deletes it once no snapshot can refer to it anymore.
+		the buffer is kept in the capture snapshot, which is drawn after the snapshot that is currently being drawn*/
+		void ReleaseBuffer( Kiwi::IBuffer* buffer );
+
+		Kiwi::IRenderBackend* GetBackend()const { return m_backend; }
+
+		unsigned long long GetFramesSubmitted()const { return m_framesSubmitted; }
+
+	};
+};
+
+#endif
\ No newline at end of file
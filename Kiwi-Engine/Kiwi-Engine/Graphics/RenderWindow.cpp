@@ -2,8 +2,8 @@
 #include "IWindowEventListener.h"
 #include "WindowEvent.h"
 
-#include "..\Core\Exception.h"
-#include "..\Core\RawInputWrapper.h"
+#include "../Core/Exception.h"
+#include "../Core/RawInputWrapper.h"
 
 namespace Kiwi
 {
@@ -2,7 +2,7 @@
 #define _KIWI_RENDERWINDOW_H_
 
 #include "../Core/Vector2.h"
-#include "..\Core\MouseEventBroadcaster.h"
+#include "../Core/MouseEventBroadcaster.h"
 #include "../Core/Events/KeyboardEventBroadcaster.h"
 
 #include "WindowEventBroadcaster.h"
@@ -60,8 +60,10 @@ namespace Kiwi
 
 		void Shutdown();
 
+#ifndef KIWI_HEADLESS
 		/*binds the renderable's mesh to the rendering pipeline*/
 		virtual void Bind( Kiwi::Renderer& renderer ) { if( m_mesh ) m_mesh->Bind( renderer ); }
+#endif
 
 		virtual void OnPreRender(Kiwi::Renderer* renderer, Kiwi::Scene* scene) {}
 		virtual void OnPostRender(Kiwi::Renderer* renderer, Kiwi::Scene* scene) {}
@@ -10,6 +10,7 @@
 #include "IBuffer.h"
 #include "RenderQueue.h"
 #include "RenderQueueGroup.h"
+#include "RenderSnapshot.h"
 
 #include "../Core/Exception.h"
 #include "../Core/Utilities.h"
@@ -17,6 +18,7 @@
 #include "../Core/Scene.h"
 #include "../Core/Console.h"
 #include "../Core/EngineRoot.h"
+#include "../Core/Profiler.h"
 
 namespace Kiwi
 {
@@ -108,6 +110,8 @@ namespace Kiwi
 	void Renderer::Render( Kiwi::RenderQueue* renderQueue )
 	{
 
+		KIWI_PROFILE_ZONE( "Renderer::Render" );
+
 		Kiwi::RenderTarget* renderTarget = this->GetActiveRenderTarget();
 
 		if( renderTarget == 0 || renderQueue == 0 )
@@ -127,6 +131,8 @@ namespace Kiwi
 			return;
 		}
 
+		static const Kiwi::StringId defaultShaderName = Kiwi::StringTable::Intern( L"default" );
+
 		this->EnableDepthBuffer( true );
 		this->SetRasterState( L"Cull CCW" );
 
@@ -134,10 +140,10 @@ namespace Kiwi
 		{
 			Kiwi::Viewport* vp = renderTarget->GetViewport( i );
 
-			std::vector<std::wstring> renderGroups;
+			std::vector<Kiwi::StringId> renderGroups;
 			if( vp->UsingDefaultRenderGroup() )
 			{
-				renderGroups.push_back( renderQueue->GetDefaultRenderGroupName() );
+				renderGroups.push_back( renderQueue->GetDefaultRenderGroupID() );
 
 			} else
 			{
@@ -198,14 +204,15 @@ namespace Kiwi
 							}
 
 							//bind the material's shader
-							std::wstring matShaderName = subset->material.GetShader();
-							if( matShaderName.compare( L"" ) == 0 )
+							Kiwi::StringId matShaderName = subset->material.GetShaderID();
+							if( matShaderName == Kiwi::StringTable::EMPTY )
 							{
-								matShaderName = L"default";
+								matShaderName = defaultShaderName;
 							}
-							if( currentShader == 0 || currentShader->GetName().compare( matShaderName ) != 0 )
+							if( currentShader == 0 || currentShader->GetNameID() != matShaderName )
 							{
-								currentShader = scene->FindAsset<Kiwi::IShader>( matShaderName );
+								//only look the shader up by name when the shader changes
+								currentShader = scene->FindAsset<Kiwi::IShader>( Kiwi::StringTable::GetString( matShaderName ) );
 								if( currentShader == 0 )
 								{
 									console->PrintDebug( L"Mesh " + currentMesh->GetName() + L" contains material with invalid shader" );
@@ -276,14 +283,15 @@ namespace Kiwi
 							}
 
 							//bind the material's shader
-							std::wstring matShaderName = subset->material.GetShader();
-							if( matShaderName.compare( L"" ) == 0 )
+							Kiwi::StringId matShaderName = subset->material.GetShaderID();
+							if( matShaderName == Kiwi::StringTable::EMPTY )
 							{
-								matShaderName = L"default";
+								matShaderName = defaultShaderName;
 							}
-							if( currentShader == 0 || currentShader->GetName().compare( matShaderName ) != 0 )
+							if( currentShader == 0 || currentShader->GetNameID() != matShaderName )
 							{
-								currentShader = scene->FindAsset<Kiwi::IShader>( matShaderName );
+								//only look the shader up by name when the shader changes
+								currentShader = scene->FindAsset<Kiwi::IShader>( Kiwi::StringTable::GetString( matShaderName ) );
 								if( currentShader == 0 )
 								{
 									console->PrintDebug( L"Mesh " + currentMesh->GetName() + L" contains material with invalid shader" );
@@ -362,14 +370,15 @@ namespace Kiwi
 							}
 
 							//bind the material's shader
-							std::wstring matShaderName = subset->material.GetShader();
-							if( matShaderName.compare( L"" ) == 0 )
+							Kiwi::StringId matShaderName = subset->material.GetShaderID();
+							if( matShaderName == Kiwi::StringTable::EMPTY )
 							{
-								matShaderName = L"default";
+								matShaderName = defaultShaderName;
 							}
-							if( currentShader == 0 || currentShader->GetName().compare( matShaderName ) != 0 )
+							if( currentShader == 0 || currentShader->GetNameID() != matShaderName )
 							{
-								currentShader = scene->FindAsset<Kiwi::IShader>( matShaderName );
+								//only look the shader up by name when the shader changes
+								currentShader = scene->FindAsset<Kiwi::IShader>( Kiwi::StringTable::GetString( matShaderName ) );
 								if( currentShader == 0 )
 								{
 									console->PrintDebug( L"Mesh " + currentMesh->GetName() + L" contains material with invalid shader" );
@@ -407,6 +416,126 @@ namespace Kiwi
 
 	}
 
+	void Renderer::Render( const Kiwi::RenderSnapshot& snapshot )
+	{
+
+		KIWI_PROFILE_ZONE( "Renderer::Render" );
+
+		if( snapshot.GetScene() == 0 )
+		{
+			return;
+		}
+
+		//viewports are captured render target by render target, clear each target before its first viewport
+		Kiwi::RenderTarget* currentTarget = 0;
+		for( unsigned int v = 0; v < snapshot.GetViewportCount(); v++ )
+		{
+			const Kiwi::RenderSnapshot::ViewportState& viewport = snapshot.GetViewport( v );
+			if( viewport.renderTarget == 0 )
+			{
+				continue;
+			}
+
+			if( viewport.renderTarget != currentTarget )
+			{
+				currentTarget = viewport.renderTarget;
+				this->SetRenderTarget( currentTarget );
+				this->ClearRenderTarget();
+			}
+
+			if( viewport.cameraIndex < 0 )
+			{
+				continue;
+			}
+
+			this->EnableDepthBuffer( true );
+			this->SetRasterState( L"Cull CCW" );
+
+			for( unsigned int g = viewport.groupBegin; g < viewport.groupEnd; g++ )
+			{
+				const Kiwi::RenderSnapshot::Group* group = snapshot.FindGroup( snapshot.GetViewportGroup( g ) );
+				if( group == 0 )
+				{
+					continue;
+				}
+
+				//solids, then transparents front and back faces, then 2D without depth
+				this->_RenderSnapshotItems( snapshot, viewport.cameraIndex, group->begin[Kiwi::RenderSnapshot::PASS_SOLID], group->end[Kiwi::RenderSnapshot::PASS_SOLID], false );
+				this->_RenderSnapshotItems( snapshot, viewport.cameraIndex, group->begin[Kiwi::RenderSnapshot::PASS_TRANSPARENT], group->end[Kiwi::RenderSnapshot::PASS_TRANSPARENT], true );
+
+				this->EnableDepthBuffer( false );
+				this->_RenderSnapshotItems( snapshot, viewport.cameraIndex, group->begin[Kiwi::RenderSnapshot::PASS_2D], group->end[Kiwi::RenderSnapshot::PASS_2D], false );
+				this->EnableDepthBuffer( true );
+			}
+		}
+
+		this->Present();
+
+	}
+
+	void Renderer::_RenderSnapshotItems( const Kiwi::RenderSnapshot& snapshot, unsigned int cameraIndex, unsigned int begin, unsigned int end, bool twoSided )
+	{
+
+		//everything needed to draw an item was resolved when it was captured, nothing here reads the live scene
+		const Kiwi::RenderSnapshot::CameraState& camera = snapshot.GetCamera( cameraIndex );
+
+		Kiwi::IShader* currentShader = 0;
+		Kiwi::IBuffer* currentVertexBuffer = 0;
+
+		for( unsigned int i = begin; i < end; i++ )
+		{
+			const Kiwi::RenderSnapshot::Item& item = snapshot.GetItem( i );
+
+			//the submeshes of a mesh are captured next to each other, only bind when the mesh changes
+			if( item.vertexBuffer != currentVertexBuffer )
+			{
+				currentVertexBuffer = item.vertexBuffer;
+				this->SetVertexBuffer( 0, item.vertexBuffer, sizeof( Kiwi::Mesh::Vertex ), 0 );
+				this->SetIndexBuffer( item.indexBuffer, DXGI_FORMAT_R32_UINT, 0 );
+			}
+
+			if( item.topology != m_activePrimitiveTopology )
+			{
+				this->SetPrimitiveTopology( item.topology );
+			}
+
+			//bind the material's shader
+			if( item.shader != currentShader )
+			{
+				currentShader = item.shader;
+				this->SetShader( currentShader );
+				currentShader->SetFrameParameters( snapshot, camera );
+			}
+
+			unsigned int subsetSize = (item.endIndex - item.startIndex) + 1;
+
+			currentShader->SetObjectParameters( snapshot, this->GetActiveRenderTarget(), item );
+
+			if( twoSided )
+			{
+				this->SetRasterState( L"Cull CW" );
+			}
+
+			for( unsigned int side = 0; side < (twoSided ? 2u : 1u); side++ )
+			{
+				if( side == 1 )
+				{
+					this->SetRasterState( L"Cull CCW" );
+				}
+
+				if( item.instanceCount > 0 )
+				{
+					this->DrawIndexedInstanced( subsetSize, item.instanceCount, item.startIndex, 0, 0 );
+
+				} else
+				{
+					this->DrawIndexed( subsetSize, item.startIndex, 0 );
+				}
+			}
+		}
+
+	}
+
 	HRESULT Renderer::MapResource( ID3D11Resource* resource, unsigned int subResource, D3D11_MAP mapType, unsigned int flags, D3D11_MAPPED_SUBRESOURCE* mappedResource )
 	{
 
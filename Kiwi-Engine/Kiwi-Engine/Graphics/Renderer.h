@@ -4,12 +4,14 @@
 #include "DirectX.h"
 #include "RasterStateManager.h"
 #include "Color.h"
+#include "IRenderBackend.h"
 
 #include "../Core/Vector2.h"
 #include "../Core/Vector4.h"
 #include "../Core/IThreadSafe.h"
 
 #include <string>
+#include <vector>
 
 namespace Kiwi
 {
@@ -25,6 +27,7 @@ namespace Kiwi
 	class IShader;
 	class IBuffer;
 	class RenderQueue;
+	class RenderSnapshot;
 
 	enum PrimitiveTopology
 	{
@@ -46,7 +49,8 @@ namespace Kiwi
 	};
 
 	class Renderer:
-		public Kiwi::IThreadSafe
+		public Kiwi::IThreadSafe,
+		public Kiwi::IRenderBackend
 	{
 	private:
 
@@ -69,6 +73,12 @@ namespace Kiwi
 
 		bool m_depthEnable;
 
+	private:
+
+		/*draws the snapshot items [begin, end) as seen by the snapshot camera 'cameraIndex'
+		if 'twoSided' is true each item is drawn twice, back faces then front faces*/
+		void _RenderSnapshotItems( const Kiwi::RenderSnapshot& snapshot, unsigned int cameraIndex, unsigned int begin, unsigned int end, bool twoSided );
+
 	public:
 
 		Renderer(std::wstring name, Kiwi::RenderWindow* window);
@@ -98,6 +108,10 @@ namespace Kiwi
 		/*For each viewport in the render target, renders all renderqueuegroups that are assigned to it from renderQueue*/
 		void Render( Kiwi::RenderQueue* renderQueue );
 
+		/*draws a render snapshot to the render targets it was captured from, then presents the back buffer
+		called on the render thread in render thread mode, only reads the snapshot and the mesh buffers*/
+		virtual void Render( const Kiwi::RenderSnapshot& snapshot );
+
 		HRESULT MapResource( ID3D11Resource* resource, unsigned int subResource, D3D11_MAP mapType, unsigned int flags, D3D11_MAPPED_SUBRESOURCE* mappedResource );
 		void UnmapResource( ID3D11Resource* resource, unsigned int subResource );
 
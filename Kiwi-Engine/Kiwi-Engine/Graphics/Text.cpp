@@ -3,8 +3,8 @@
 #include "Mesh.h"
 #include "Renderable.h"
 
-#include "..\Core\Scene.h"
-#include "..\Core\Utilities.h"
+#include "../Core/Scene.h"
+#include "../Core/Utilities.h"
 
 namespace Kiwi
 {
@@ -21,6 +21,9 @@ namespace Kiwi
 		m_maxDimensions = maxDimensions;
 		m_textMesh = 0;
 
+		//rebuilds its text mesh (a graphics resource) when the text changes
+		m_isMainThreadOnly = true;
+
 	}
 
 	Text::~Text()
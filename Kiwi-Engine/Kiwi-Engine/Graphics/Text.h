@@ -4,7 +4,7 @@
 #include "Font.h"
 #include "Color.h"
 
-#include "..\Core\Entity.h"
+#include "../Core/Entity.h"
 #include "../Core/Component.h"
 
 namespace Kiwi
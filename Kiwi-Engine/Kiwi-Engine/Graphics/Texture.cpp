@@ -1,6 +1,11 @@
 #include "Texture.h"
+
+#include "../Core/Platform.h"
+
+#ifndef KIWI_HEADLESS
 #include "DirectX.h"
 #include "Renderer.h"
+#endif
 
 #include "../Core/Utilities.h"
 #include "../Core/Logger.h"
@@ -31,10 +36,12 @@ namespace Kiwi
 
 		if( m_referenceCount > 0 )
 		{
-			_Logger.Log( L"Texture '" + m_textureName + L"' was destroyed with reference count " + Kiwi::ToWString( m_referenceCount ) );
+			KIWI_LOG( _Logger, L"Texture '{}' was destroyed with reference count {}", m_textureName, m_referenceCount );
 		}
 
+#ifndef KIWI_HEADLESS
 		SAFE_RELEASE( m_shaderResource );
+#endif
 
 	}
 
@@ -1,7 +1,7 @@
 #ifndef _KIWI_UIBUTTONEVENT_H_
 #define _KIWI_UIBUTTONEVENT_H_
 
-#include "..\..\..\Core\Event.h"
+#include "../../../Core/Event.h"
 #include "../../../Core/Vector2d.h"
 
 namespace Kiwi
@@ -1,7 +1,7 @@
 #ifndef _KIWI_UIBUTTONEVENTBROADCASTER_H_
 #define _KIWI_UIBUTTONEVENTBROADCASTER_H_
 
-#include "..\..\Core\EventBroadcaster.h"
+#include "../../Core/EventBroadcaster.h"
 
 #include "UIButtonEventListener.h"
 
@@ -1,7 +1,7 @@
 #ifndef _KIWI_UISCROLLBAREVENT_H_
 #define _KIWI_UISCROLLBAREVENT_H_
 
-#include "..\..\..\Core\Event.h"
+#include "../../../Core/Event.h"
 
 namespace Kiwi
 {
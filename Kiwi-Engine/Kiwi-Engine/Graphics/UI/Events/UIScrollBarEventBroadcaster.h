@@ -1,7 +1,7 @@
 #ifndef _KIWI_UISCROLLBAREVENTBROADCASTER_H_
 #define _KIWI_UISCROLLBAREVENTBROADCASTER_H_
 
-#include "..\..\..\Core\EventBroadcaster.h"
+#include "../../../Core/EventBroadcaster.h"
 
 #include "UIScrollBarEventListener.h"
 
@@ -1,11 +1,11 @@
 #include "UIButton.h"
 #include "UISprite.h"
 
-#include "..\Renderable2D.h"
+#include "../Renderable2D.h"
 #include "../RenderWindow.h"
-#include "..\Text.h"
+#include "../Text.h"
 
-#include "..\..\Core\Scene.h"
+#include "../../Core/Scene.h"
 #include "../../Core/RawInputWrapper.h"
 
 namespace Kiwi
@@ -20,6 +20,9 @@ namespace Kiwi
 		m_label = 0;
 		m_buttonSprite = 0;
 
+		//creates its sprite and label entities during the update
+		m_isMainThreadOnly = true;
+
 	}
 
 	UIButton::UIButton( std::wstring name, const Kiwi::Vector2d& dimensions, std::wstring label, std::wstring labelFont, std::wstring textureName ) :
@@ -33,6 +36,8 @@ namespace Kiwi
 		m_label = 0;
 		m_buttonSprite = 0;
 
+		m_isMainThreadOnly = true;
+
 	}
 
 	UIButton::~UIButton()
@@ -1,11 +1,11 @@
 #ifndef _KIWI_UIBUTTON_H_
 #define _KIWI_UIBUTTON_H_
 
-#include "Events\UIButtonEventBroadcaster.h"
+#include "Events/UIButtonEventBroadcaster.h"
 
-#include "..\..\Core\Component.h"
+#include "../../Core/Component.h"
 #include "../../Core/Vector2d.h"
-#include "..\..\Core\IMouseEventListener.h"
+#include "../../Core/IMouseEventListener.h"
 
 #include <string>
 
@@ -19,6 +19,9 @@ namespace Kiwi
 		m_bgSprite = 0;
 		m_slider = 0;
 
+		//creates its button and slider entities during the update
+		m_isMainThreadOnly = true;
+
 		m_buttonTexture = buttonTexture;
 		m_sliderTexture = sliderTexture;
 		m_backgroundTexture = backgroundTexture;
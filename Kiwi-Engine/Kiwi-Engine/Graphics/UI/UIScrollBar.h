@@ -4,9 +4,9 @@
 #include "Events/UIButtonEventListener.h"
 #include "Events/UIScrollBarEventBroadcaster.h"
 
-#include "..\Color.h"
+#include "../Color.h"
 
-#include "..\..\Core\Component.h"
+#include "../../Core/Component.h"
 #include "../../Core/Vector2d.h"
 
 #include <string>
@@ -15,6 +15,9 @@ namespace Kiwi
 		m_textureName = textureName;
 		m_spriteTexture = 0;
 
+		//loads its texture and creates its mesh on the first update
+		m_isMainThreadOnly = true;
+
 	}
 
 	UISprite::~UISprite()
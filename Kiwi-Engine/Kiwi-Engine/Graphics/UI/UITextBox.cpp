@@ -7,11 +7,15 @@
 #include "../../Core/Utilities.h"
 #include "../../Core/Scene.h"
 
+#include <unordered_map>
+
 namespace Kiwi
 {
 	
 	UITextBox::UITextBox( std::wstring name, TEXTBOX_TYPE textboxType, std::wstring textFont, const Kiwi::Vector2d& dimensions ) :
-		Kiwi::Component( name )
+		Kiwi::Component( name ),
+		m_text( 1000 ),
+		m_tempText( 1000 )
 	{
 
 		m_dimensions = dimensions;
@@ -27,6 +31,9 @@ namespace Kiwi
 		m_scrollBar = 0;
 		m_textField = 0;
 
+		//creates and destroys text entities as the text changes
+		m_isMainThreadOnly = true;
+
 	}
 
 	UITextBox::~UITextBox()
@@ -125,88 +132,42 @@ namespace Kiwi
 	void UITextBox::_UpdateVisibleText()
 	{
 
-		if( m_entity != 0 )
+		if( m_entity != 0 && m_textField != 0 )
 		{
+			size_t lineCount = m_text.GetSize();
+			size_t visibleLines = (m_visibleLineCount > 0) ? m_visibleLineCount : 1;
+
+			//show the newest lines unless the scroll bar is scrolled up
+			size_t firstLine = 0;
+			if( lineCount > visibleLines )
+			{
+				firstLine = lineCount - visibleLines;
+				if( m_scrollBar != 0 && m_scrollBar->GetCurrentLine() > 0 && m_scrollBar->GetCurrentLine() - 1 < firstLine )
+				{
+					firstLine = m_scrollBar->GetCurrentLine() - 1;
+				}
+			}
+
+			//only the visible window of the history is given to the text field, so the size of the text mesh
+			//and the time it takes to rebuild it don't depend on how many lines the text box holds
+			m_visibleText.clear();
+			for( size_t i = firstLine; i < lineCount && i < firstLine + visibleLines; i++ )
+			{
+				const TextLine& line = m_text[i];
+
+				if( m_visibleText.size() > 0 )
+				{
+					m_visibleText += L'\n';
+				}
+				m_visibleText += line.text;
+
+				if( line.lineCount > 1 )
+				{
+					m_visibleText += L" (" + Kiwi::ToWString( line.lineCount ) + L")";
+				}
+			}
 
-			//Kiwi::Scene* scene = m_entity->GetScene();
-			//Kiwi::Transform* transform = m_entity->FindComponent<Kiwi::Transform>();
-			//assert( transform != 0 && scene != 0 );
-
-			//m_suppressNew = true; //prevent any errors this operation may generate from being added to avoid an infinite loop
-
-			//int topLineY = (transform->GetPosition().y + (m_textAreaHeight / 2)) - (m_lineHeight / 2); //calculate the y coordinate of the top-most line
-			//int bottomLineY = (transform->GetPosition().y - (m_textAreaHeight / 2)) + (m_lineHeight / 2); //same for the bottom-most line
-
-			//m_visibleLineCount = m_textAreaHeight / m_lineHeight;
-
-			////update the visible text meshes if needed
-			//if( m_visibleText.size() != m_visibleLineCount )
-			//{
-			//	int lineCounter = m_visibleText.size();
-			//	while( m_visibleText.size() < m_visibleLineCount )
-			//	{
-			//		Kiwi::Text* newLine = new Kiwi::Text( m_objectName + L"/line" + Kiwi::ToWString( lineCounter ), *scene, m_textFont, 1 );
-			//		newLine->SetShader( L"Default2DShader" );
-			//		m_visibleText.push_back( newLine );
-			//		m_entity->AttachChild( newLine );
-			//		lineCounter++;
-			//	}
-
-			//	while( m_visibleText.size() > m_visibleLineCount && m_visibleText.size() > 0 )
-			//	{
-			//		m_visibleText[0]->Shutdown();
-			//		m_visibleText.erase( m_visibleText.begin() );
-			//	}
-			//}
-
-			//unsigned int i = 0;
-			//if( m_text.size() > m_visibleLineCount )
-			//{
-			//	i = m_scrollBar->GetCurrentLine() - 1;
-			//}
-			//for( unsigned int a = 0; i < m_text.size() && a < m_visibleLineCount; i++, a++ )
-			//{
-			//	//calculate the position of the line, taking into account the alignment of the text
-			//	Kiwi::Vector3d linePos = transform->GetPosition();
-			//	if( m_textAlignment == Kiwi::Font::ALIGN_LEFT )
-			//	{
-			//		linePos.x -= transform->GetScale().x / 2.0;
-			//		linePos.x += m_padding.x;
-
-			//	} else if( m_textAlignment == Kiwi::Font::ALIGN_RIGHT )
-			//	{
-			//		linePos.x += transform->GetScale().x / 2.0;
-			//		linePos.x -= m_padding.z;
-			//	}
-			//	linePos.x = (int)linePos.x;
-			//	linePos.y = (int)linePos.y;
-			//	linePos.z = transform->GetPosition().z + 1.0; //increase the z position so the text appears above the background
-
-			//	if( m_text[i].lineCount > 1 )
-			//	{
-			//		m_visibleText[a]->SetMaxCharacters( m_text[i].text.size() + 8 );
-			//		m_visibleText[a]->SetText( m_text[i].text + L" (" + Kiwi::ToWString( m_text[i].lineCount ) + L")", m_text[i].alignment );
-
-			//	} else
-			//	{
-			//		m_visibleText[a]->SetMaxCharacters( m_text[i].text.size() );
-			//		m_visibleText[a]->SetText( m_text[i].text, m_text[i].alignment );
-			//	}
-			//	m_visibleText[a]->SetColor( m_text[i].lineColor );
-
-			//	if( m_text.size() > m_visibleLineCount )
-			//	{
-			//		linePos.y = topLineY - (a * m_lineHeight);
-			//		m_visibleText[a]->FindComponent<Kiwi::Transform>()->SetPosition( linePos );
-
-			//	} else
-			//	{
-			//		linePos.y = topLineY - (a * m_lineHeight);
-			//		m_visibleText[a]->FindComponent<Kiwi::Transform>()->SetPosition( linePos );
-			//	}
-			//}
-
-			//m_suppressNew = false;
+			m_textField->SetText( m_visibleText );
 		}
 
 	}
@@ -218,32 +179,56 @@ namespace Kiwi
 		{
 			std::lock_guard<std::mutex> guard( m_textBoxMutex );
 
-			if( m_tempText.size() > 0 )
+			if( m_tempText.GetSize() > 0 )
 			{
-				//lines have been added
-				while( m_tempText.size() > 0 )
+				//lines have been added, first combine all duplicate lines into the first of them
+				std::vector<TextLine> newLines;
+				std::unordered_map<std::wstring, size_t> lineIndices;
+				for( size_t i = 0; i < m_tempText.GetSize(); i++ )
 				{
-					//first go through and combine all duplicate line into a single line
-					TextLine currentLine = m_tempText[0];
-					m_tempText.erase( m_tempText.begin() );
-					for( auto itr = m_tempText.begin(); itr != m_tempText.end(); )
+					TextLine& currentLine = m_tempText[i];
+					if( currentLine.text.size() == 0 )
+					{//empty lines are not added
+						continue;
+					}
+
+					auto itr = lineIndices.find( currentLine.text );
+					if( itr != lineIndices.end() )
+					{//this line matches an earlier line, increase that line's count
+						newLines[itr->second].lineCount += currentLine.lineCount;
+
+					} else
 					{
-						if( (*itr).text.compare( currentLine.text ) == 0 )
-						{//this line matches the current line, increase the line count
-							currentLine.lineCount++;
-							itr = m_tempText.erase( itr );
-
-						} else
-						{
-							itr++;
-						}
+						lineIndices[currentLine.text] = newLines.size();
+						newLines.push_back( std::move( currentLine ) );
 					}
+				}
+				m_tempText.Clear();
+
+				//keep the view on the newest line if it was there, otherwise keep it on the same text
+				bool followNewest = (m_scrollBar == 0) || (m_scrollBar->GetCurrentLine() >= m_scrollBar->GetLineCount());
+				unsigned int removedLines = 0;
 
-					if( currentLine.text.size() > 0 )
-					{//if the current line isnt empty, add it
-						currentLine.lineNumber = (m_text.size() == 0) ? 0 : m_text[m_text.size() - 1].lineNumber + 1;
-						m_text.push_back( currentLine );
-						m_scrollBar->SetLineCount( max( (int)m_text.size() - m_visibleLineCount, 1 ) );
+				for( unsigned int i = 0; i < newLines.size(); i++ )
+				{
+					newLines[i].lineNumber = m_text.IsEmpty() ? 0 : m_text.Back().lineNumber + 1;
+					if( m_text.Push( std::move( newLines[i] ) ) )
+					{
+						removedLines++;
+					}
+				}
+
+				if( m_scrollBar != 0 )
+				{
+					m_scrollBar->SetLineCount( (int)m_text.GetSize() - m_visibleLineCount + 1 );
+					if( followNewest )
+					{
+						m_scrollBar->ScrollToLine( m_scrollBar->GetLineCount() );
+
+					} else if( removedLines > 0 )
+					{
+						unsigned int currentLine = m_scrollBar->GetCurrentLine();
+						m_scrollBar->ScrollToLine( (currentLine > removedLines) ? currentLine - removedLines : 1 );
 					}
 				}
 
@@ -280,16 +265,16 @@ namespace Kiwi
 
 		if( textLine.compare(lastLine) == 0 )
 		{
-			if( m_tempText.size() > 0 && m_tempText[m_tempText.size() - 1].lineCount < 1000 )
+			if( m_tempText.GetSize() > 0 && m_tempText.Back().lineCount < 1000 )
 			{
 				//trying to add the same message twice in a row, just update the line count
-				m_tempText[m_tempText.size() - 1].lineCount++;
+				m_tempText.Back().lineCount++;
 				m_updateText = true;
 				return;
 
-			} else if( m_tempText.size() == 0 && m_text[m_text.size() - 1].lineCount < 1000 )
+			} else if( m_tempText.GetSize() == 0 && m_text.GetSize() > 0 && m_text.Back().lineCount < 1000 )
 			{
-				m_text[m_text.size() - 1].lineCount++;
+				m_text.Back().lineCount++;
 				m_updateText = true;
 				return;
 			}
@@ -299,10 +284,10 @@ namespace Kiwi
 		newLine.text = textLine;
 		newLine.lineColor = color;
 		newLine.lineCount = 1;
-		newLine.lineNumber = m_tempText.size() + 1;
+		newLine.lineNumber = (unsigned int)m_tempText.GetSize() + 1;
 		newLine.alignment = m_textAlignment;
 
-		m_tempText.push_back( newLine );
+		m_tempText.Push( std::move( newLine ) );
 
 		lastLine = textLine;
 		m_updateText = true;
@@ -326,6 +311,23 @@ namespace Kiwi
 
 	}
 
+	void UITextBox::SetHistorySize( unsigned int lines )
+	{
+
+		std::lock_guard<std::mutex> guard( m_textBoxMutex );
+
+		m_text.SetCapacity( lines );
+		m_tempText.SetCapacity( lines );
+
+		if( m_scrollBar != 0 )
+		{
+			m_scrollBar->SetLineCount( (int)m_text.GetSize() - m_visibleLineCount + 1 );
+		}
+
+		m_updateText = true;
+
+	}
+
 	void UITextBox::SetTexture( std::wstring textureName)
 	{
 		std::lock_guard<std::mutex> guard( m_textBoxMutex );
@@ -1,13 +1,14 @@
 #ifndef _KIWI_UITEXTBOX_H_
 #define _KIWI_UITEXTBOX_H_
 
-#include "Events\UIScrollBarEventListener.h"
+#include "Events/UIScrollBarEventListener.h"
 
-#include "..\Text.h"
+#include "../Text.h"
 
-#include "..\..\Core\Component.h"
+#include "../../Core/Component.h"
+#include "../../Core/RingBuffer.h"
 #include "../../Core/Vector2d.h"
-#include "..\..\Core\Vector4.h"
+#include "../../Core/Vector4.h"
 
 #include <string>
 #include <vector>
@@ -51,8 +52,13 @@ namespace Kiwi
 		Kiwi::Vector2d m_dimensions;
 
 		Kiwi::Text* m_textField;
-		std::vector<TextLine> m_text;
-		std::vector<TextLine> m_tempText; //holds all lines added since the last call to FixedUpdate
+
+		//the most recent lines, once the history is full each new line replaces the oldest one
+		Kiwi::RingBuffer<TextLine> m_text;
+		Kiwi::RingBuffer<TextLine> m_tempText; //holds the lines added since the last call to FixedUpdate
+
+		//the visible lines joined into the text field's text, only these lines are turned into glyphs
+		std::wstring m_visibleText;
 
 		Kiwi::UIScrollBar* m_scrollBar;
 
@@ -93,6 +99,11 @@ namespace Kiwi
 
 		void SetTexture( std::wstring textureName );
 
+		/*sets how many lines the text box keeps, the oldest lines are removed once there are more*/
+		void SetHistorySize( unsigned int lines );
+
+		unsigned int GetHistorySize()const { return (unsigned int)m_text.GetCapacity(); }
+
 		Kiwi::UIScrollBar* GetScrollBar()const { return m_scrollBar; }
 
 		virtual void OnScrollEvent( const Kiwi::UIScrollBarEvent& evt );
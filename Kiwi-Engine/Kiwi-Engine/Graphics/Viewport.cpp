@@ -18,12 +18,14 @@ namespace Kiwi
 		m_minDepth = minDepth;
 		m_maxDepth = maxDepth;
 
+#ifndef KIWI_HEADLESS
 		m_viewport.Width = m_dimensions.x;
 		m_viewport.Height = m_dimensions.y;
 		m_viewport.MaxDepth = m_maxDepth;
 		m_viewport.MinDepth = m_minDepth;
 		m_viewport.TopLeftX = m_position.x;
 		m_viewport.TopLeftY = m_position.y;
+#endif
 
 	}
 
@@ -39,12 +41,14 @@ namespace Kiwi
 		m_minDepth = minDepth;
 		m_maxDepth = maxDepth;
 
+#ifndef KIWI_HEADLESS
 		m_viewport.Width = m_dimensions.x;
 		m_viewport.Height = m_dimensions.y;
 		m_viewport.MaxDepth = m_maxDepth;
 		m_viewport.MinDepth = m_minDepth;
 		m_viewport.TopLeftX = m_position.x;
 		m_viewport.TopLeftY = m_position.y;
+#endif
 
 		if(m_camera) m_camera->SetViewport( this );
 
@@ -58,7 +62,7 @@ namespace Kiwi
 
 	}
 
-	void Viewport::AddRenderGroup( std::wstring renderGroup )
+	void Viewport::AddRenderGroup( Kiwi::StringId renderGroup )
 	{
 
 		m_renderGroups.push_back( renderGroup );
@@ -2,8 +2,12 @@
 #define _KIWI_VIEWPORT_H_
 
 #include "../Core/Vector2.h"
+#include "../Core/StringId.h"
+#include "../Core/Platform.h"
 
+#ifndef KIWI_HEADLESS
 #include "DirectX.h"
+#endif
 
 #include <string>
 #include <vector>
@@ -22,7 +26,7 @@ namespace Kiwi
 		Kiwi::Vector2 m_position;
 		Kiwi::Vector2 m_dimensions;
 
-		std::vector<std::wstring> m_renderGroups;
+		std::vector<Kiwi::StringId> m_renderGroups;
 
 		bool m_useDefaultRenderGroup;
 
@@ -31,7 +35,9 @@ namespace Kiwi
 
 		std::wstring m_name;
 
+#ifndef KIWI_HEADLESS
 		D3D11_VIEWPORT m_viewport;
+#endif
 
 	public:
 
@@ -41,7 +47,8 @@ namespace Kiwi
 
 		void AttachCamera(Kiwi::Camera* camera);
 
-		void AddRenderGroup( std::wstring renderGroup );
+		void AddRenderGroup( Kiwi::StringId renderGroup );
+		void AddRenderGroup( std::wstring renderGroup ) { this->AddRenderGroup( Kiwi::StringTable::Intern( renderGroup ) ); }
 
 		/*tells the viewport to use the default render groups*/
 		void UseDefaultRenderGroup( bool useDefaults ) { m_useDefaultRenderGroup = useDefaults; }
@@ -53,12 +60,14 @@ namespace Kiwi
 
 		bool UsingDefaultRenderGroup()const { return m_useDefaultRenderGroup; }
 
-		std::vector<std::wstring>& GetRenderGroupList() { return m_renderGroups; }
+		std::vector<Kiwi::StringId>& GetRenderGroupList() { return m_renderGroups; }
 
 		const Kiwi::Vector2& GetDimensions()const { return m_dimensions; }
 		const Kiwi::Vector2& GetPosition()const { return m_position; }
 
+#ifndef KIWI_HEADLESS
 		D3D11_VIEWPORT& GetD3DViewport() { return m_viewport; }
+#endif
 
 	};
 };
@@ -1,7 +1,7 @@
 #ifndef _KIWI_WINDOWEVENT_H_
 #define _KIWI_WINDOWEVENT_H_
 
-#include "..\Core\Event.h"
+#include "../Core/Event.h"
 
 #include <Windows.h>
 
@@ -1,7 +1,7 @@
 #ifndef _KIWI_WINDOWEVENTBROADCASTER_H_
 #define _KIWI_WINDOWEVENTBROADCASTER_H_
 
-#include "..\Core\EventBroadcaster.h"
+#include "../Core/EventBroadcaster.h"
 
 #include "IWindowEventListener.h"
 #include "WindowEvent.h"
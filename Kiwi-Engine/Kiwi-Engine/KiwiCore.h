@@ -1,25 +1,31 @@
 #ifndef _KIWI_KIWICORE_H_
 #define _KIWI_KIWICORE_H_
 
-#include "Core\EngineRoot.h"
-#include "Core\IEngineApp.h"
-#include "Core\Scene.h"
-#include "Core\SceneManager.h"
-#include "Core\IAsset.h"
-#include "Core\Logger.h"
-#include "Core\Entity.h"
-#include "Core\Transform.h"
-#include "Core\Console.h"
+#include "Core/EngineRoot.h"
+#include "Core/IEngineApp.h"
+#include "Core/Scene.h"
+#include "Core/SceneManager.h"
+#include "Core/IAsset.h"
+#include "Core/Logger.h"
+#include "Core/LogDecoder.h"
+#include "Core/Entity.h"
+#include "Core/Transform.h"
+#include "Core/Console.h"
 
-#include "Core\Exception.h"
-#include "Core\Utilities.h"
-#include "Core\Any.h"
-#include "Core\Math.h"
-#include "Core\ThreadManager.h"
+#include "Core/Platform.h"
+#include "Core/Exception.h"
+#include "Core/Utilities.h"
+#include "Core/Any.h"
+#include "Core/RingBuffer.h"
+#include "Core/Math.h"
+#include "Core/ThreadManager.h"
+#include "Core/JobSystem.h"
+#include "Core/Profiler.h"
 
-#include "Core\EventBroadcaster.h"
-#include "Core\Event.h"
+#include "Core/EventBroadcaster.h"
+#include "Core/EventQueue.h"
+#include "Core/Event.h"
 
-#include "Core\RawInputWrapper.h"
+#include "Core/RawInputWrapper.h"
 
 #endif
\ No newline at end of file
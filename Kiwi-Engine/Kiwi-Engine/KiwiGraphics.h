@@ -2,29 +2,33 @@
 #define _KIWI_KIWIGRAPHICS_H_
 
 //#include "Graphics\GraphicsCore.h"
-#include "Graphics\Renderer.h"
-#include "Graphics\RenderWindow.h"
-#include "Graphics\RenderTarget.h"
+#include "Graphics/Renderer.h"
+#include "Graphics/RenderWindow.h"
+#include "Graphics/RenderTarget.h"
 
-#include "Graphics\IShader.h"
-#include "Graphics\IShaderEffect.h"
+#include "Graphics/IShader.h"
+#include "Graphics/IShaderEffect.h"
 
 //#include "Graphics\Renderable.h"
-#include "Graphics\Camera.h"
-#include "Graphics\Color.h"
-#include "Graphics\Viewport.h"
-#include "Graphics\Material.h"
-#include "Graphics\Mesh.h"
-#include "Graphics\Texture.h"
-#include "Graphics\Font.h"
-#include "Graphics\Text.h"
+#include "Graphics/Camera.h"
+#include "Graphics/Color.h"
+#include "Graphics/Viewport.h"
+#include "Graphics/Material.h"
+#include "Graphics/Mesh.h"
+#include "Graphics/Texture.h"
+#include "Graphics/RenderSnapshot.h"
+#include "Graphics/RenderThread.h"
+#include "Graphics/IRenderBackend.h"
+#include "Graphics/NullRenderBackend.h"
+#include "Graphics/Font.h"
+#include "Graphics/Text.h"
 
-#include "Graphics\VertexBuffer.h"
-#include "Graphics\IndexBuffer.h"
+#include "Graphics/VertexBuffer.h"
+#include "Graphics/IndexBuffer.h"
 
-#include "Graphics\IWindowEventListener.h"
-#include "Graphics\WindowEvent.h"
-#include "Graphics\WindowEventBroadcaster.h"
+#include "Graphics/IWindowEventListener.h"
+#include "Graphics/WindowEvent.h"
+#include "Graphics/WindowEventBroadcaster.h"
 //#include "Graphics\FrameEvent.h"
 
 #endif
\ No newline at end of file
@@ -1,9 +1,9 @@
 #ifndef _KIWI_PHYSICS_H_
 #define _KIWI_PHYSICS_H_
 
-#include "Physics\Collider.h"
-#include "Physics\CollisionEvent.h"
-#include "Physics\Rigidbody.h"
-#include "Physics\SphereCollider.h"
+#include "Physics/Collider.h"
+#include "Physics/CollisionEvent.h"
+#include "Physics/Rigidbody.h"
+#include "Physics/SphereCollider.h"
 
 #endif
\ No newline at end of file
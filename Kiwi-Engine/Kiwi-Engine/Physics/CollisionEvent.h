@@ -1,9 +1,8 @@
 #ifndef _KIWI_COLLISIONEVENT_H_
 #define _KIWI_COLLISIONEVENT_H_
 
-#include "..\Core\Event.h"
+#include "../Core/Event.h"
 
-#include <Windows.h>
 
 namespace Kiwi
 {
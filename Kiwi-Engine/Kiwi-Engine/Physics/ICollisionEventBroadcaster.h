@@ -1,7 +1,7 @@
 #ifndef _KIWI_ICOLLISIONEVENTBROADCASTER_H_
 #define _KIWI_ICOLLISIONEVENTBROADCASTER_H_
 
-#include "..\Core\EventBroadcaster.h"
+#include "../Core/EventBroadcaster.h"
 
 #include "ICollisionEventListener.h"
 
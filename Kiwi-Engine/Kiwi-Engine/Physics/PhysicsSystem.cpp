@@ -5,6 +5,7 @@
 #include "../Core/Utilities.h"
 #include "../Core/Transform.h"
 #include "../Core/EngineRoot.h"
+#include "../Core/Profiler.h"
 
 #include <vector>
 
@@ -97,6 +98,9 @@ namespace Kiwi
 			rigItr++;
 		}
 
+		//the whole fixed update is profiled as a frame task, only the collision pass gets its own zone
+		KIWI_PROFILE_ZONE( "PhysicsSystem::CheckCollisions" );
+
 		for( unsigned int i = 0; i < colliders.size(); i++ )
 		{
 			for( unsigned int a = 0; a < colliders.size(); a++ )
@@ -5,6 +5,7 @@
 
 #include "../Core/Component.h"
 #include "../Core/Vector3d.h"
+#include "../Core/MemoryPool.h"
 
 namespace Kiwi
 {
@@ -47,6 +48,8 @@ namespace Kiwi
 
 	public:
 
+		KIWI_DECLARE_POOLED( Rigidbody )
+
 		Rigidbody();
 		~Rigidbody();
 
@@ -5,6 +5,8 @@
 #include "../Core/Transform.h"
 #include "../Core/Utilities.h"
 
+#include <algorithm>
+
 namespace Kiwi
 {
 
@@ -38,7 +40,7 @@ namespace Kiwi
 
 						if( sph1Trans )
 						{
-							if( sph1Trans->GetDistance( parentTransform ) <= max(radius1, m_radius) )
+							if( sph1Trans->GetDistance( parentTransform ) <= std::max( radius1, m_radius ) )
 							{
 								if( m_activeCollisions.find( &collider ) != m_activeCollisions.end() )
 								{
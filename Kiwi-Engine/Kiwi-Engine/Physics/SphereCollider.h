@@ -2,6 +2,7 @@
 #define _KIWI_SPHERECOLLIDER_H_
 
 #include "Collider.h"
+#include "../Core/MemoryPool.h"
 
 namespace Kiwi
 {
@@ -15,6 +16,8 @@ namespace Kiwi
 
 	public:
 
+		KIWI_DECLARE_POOLED( SphereCollider )
+
 		SphereCollider( double radius );
 		~SphereCollider() {}
 
@@ -1,5 +1,7 @@
 #include "File.h"
 
+#include "../Core/Utilities.h"
+
 namespace Kiwi
 {
 
@@ -33,7 +35,7 @@ namespace Kiwi
 				}
 			case READ_ONLY:
 				{
-					m_fsReadOnly.open( m_filename );
+					m_fsReadOnly.open( Kiwi::ToNativePath( m_filename ).c_str() );
 					if( m_fsReadOnly.fail() )
 					{
 						m_isOpen = false;
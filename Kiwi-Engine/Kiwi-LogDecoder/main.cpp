@@ -0,0 +1,49 @@
+#include "Core/LogDecoder.h"
+#include "Core/Exception.h"
+#include "Core/Utilities.h"
+
+#include <string>
+#include <cstdio>
+#include <iostream>
+#include <fstream>
+
+/*Kiwi-LogDecoder binaryLog [textLog]
+writes the text to standard output if no text log is given*/
+int main( int argc, char** argv )
+{
+
+	if( argc < 2 || argc > 3 )
+	{
+		std::printf( "usage: %s binaryLog [textLog]\n", argv[0] );
+		return 1;
+	}
+
+	try
+	{
+		unsigned int messageCount = 0;
+		if( argc == 3 )
+		{
+			messageCount = Kiwi::LogDecoder::DecodeFile( Kiwi::s2ws( argv[1] ), Kiwi::s2ws( argv[2] ) );
+			std::printf( "decoded %u messages\n", messageCount );
+
+		} else
+		{
+			std::ifstream input( argv[1], std::ios_base::in | std::ios_base::binary );
+			if( !input.good() )
+			{
+				std::printf( "failed to open %s\n", argv[1] );
+				return 1;
+			}
+
+			Kiwi::LogDecoder::Decode( input, std::cout );
+		}
+
+	} catch( Kiwi::Exception& e )
+	{
+		std::printf( "%s: %s\n", Kiwi::ws2s( e.GetSource() ).c_str(), Kiwi::ws2s( e.GetError() ).c_str() );
+		return 1;
+	}
+
+	return 0;
+
+}
\ No newline at end of file